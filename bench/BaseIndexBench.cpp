@@ -0,0 +1,130 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            Base Index Benchmark                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "base_index";
+		constexpr FormID kGemBase = 0xFE000800;
+		constexpr std::uint32_t kBaseForms = 700;
+		constexpr std::size_t kEntries = 10'000;
+
+		// Brute-force answer the index must agree with: every uniqueId under the base, ascending.
+		std::vector<std::uint16_t> ScanInstances(const GemStore& store, FormID baseId)
+		{
+			std::vector<std::uint16_t> ids;
+			for (const auto& [key, _] : store.GetEntries()) {
+				if (key.baseId == baseId) {
+					ids.push_back(key.uniqueId);
+				}
+			}
+			std::sort(ids.begin(), ids.end());
+			return ids;
+		}
+
+		bool MatchesScan(const GemStore& store, FormID baseId)
+		{
+			const auto expected = ScanInstances(store, baseId);
+			const auto actual = store.GetInstances(baseId);
+			return std::equal(expected.begin(), expected.end(), actual.begin(), actual.end());
+		}
+
+		// 10k gems over 700 base forms (several instances each, plus bases that miss), queried through the
+		// index and through the old linear scan, then churned and round-tripped to check the index stays exact.
+		void Run(const Options& options)
+		{
+			auto& checks = Checks::Get();
+			SimWorld world;
+			std::uint32_t rng = options.seed;
+			while (world.store.Size() < kEntries) {
+				const GemKey key{ kGemBase + NextRandom(rng) % kBaseForms, world.store.AllocateUniqueId() };
+				StoredSpellData data{};
+				data.spellId = 0x00012FCD;
+				data.usesRemaining = 3;
+				world.store.Store(key, data);
+			}
+
+			bool exact = true;
+			for (std::uint32_t i = 0; i < kBaseForms + 16; ++i) {
+				exact &= MatchesScan(world.store, kGemBase + i);
+			}
+			checks.Expect(exact, kSuite, "instances disagree with a full scan after inserts");
+
+			LatencyRecorder first("first (index)", options.cycles);
+			LatencyRecorder all("all instances (index)", options.cycles);
+			const auto scans = std::max<std::uint64_t>(16, options.cycles / 1000);
+			LatencyRecorder scan("first (linear scan)", scans);
+			GemKey key{};
+			StoredSpellData data{};
+			std::size_t instances = 0;
+			for (std::uint64_t i = 0; i < options.cycles; ++i) {
+				const auto baseId = kGemBase + NextRandom(rng) % (kBaseForms + 16);
+				const bool found = first.Measure([&]() { return world.store.TryGetByBaseId(baseId, key, data); });
+				const auto ids = all.Measure([&]() { return world.store.GetInstances(baseId); });
+				instances += ids.size();
+				checks.Expect(found == !ids.empty() && (!found || (key.baseId == baseId && key.uniqueId == ids.front())),
+					kSuite, "first instance is not the lowest uniqueId");
+			}
+			for (std::uint64_t i = 0; i < scans; ++i) {
+				const auto baseId = kGemBase + NextRandom(rng) % (kBaseForms + 16);
+				scan.Measure([&]() {
+					for (const auto& [storedKey, storedData] : world.store.GetEntries()) {
+						if (storedKey.baseId == baseId) {
+							key = storedKey;
+							data = storedData;
+							return true;
+						}
+					}
+					return false;
+				});
+			}
+			first.Report();
+			all.Report();
+			scan.Report();
+			checks.Expect(instances > 0, kSuite, "no instances were found");
+
+			for (std::size_t i = 0; i < kEntries / 2; ++i) {
+				const auto slot = NextRandom(rng) % world.store.GetSlotIndex().Size();
+				world.store.Remove(*world.store.GetSlotIndex().At(slot));
+			}
+			exact = true;
+			for (std::uint32_t i = 0; i < kBaseForms; ++i) {
+				exact &= MatchesScan(world.store, kGemBase + i);
+			}
+			checks.Expect(exact, kSuite, "instances disagree with a full scan after removals");
+
+			MemoryCoSave cosave;
+			world.store.Save(cosave);
+			GemStore loaded;
+			std::uint32_t type = 0;
+			std::uint32_t version = 0;
+			std::uint32_t length = 0;
+			while (cosave.GetNextRecordInfo(type, version, length)) {
+				loaded.LoadRecord(cosave, type, version, length);
+			}
+			exact = loaded.GetBaseIndex().GetBaseCount() == world.store.GetBaseIndex().GetBaseCount();
+			for (std::uint32_t i = 0; i < kBaseForms; ++i) {
+				exact &= MatchesScan(loaded, kGemBase + i);
+			}
+			checks.Expect(exact, kSuite, "instances disagree with a full scan after load");
+
+			world.store.Clear();
+			checks.Expect(world.store.GetBaseIndex().GetBaseCount() == 0 && world.store.GetInstances(kGemBase).empty(), kSuite,
+				"clear left instances behind");
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,92 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Benchmark Harness                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace SpellGems::Bench
+{
+	LatencyRecorder::LatencyRecorder(std::string name, std::size_t expected) :
+		name_(std::move(name))
+	{
+		samples_.reserve(expected);
+	}
+
+	void LatencyRecorder::Add(Clock::duration elapsed)
+	{
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+		const auto clamped = std::clamp<std::int64_t>(ns, 0, std::numeric_limits<std::uint32_t>::max());
+		samples_.push_back(static_cast<std::uint32_t>(clamped));
+		totalNs_ += static_cast<std::uint64_t>(clamped);
+	}
+
+	// Prints one line: operation count, throughput and latency percentiles. Sorts the samples in place.
+	void LatencyRecorder::Report()
+	{
+		if (samples_.empty()) {
+			std::printf("  %-28s %12s\n", name_.c_str(), "no samples");
+			return;
+		}
+
+		std::sort(samples_.begin(), samples_.end());
+		const auto percentile = [this](double p) {
+			const auto index = static_cast<std::size_t>(p * static_cast<double>(samples_.size() - 1));
+			return samples_[index];
+		};
+		const double seconds = static_cast<double>(totalNs_) / 1e9;
+		const double throughput = seconds > 0.0 ? static_cast<double>(samples_.size()) / seconds : 0.0;
+		std::printf("  %-28s %10zu ops %14.0f ops/s   p50 %7u ns   p99 %8u ns   max %9u ns\n",
+			name_.c_str(), samples_.size(), throughput, percentile(0.50), percentile(0.99), samples_.back());
+	}
+
+	std::size_t LatencyRecorder::Count() const
+	{
+		return samples_.size();
+	}
+
+	Checks& Checks::Get()
+	{
+		static Checks instance;
+		return instance;
+	}
+
+	void Checks::Expect(bool condition, const char* suite, const char* what)
+	{
+		if (condition) {
+			return;
+		}
+
+		// Only the first few are printed; a broken invariant inside a hot loop would otherwise flood the log.
+		if (++failures_ <= kMaxPrinted) {
+			std::printf("  CHECK FAILED [%s] %s\n", suite, what);
+		}
+	}
+
+	int Checks::GetFailures() const
+	{
+		return failures_;
+	}
+
+	std::vector<Suite>& Registry::Suites()
+	{
+		static std::vector<Suite> suites;
+		return suites;
+	}
+
+	// xorshift32; deterministic across platforms so runs are comparable.
+	std::uint32_t NextRandom(std::uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+}
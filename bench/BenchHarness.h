@@ -0,0 +1,89 @@
+// Timing, percentile reporting and self-checks shared by the headless benchmark suites.
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	struct Options
+	{
+		std::uint64_t cycles{ 1'000'000 };
+		std::uint32_t seed{ 0x5EED5EED };
+		std::string filter;
+	};
+
+	// Per-operation latency samples in nanoseconds; reports throughput and p50/p99/max.
+	class LatencyRecorder
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		explicit LatencyRecorder(std::string name, std::size_t expected = 0);
+
+		template <class Fn>
+		decltype(auto) Measure(Fn&& fn)
+		{
+			const auto start = Clock::now();
+			if constexpr (std::is_void_v<decltype(fn())>) {
+				fn();
+				Add(Clock::now() - start);
+			} else {
+				decltype(auto) result = fn();
+				Add(Clock::now() - start);
+				return result;
+			}
+		}
+
+		void Add(Clock::duration elapsed);
+		void Report();
+
+		std::size_t Count() const;
+
+	private:
+		std::string name_;
+		std::vector<std::uint32_t> samples_;
+		std::uint64_t totalNs_{};
+	};
+
+	// Collects failed invariants so a run exits non-zero without aborting the remaining suites.
+	class Checks
+	{
+	public:
+		static Checks& Get();
+
+		void Expect(bool condition, const char* suite, const char* what);
+		int GetFailures() const;
+
+	private:
+		static constexpr int kMaxPrinted = 20;
+
+		int failures_{};
+	};
+
+	struct Suite
+	{
+		const char* name;
+		void (*run)(const Options& options);
+	};
+
+	// Each suite translation unit registers itself with a static Registrar.
+	class Registry
+	{
+	public:
+		static std::vector<Suite>& Suites();
+
+		struct Registrar
+		{
+			Registrar(const char* name, void (*run)(const Options& options))
+			{
+				Suites().push_back({ name, run });
+			}
+		};
+	};
+
+	std::uint32_t NextRandom(std::uint32_t& state);
+}
@@ -0,0 +1,243 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                          Co-Save Record Benchmark                                           //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include "SpellGems/Core/SpellRecordCodec.h"
+#include "SpellGems/Core/SpellRecordSchema.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "cosave_record";
+		constexpr FormID kGemBase = 0xFE000800;
+		constexpr FormID kSpellBase = 0x00012FCD;
+
+		// The pre-v4 writer, field by field, kept here as an independent oracle for the schema-generated layouts and
+		// as the timing baseline.
+		void SaveLegacy(const GemStore& store, MemoryCoSave& cosave, std::uint32_t version)
+		{
+			cosave.OpenRecord(GemStore::kRecordSpells, version);
+			const std::uint32_t count = static_cast<std::uint32_t>(store.Size());
+			cosave.Write(count);
+			for (const auto& [key, data] : store.GetEntries()) {
+				cosave.Write(key.baseId);
+				cosave.Write(key.uniqueId);
+				cosave.Write(data.spellId);
+				cosave.Write(data.tier);
+				cosave.Write(data.usesRemaining);
+				cosave.Write(data.lastUsedGameTime);
+				if (version >= 2) {
+					cosave.Write(data.isReusableStar);
+				}
+				if (version >= 3) {
+					cosave.Write(data.isBlackSoulGem);
+				}
+			}
+		}
+
+		void LoadInto(GemStore& store, MemoryCoSave& cosave)
+		{
+			store.ClearEntries();
+			cosave.Rewind();
+			std::uint32_t type = 0;
+			std::uint32_t version = 0;
+			std::uint32_t length = 0;
+			while (cosave.GetNextRecordInfo(type, version, length)) {
+				store.LoadRecord(cosave, type, version, length);
+			}
+		}
+
+		// Compares every entry; flags the loaded side did not have on disk are expected to come back false.
+		bool SameEntries(const GemStore& expected, const GemStore& actual, std::uint32_t version)
+		{
+			if (expected.Size() != actual.Size()) {
+				return false;
+			}
+			for (const auto& [key, data] : expected.GetEntries()) {
+				const auto loaded = actual.Get(key);
+				if (!loaded || loaded->spellId != data.spellId || loaded->tier != data.tier ||
+					loaded->usesRemaining != data.usesRemaining || loaded->lastUsedGameTime != data.lastUsedGameTime ||
+					loaded->isReusableStar != (version >= 2 && data.isReusableStar) ||
+					loaded->isBlackSoulGem != (version >= 3 && data.isBlackSoulGem)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void Fill(GemStore& store, std::size_t count, std::uint32_t& rng)
+		{
+			store.Clear();
+			for (std::size_t i = 0; i < count; ++i) {
+				const GemKey key{ kGemBase + NextRandom(rng) % 4096, static_cast<std::uint16_t>(i + 1) };
+				StoredSpellData data{};
+				data.spellId = kSpellBase + NextRandom(rng) % 1024;
+				data.tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+				data.usesRemaining = static_cast<std::int32_t>(NextRandom(rng) % 12) - 1;
+				data.lastUsedGameTime = static_cast<float>(NextRandom(rng) % 100000) / 64.0f;
+				data.isReusableStar = (rng & 1) != 0;
+				data.isBlackSoulGem = (rng & 2) != 0;
+				store.Store(key, data);
+			}
+		}
+
+		std::vector<std::uint8_t> ReadBody(MemoryCoSave& cosave)
+		{
+			cosave.Rewind();
+			std::uint32_t type = 0;
+			std::uint32_t version = 0;
+			std::uint32_t length = 0;
+			std::vector<std::uint8_t> body;
+			if (cosave.GetNextRecordInfo(type, version, length)) {
+				body.resize(length);
+				body.resize(cosave.ReadRaw(body.data(), length));
+			}
+			return body;
+		}
+
+		void CheckCompatibility(std::uint32_t seed)
+		{
+			auto& checks = Checks::Get();
+			std::uint32_t rng = seed;
+			GemStore original;
+			Fill(original, 512, rng);
+
+			GemStore loaded;
+			MemoryCoSave cosave;
+			std::vector<std::uint8_t> schemaBody;
+			for (std::uint32_t version = 1; version <= 3; ++version) {
+				cosave.Clear();
+				SaveLegacy(original, cosave, version);
+				SpellRecordSchema::Encode(original.GetEntries(), version, schemaBody);
+				checks.Expect(ReadBody(cosave) == schemaBody, kSuite, "schema layout differs from the field-by-field writer");
+				LoadInto(loaded, cosave);
+				checks.Expect(SameEntries(original, loaded, version), kSuite, "legacy record did not load");
+			}
+
+			// Every fixed-width version round-trips through the generated writer and reader on its own.
+			std::vector<SpellRecordCodec::Entry> decoded;
+			for (std::uint32_t version = SpellRecordSchema::kFirstVersion; version <= SpellRecordSchema::kPackedVersion; ++version) {
+				SpellRecordSchema::Encode(original.GetEntries(), version, schemaBody);
+				const bool sized = schemaBody.size() ==
+				                   SpellRecordSchema::kCountSize + original.Size() * SpellRecordSchema::GetEntrySize(version);
+				bool same = SpellRecordSchema::Decode(schemaBody, version, decoded) == original.Size();
+				for (const auto& [key, data] : decoded) {
+					const auto stored = original.Get(key);
+					same &= stored && stored->spellId == data.spellId && stored->tier == data.tier &&
+					        stored->usesRemaining == data.usesRemaining && stored->lastUsedGameTime == data.lastUsedGameTime &&
+					        data.isReusableStar == (version >= 2 && stored->isReusableStar) &&
+					        data.isBlackSoulGem == (version >= 3 && stored->isBlackSoulGem);
+				}
+				checks.Expect(sized && same, kSuite, "schema body did not round-trip");
+			}
+			checks.Expect(SpellRecordSchema::Decode(schemaBody, SpellRecordSchema::kPackedVersion + 1, decoded) == 0, kSuite,
+				"schema decoded a version without a fixed layout");
+
+			// v4: the headerless packed body.
+			std::vector<std::uint8_t> body;
+			SpellRecordCodec::EncodePacked(original.GetEntries(), body);
+			cosave.Clear();
+			cosave.OpenRecord(GemStore::kRecordSpells, 4);
+			cosave.WriteRaw(body.data(), static_cast<std::uint32_t>(body.size()));
+			LoadInto(loaded, cosave);
+			checks.Expect(SameEntries(original, loaded, 4), kSuite, "v4 record did not load");
+
+			for (const auto encoding : { SpellRecordCodec::Encoding::Packed, SpellRecordCodec::Encoding::Compressed }) {
+				original.SetRecordEncoding(encoding);
+				cosave.Clear();
+				original.Save(cosave);
+				LoadInto(loaded, cosave);
+				checks.Expect(SameEntries(original, loaded, GemStore::kRecordVersion), kSuite, "current record did not round-trip");
+				checks.Expect(loaded.AllocateUniqueId() == original.AllocateUniqueId(), kSuite, "state record did not round-trip");
+			}
+			original.SetRecordEncoding(SpellRecordCodec::Encoding::Packed);
+
+			// A body cut mid-entry keeps every whole entry before the cut.
+			cosave.Clear();
+			cosave.OpenRecord(GemStore::kRecordSpells, 4);
+			cosave.WriteRaw(body.data(), static_cast<std::uint32_t>(body.size() - 7));
+			LoadInto(loaded, cosave);
+			checks.Expect(loaded.Size() == original.Size() - 1, kSuite, "truncated packed record lost whole entries");
+
+			// The v4 layout is fixed little-endian, independent of host layout and padding.
+			GemTable table;
+			StoredSpellData data{};
+			data.spellId = 0x11223344;
+			data.tier = SpellTier::Expert;
+			data.usesRemaining = -1;
+			data.lastUsedGameTime = 1.0f;
+			data.isBlackSoulGem = true;
+			table.InsertOrAssign({ 0xAABBCCDD, 0xEEFF }, data);
+			SpellRecordCodec::EncodePacked(table, body);
+			const std::uint8_t expected[] = { 1, 0, 0, 0, 0xDD, 0xCC, 0xBB, 0xAA, 0xFF, 0xEE, 0x44, 0x33, 0x22, 0x11, 3,
+				0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x80, 0x3F, 2 };
+			checks.Expect(std::equal(body.begin(), body.end(), std::begin(expected), std::end(expected)), kSuite,
+				"packed layout changed");
+		}
+
+		// Save and load of 1k/10k/100k entries through the field-by-field v3 record and the bulk packed record.
+		void Run(const Options& options)
+		{
+			CheckCompatibility(options.seed);
+
+			auto& checks = Checks::Get();
+			for (const std::size_t count : { 1'000u, 10'000u, 100'000u }) {
+				std::uint32_t rng = options.seed ^ static_cast<std::uint32_t>(count);
+				GemStore original;
+				Fill(original, count, rng);
+				const auto repeats = std::clamp<std::uint64_t>(options.cycles / count, 3, 200);
+				const auto suffix = " (" + std::to_string(count) + ")";
+
+				MemoryCoSave legacy;
+				LatencyRecorder legacySave("v3 save" + suffix, repeats);
+				for (std::uint64_t i = 0; i < repeats; ++i) {
+					legacy.Clear();
+					legacySave.Measure([&]() { SaveLegacy(original, legacy, 3); });
+				}
+				const auto legacySaveCalls = legacy.GetDataCalls();
+
+				MemoryCoSave packed;
+				LatencyRecorder packedSave("bulk save" + suffix, repeats);
+				for (std::uint64_t i = 0; i < repeats; ++i) {
+					packed.Clear();
+					packedSave.Measure([&]() { original.Save(packed); });
+				}
+				const auto packedSaveCalls = packed.GetDataCalls();
+
+				GemStore loaded;
+				LatencyRecorder legacyLoad("v3 load" + suffix, repeats);
+				LatencyRecorder packedLoad("bulk load" + suffix, repeats);
+				bool same = true;
+				for (std::uint64_t i = 0; i < repeats; ++i) {
+					legacyLoad.Measure([&]() { LoadInto(loaded, legacy); });
+					same &= SameEntries(original, loaded, 3);
+					packedLoad.Measure([&]() { LoadInto(loaded, packed); });
+					same &= SameEntries(original, loaded, GemStore::kRecordVersion);
+				}
+				checks.Expect(same, kSuite, "loaded table differs from the saved one");
+
+				legacySave.Report();
+				packedSave.Report();
+				legacyLoad.Report();
+				packedLoad.Report();
+				std::printf("  v3 %zu bytes, %llu data calls per save; bulk %zu bytes, %llu data calls per save\n",
+					legacy.GetSize(), static_cast<unsigned long long>(legacySaveCalls), packed.GetSize(),
+					static_cast<unsigned long long>(packedSaveCalls));
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
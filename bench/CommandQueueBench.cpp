@@ -0,0 +1,106 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                          Command Queue Stress Test                                          //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/GemCommandQueue.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "command_queue";
+		constexpr std::size_t kProducers = 8;
+
+		// Many producer threads hammer one ring while a single consumer drains it, as the input thread, the UI
+		// thread and the main thread do in game. Every command must arrive exactly once.
+		void Run(const Options& options)
+		{
+			auto queue = std::make_unique<GemCommandQueue>();
+			const auto perProducer = options.cycles / kProducers;
+			std::atomic<std::size_t> finished{ 0 };
+			std::array<std::uint64_t, kProducers> fullRetries{};
+			LatencyRecorder push("push (producer 0)", perProducer);
+
+			std::vector<std::thread> producers;
+			for (std::size_t producer = 0; producer < kProducers; ++producer) {
+				producers.emplace_back([&, producer]() {
+					const auto type = static_cast<GemCommandType>(producer % 4);
+					for (std::uint64_t i = 0; i < perProducer; ++i) {
+						bool pushed = false;
+						while (!pushed) {
+							if (producer == 0) {
+								pushed = push.Measure([&]() { return queue->Push(type, producer); });
+							} else {
+								pushed = queue->Push(type, producer);
+							}
+							if (!pushed) {
+								++fullRetries[producer];
+								std::this_thread::yield();
+							}
+						}
+					}
+					finished.fetch_add(1, std::memory_order_release);
+				});
+			}
+
+			std::array<std::uint64_t, kProducers> received{};
+			std::uint64_t mismatched = 0;
+			LatencyRecorder drain("drain (per frame)", options.cycles / 64);
+			const auto consume = [&](const GemCommand& command) {
+				if (command.slot >= kProducers || command.type != static_cast<GemCommandType>(command.slot % 4)) {
+					++mismatched;
+					return;
+				}
+				++received[command.slot];
+			};
+			while (finished.load(std::memory_order_acquire) < kProducers) {
+				drain.Measure([&]() { return queue->Drain(consume); });
+				std::this_thread::yield();
+			}
+			for (auto& thread : producers) {
+				thread.join();
+			}
+			queue->Drain(consume);
+
+			push.Report();
+			drain.Report();
+			const auto stats = queue->GetStats();
+			std::uint64_t retries = 0;
+			for (const auto count : fullRetries) {
+				retries += count;
+			}
+			std::printf("  pushed %llu, drained %llu, ring-full retries %llu, max depth %zu, latency avg %lld us / max %lld us\n",
+				static_cast<unsigned long long>(stats.pushed),
+				static_cast<unsigned long long>(stats.drained),
+				static_cast<unsigned long long>(retries),
+				stats.maxDepth,
+				static_cast<long long>(stats.averageLatencyUs),
+				static_cast<long long>(stats.maxLatencyUs));
+
+			auto& checks = Checks::Get();
+			checks.Expect(mismatched == 0, kSuite, "a drained command was corrupted");
+			checks.Expect(stats.pushed == perProducer * kProducers, kSuite, "push count does not match commands sent");
+			checks.Expect(stats.drained == stats.pushed, kSuite, "commands were lost or duplicated");
+			checks.Expect(stats.dropped == retries, kSuite, "drop counter does not match ring-full retries");
+			checks.Expect(stats.maxDepth <= GemCommandQueue::kCapacity, kSuite, "depth exceeded ring capacity");
+			for (const auto count : received) {
+				checks.Expect(count == perProducer, kSuite, "a producer's commands did not all arrive");
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,353 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            Config INI Benchmark                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/ConfigIni.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "config_ini";
+		constexpr std::array<const char*, kTierCount> kTierNames{ "Novice", "Apprentice", "Adept", "Expert", "Master" };
+		constexpr std::size_t kRequiredSettings = 20;
+
+		std::string LegacyTrim(const std::string& value)
+		{
+			auto begin = value.find_first_not_of(" \t\r\n");
+			if (begin == std::string::npos) {
+				return {};
+			}
+			auto end = value.find_last_not_of(" \t\r\n");
+			return value.substr(begin, end - begin + 1);
+		}
+
+		bool LegacyParseBool(const std::string& value, bool& out)
+		{
+			std::string lowered = value;
+			std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+			if (lowered == "true" || lowered == "1" || lowered == "yes") {
+				out = true;
+				return true;
+			}
+			if (lowered == "false" || lowered == "0" || lowered == "no") {
+				out = false;
+				return true;
+			}
+			return false;
+		}
+
+		// The getline/substr/stof loop Config::Load used before ConfigIni, minus its per-key logging. It never read
+		// FocusSpellDuration or FragmentFormID, and throws on a malformed number.
+		void LegacyParse(std::istream& file, ConfigValues& values)
+		{
+			std::string currentSection;
+			std::string line;
+			while (std::getline(file, line)) {
+				line = LegacyTrim(line);
+				if (line.empty() || line.front() == ';' || line.front() == '#') {
+					continue;
+				}
+				if (line.front() == '[' && line.back() == ']') {
+					currentSection = LegacyTrim(line.substr(1, line.size() - 2));
+					continue;
+				}
+				auto delimiter = line.find('=');
+				if (delimiter == std::string::npos) {
+					continue;
+				}
+				auto key = LegacyTrim(line.substr(0, delimiter));
+				auto value = LegacyTrim(line.substr(delimiter + 1));
+
+				if (currentSection == "Settings" && key == "StarCooldown") {
+					values.starCooldown = std::max(std::stof(value), 0.0f);
+					continue;
+				}
+				if (currentSection == "Input" && key == "StoreKey") {
+					values.storeKey = static_cast<std::uint32_t>(std::stoul(value));
+					continue;
+				}
+				if (currentSection == "Activation" && key == "MaxStoredGems") {
+					values.maxStoredGems = std::clamp(static_cast<std::uint8_t>(std::stoul(value)), kMinStoredGems, kMaxStoredGems);
+					continue;
+				}
+				if (currentSection == "Activation" && key.starts_with("Slot") && key.ends_with("Key")) {
+					std::size_t index = static_cast<std::size_t>(std::stoul(key.substr(4, key.size() - 7)));
+					if (index > 0 && index <= values.activationKeys.size()) {
+						values.activationKeys[index - 1] = static_cast<std::uint32_t>(std::stoul(value));
+					}
+					continue;
+				}
+				const std::array<std::pair<const char*, bool*>, 8> flags{ {
+					{ "FiniteUse", &values.finiteUse },
+					{ "RequireFilledSoulGem", &values.requireFilledSoulGem },
+					{ "AllowAnyGemTier", &values.allowAnyGemTier },
+					{ "BlackSoulGemBoosts", &values.blackSoulGemBoosts },
+					{ "NormalGemPenalty", &values.normalGemPenalty },
+					{ "AzurasStarBoost", &values.azurasStarBoost },
+					{ "ShowUsesRemaining", &values.showUsesRemaining },
+					{ "CompressSaveData", &values.compressSaveData },
+				} };
+				bool matched = false;
+				for (const auto& [name, target] : flags) {
+					if (currentSection == "Settings" && key == name) {
+						bool parsed = *target;
+						if (LegacyParseBool(value, parsed)) {
+							*target = parsed;
+						}
+						matched = true;
+						break;
+					}
+				}
+				if (matched) {
+					continue;
+				}
+				for (std::size_t i = 0; i < values.tiers.size(); ++i) {
+					if (currentSection != kTierNames[i]) {
+						continue;
+					}
+					if (key == "Cooldown") {
+						values.tiers[i].cooldown = std::stof(value);
+					} else if (key == "Uses") {
+						values.tiers[i].uses = std::stoi(value);
+					} else if (key == "FragmentCount") {
+						values.fragmentCounts[i] = static_cast<std::uint32_t>(std::stoul(value));
+					}
+				}
+			}
+		}
+
+		bool SameValues(const ConfigValues& a, const ConfigValues& b)
+		{
+			bool same = a.fragmentCounts == b.fragmentCounts && a.activationKeys == b.activationKeys && a.storeKey == b.storeKey &&
+				a.fragmentFormId == b.fragmentFormId && a.focusSpellDuration == b.focusSpellDuration &&
+				a.starCooldown == b.starCooldown && a.maxStoredGems == b.maxStoredGems && a.finiteUse == b.finiteUse &&
+				a.showUsesRemaining == b.showUsesRemaining && a.compressSaveData == b.compressSaveData &&
+				a.requireFilledSoulGem == b.requireFilledSoulGem && a.allowAnyGemTier == b.allowAnyGemTier &&
+				a.blackSoulGemBoosts == b.blackSoulGemBoosts && a.normalGemPenalty == b.normalGemPenalty &&
+				a.azurasStarBoost == b.azurasStarBoost;
+			for (std::size_t i = 0; i < a.tiers.size(); ++i) {
+				same &= a.tiers[i].cooldown == b.tiers[i].cooldown && a.tiers[i].uses == b.tiers[i].uses;
+			}
+			return same;
+		}
+
+		const char* RandomBool(std::uint32_t& rng)
+		{
+			constexpr std::array<const char*, 6> kSpellings{ "true", "false", "1", "0", "Yes", "NO" };
+			return kSpellings[NextRandom(rng) % kSpellings.size()];
+		}
+
+		// A well-formed file the legacy parser reads too: every section repeated with fresh values, interleaved with
+		// comments, blank lines and keys neither parser knows. Later repeats win in both.
+		std::string MakeLargeIni(std::size_t targetBytes, std::uint32_t seed)
+		{
+			std::uint32_t rng = seed;
+			std::string text = "; Spell Gems\n";
+			while (text.size() < targetBytes) {
+				text += "[Input]\nStoreKey=" + std::to_string(NextRandom(rng) % 256) + "\n# comment line\n\n";
+				text += "[Settings]\n";
+				for (const char* key : { "FiniteUse", "RequireFilledSoulGem", "AllowAnyGemTier", "BlackSoulGemBoosts",
+						 "NormalGemPenalty", "AzurasStarBoost", "CompressSaveData", "ShowUsesRemaining" }) {
+					text += std::string(key) + " = " + RandomBool(rng) + "\n";
+				}
+				text += "StarCooldown=" + std::to_string(NextRandom(rng) % 40) + ".5\n";
+				text += "UnknownSetting" + std::to_string(NextRandom(rng) % 100) + "=whatever\n\n";
+				text += "[Activation]\nMaxStoredGems=" + std::to_string(NextRandom(rng) % 8) + "\n";
+				for (std::size_t i = 1; i <= kActivationSlotCount; ++i) {
+					text += "Slot" + std::to_string(i) + "Key=" + std::to_string(NextRandom(rng) % 256) + "\n";
+				}
+				for (const char* tier : kTierNames) {
+					text += "\n[" + std::string(tier) + "]\n";
+					text += "Cooldown=" + std::to_string(NextRandom(rng) % 60) + "." + std::to_string(NextRandom(rng) % 10) + "\n";
+					text += "Uses=" + std::to_string(static_cast<int>(NextRandom(rng) % 30) - 1) + "\n";
+					text += "FragmentCount=" + std::to_string(NextRandom(rng) % 5) + "\n";
+					text += "; " + std::string(tier) + " notes\n";
+				}
+				text += "\n[Unrelated.Mod]\nKey=Value\nOther = 12\n\n";
+			}
+			return text;
+		}
+
+		void CheckEquivalent(std::uint32_t seed)
+		{
+			const auto text = MakeLargeIni(64 * 1024, seed);
+			ConfigValues legacy{};
+			std::istringstream stream(text);
+			LegacyParse(stream, legacy);
+			ConfigValues parsed{};
+			const auto result = ConfigIni::Parse(text, parsed);
+			auto& checks = Checks::Get();
+			checks.Expect(SameValues(legacy, parsed), kSuite, "parsers disagree on a well-formed file");
+			checks.Expect(result.issues.empty() && result.missingRequired == 0 && result.unknown > 0, kSuite,
+				"well-formed file reported issues or missing entries");
+		}
+
+		// Every key in the table dispatches to its own field, including the two the old loop never read.
+		void CheckAllSettings()
+		{
+			const std::string text =
+				"\xEF\xBB\xBF[Input]\r\nStoreKey=0x20\r\n"
+				"[Settings]\nFiniteUse=false\nRequireFilledSoulGem=no\nAllowAnyGemTier=TRUE\nBlackSoulGemBoosts=0\n"
+				"NormalGemPenalty=0\nAzurasStarBoost=false\nFocusSpellDuration=9.0\nStarCooldown=-4\n"
+				"FragmentFormID=0x000ABCDE ; Iron ingot\nCompressSaveData=yes\nShowUsesRemaining=false\n"
+				"[ Activation ]\nMaxStoredGems=9\nSlot1Key=11\nSlot2Key=12\nSlot3Key=13\nSlot4Key=14\nSlot5Key=15\n"
+				"[Novice]\nCooldown=1.5\nUses=-1\nFragmentCount=2\n[Apprentice]\nCooldown=2.5\nUses=2\nFragmentCount=3\n"
+				"[Adept]\nCooldown=3.5\nUses=3\nFragmentCount=4\n[Expert]\nCooldown=4.5\nUses=4\nFragmentCount=5\n"
+				"[Master]\nCooldown=5.5\nUses=5\nFragmentCount=6\n"
+				"[Rules]\nRule=spell=0x0001C789 school=destruction|Alteration tier=Master gem=Black|BlackStar -> uses=2 healthcost=4\n";
+			// Rules already in values are replaced, not appended to.
+			ConfigValues values{};
+			values.rules.resize(3);
+			const auto result = ConfigIni::Parse(text, values);
+
+			ConfigValues expected{};
+			expected.storeKey = 0x20;
+			expected.finiteUse = false;
+			expected.requireFilledSoulGem = false;
+			expected.allowAnyGemTier = true;
+			expected.blackSoulGemBoosts = false;
+			expected.normalGemPenalty = false;
+			expected.azurasStarBoost = false;
+			expected.focusSpellDuration = kMaxFocusSpellDuration;
+			expected.starCooldown = 0.0f;
+			expected.fragmentFormId = 0x000ABCDE;
+			expected.compressSaveData = true;
+			expected.showUsesRemaining = false;
+			expected.maxStoredGems = kMaxStoredGems;
+			expected.activationKeys = { 11, 12, 13, 14, 15 };
+			expected.tiers = { { { 1.5f, -1 }, { 2.5f, 2 }, { 3.5f, 3 }, { 4.5f, 4 }, { 5.5f, 5 } } };
+			expected.fragmentCounts = { 2, 3, 4, 5, 6 };
+			GemRule rule{};
+			rule.spellId = 0x0001C789;
+			rule.schoolMask = static_cast<std::uint8_t>(SchoolFlags::Alteration) | static_cast<std::uint8_t>(SchoolFlags::Destruction);
+			rule.tierMask = 1 << static_cast<std::uint8_t>(SpellTier::Master);
+			rule.gemMask = (1 << static_cast<std::uint8_t>(GemClass::Black)) | (1 << static_cast<std::uint8_t>(GemClass::BlackStar));
+			rule.effects = GemRule::kUses | GemRule::kHealthCost;
+			rule.uses = 2;
+			rule.healthCostFraction = 1.0f;
+			expected.rules = { rule };
+
+			auto& checks = Checks::Get();
+			checks.Expect(SameValues(values, expected) && values.rules == expected.rules, kSuite, "a setting did not reach its field");
+			checks.Expect(result.applied == ConfigIni::GetSettingCount() && result.unknown == 0 && result.issues.empty() &&
+							  result.missingRequired == 0,
+				kSuite, "full file did not apply every setting exactly once");
+
+			ConfigValues empty{};
+			checks.Expect(ConfigIni::Parse("", empty).missingRequired == kRequiredSettings, kSuite,
+				"empty file did not report every required setting missing");
+		}
+
+		// Bad lines are reported by number and skipped; the legacy loop threw on the first bad number instead.
+		void CheckBadLines()
+		{
+			const std::string text =
+				"[Novice]\n"          // 1
+				"Cooldown=7.25\n"     // 2
+				"Uses=abc\n"          // 3
+				"FragmentCount=2x\n"  // 4
+				"[Settings\n"         // 5
+				"no delimiter here\n" // 6
+				"[Settings]\n"        // 7
+				"FiniteUse=maybe\n"   // 8
+				"[Master]\n"          // 9
+				"Uses=9\n";           // 10
+			ConfigValues values{};
+			const auto result = ConfigIni::Parse(text, values);
+
+			auto& checks = Checks::Get();
+			const std::array<std::size_t, 5> expectedLines{ 3, 4, 5, 6, 8 };
+			bool linesMatch = result.issues.size() == expectedLines.size();
+			for (std::size_t i = 0; linesMatch && i < expectedLines.size(); ++i) {
+				linesMatch = result.issues[i].line == expectedLines[i];
+			}
+			checks.Expect(linesMatch, kSuite, "bad lines were not reported with their line numbers");
+
+			const ConfigValues defaults{};
+			checks.Expect(values.tiers[0].cooldown == 7.25f && values.tiers[0].uses == defaults.tiers[0].uses &&
+							  values.fragmentCounts[0] == defaults.fragmentCounts[0] && values.finiteUse == defaults.finiteUse &&
+							  values.tiers[4].uses == 9,
+				kSuite, "bad lines disturbed other settings");
+
+			ConfigValues legacy{};
+			std::istringstream stream(text);
+			bool threw = false;
+			try {
+				LegacyParse(stream, legacy);
+			} catch (const std::exception&) {
+				threw = true;
+			}
+			checks.Expect(threw, kSuite, "legacy parser was expected to throw on a bad number");
+		}
+
+		// Both parsers reading the same file from disk, as Config::Load does.
+		void Run(const Options& options)
+		{
+			CheckEquivalent(options.seed);
+			CheckAllSettings();
+			CheckBadLines();
+
+			auto& checks = Checks::Get();
+			const auto path = std::filesystem::temp_directory_path() / "spellgems_config_bench.ini";
+			for (const std::size_t kib : { 4u, 256u, 4096u }) {
+				const auto text = MakeLargeIni(kib * 1024, options.seed ^ static_cast<std::uint32_t>(kib));
+				{
+					std::ofstream out(path, std::ios::binary | std::ios::trunc);
+					out.write(text.data(), static_cast<std::streamsize>(text.size()));
+				}
+
+				const auto repeats = std::clamp<std::uint64_t>(options.cycles / (kib * 64), 3, 500);
+				const auto label = " (" + std::to_string(kib) + " KiB)";
+				LatencyRecorder legacyLoad("legacy getline" + label, repeats);
+				LatencyRecorder iniLoad("ConfigIni slurp" + label, repeats);
+				LatencyRecorder iniParse("ConfigIni parse only" + label, repeats);
+				bool same = true;
+				for (std::uint64_t i = 0; i < repeats; ++i) {
+					ConfigValues legacy{};
+					legacyLoad.Measure([&]() {
+						std::ifstream file(path);
+						LegacyParse(file, legacy);
+					});
+
+					ConfigValues parsed{};
+					iniLoad.Measure([&]() {
+						std::ifstream file(path, std::ios::binary | std::ios::ate);
+						std::string buffer(static_cast<std::size_t>(file.tellg()), '\0');
+						file.seekg(0);
+						file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+						return ConfigIni::Parse(buffer, parsed).applied;
+					});
+					same &= SameValues(legacy, parsed);
+
+					ConfigValues inMemory{};
+					iniParse.Measure([&]() { return ConfigIni::Parse(text, inMemory).applied; });
+				}
+				checks.Expect(same, kSuite, "parsers disagree on a file read from disk");
+
+				std::printf("  %zu KiB, %zu lines\n", text.size() / 1024, static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')));
+				legacyLoad.Report();
+				iniLoad.Report();
+				iniParse.Report();
+			}
+			std::filesystem::remove(path);
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
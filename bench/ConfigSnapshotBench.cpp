@@ -0,0 +1,138 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                          Config Snapshot Benchmark                                          //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/ConfigSnapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "config_snapshot";
+		constexpr std::size_t kReaderThreads = 3;
+
+		// A writer stamps every field of an edit with the same number, so a reader that sees two different
+		// numbers in one snapshot has seen a torn write.
+		void Stamp(ConfigValues& values, std::uint32_t stamp)
+		{
+			for (auto& tier : values.tiers) {
+				tier = { static_cast<float>(stamp), static_cast<std::int32_t>(stamp) };
+			}
+			values.activationKeys.fill(stamp);
+			values.fragmentCounts.fill(stamp);
+			values.storeKey = stamp;
+			values.starCooldown = static_cast<float>(stamp);
+		}
+
+		bool IsConsistent(const ConfigSnapshot& snapshot)
+		{
+			const auto& values = snapshot.values;
+			const auto stamp = values.storeKey;
+			const auto& outcomes = snapshot.rules.outcomes;
+			bool consistent = values.starCooldown == static_cast<float>(stamp) &&
+				outcomes.Find(0, SpellTier::Novice, 0, GemClass::AzurasStar).cooldownDays == values.starCooldown / kSecondsPerGameDay;
+			for (std::size_t i = 0; i < kTierCount; ++i) {
+				const auto& outcome = outcomes.Find(0, static_cast<SpellTier>(i), 0, GemClass::Normal);
+				consistent &= values.tiers[i].uses == static_cast<std::int32_t>(stamp) && values.fragmentCounts[i] == stamp &&
+					outcome.uses == values.tiers[i].uses && outcome.cooldownDays == values.tiers[i].cooldown / kSecondsPerGameDay;
+			}
+			return consistent && std::all_of(values.activationKeys.begin(), values.activationKeys.end(), [&](std::uint32_t key) {
+				return key == stamp;
+			});
+		}
+
+		void CheckDerived()
+		{
+			ConfigPublisher publisher;
+			const auto first = publisher.Get();
+			const auto second = publisher.Update([](ConfigValues& values) { values.tiers[2].cooldown = 86.4f; });
+			auto& checks = Checks::Get();
+			checks.Expect(second->generation == first->generation + 1 && publisher.Get() == second, kSuite,
+				"update did not publish a new generation");
+			checks.Expect(first->values.tiers[2].cooldown == ConfigValues{}.tiers[2].cooldown, kSuite,
+				"update modified a published snapshot");
+			checks.Expect(second->rules.outcomes.Find(0, SpellTier::Adept, 0, GemClass::Normal).cooldownDays == 86.4f / kSecondsPerGameDay,
+				kSuite, "derived cooldown does not match the edited value");
+		}
+
+		// Readers on several threads hammer Get while one writer keeps publishing; every snapshot a reader sees
+		// must be internally consistent, and generations must never go backwards.
+		void Run(const Options& options)
+		{
+			CheckDerived();
+
+			ConfigPublisher publisher;
+			publisher.Update([](ConfigValues& values) { Stamp(values, 0); });
+
+			const auto readsPerThread = std::max<std::uint64_t>(options.cycles, 10'000);
+			std::atomic<bool> writing{ true };
+			std::atomic<std::uint64_t> torn{ 0 };
+			std::atomic<std::uint64_t> regressed{ 0 };
+			std::vector<LatencyRecorder> readers;
+			for (std::size_t i = 0; i < kReaderThreads; ++i) {
+				readers.emplace_back("Get under writes (reader " + std::to_string(i + 1) + ")", readsPerThread);
+			}
+
+			std::vector<std::thread> threads;
+			for (std::size_t i = 0; i < kReaderThreads; ++i) {
+				threads.emplace_back([&, i]() {
+					std::uint32_t lastGeneration = 0;
+					for (std::uint64_t n = 0; n < readsPerThread; ++n) {
+						const auto snapshot = readers[i].Measure([&]() { return publisher.Get(); });
+						torn.fetch_add(IsConsistent(*snapshot) ? 0 : 1, std::memory_order_relaxed);
+						regressed.fetch_add(snapshot->generation < lastGeneration ? 1 : 0, std::memory_order_relaxed);
+						lastGeneration = snapshot->generation;
+					}
+				});
+			}
+
+			LatencyRecorder writes("Update", 0);
+			std::uint32_t stamp = 1;
+			std::thread writer([&]() {
+				while (writing.load(std::memory_order_relaxed)) {
+					const auto next = stamp++;
+					writes.Measure([&]() { publisher.Update([&](ConfigValues& values) { Stamp(values, next); }); });
+				}
+			});
+
+			for (auto& thread : threads) {
+				thread.join();
+			}
+			writing.store(false, std::memory_order_relaxed);
+			writer.join();
+
+			auto& checks = Checks::Get();
+			checks.Expect(torn.load() == 0, kSuite, "a reader saw a torn snapshot");
+			checks.Expect(regressed.load() == 0, kSuite, "a reader saw the generation go backwards");
+			std::printf("  %u snapshots published during %llu reads\n", stamp - 1,
+				static_cast<unsigned long long>(readsPerThread * kReaderThreads));
+
+			LatencyRecorder quiet("Get without writes", readsPerThread);
+			std::uint64_t sum = 0;
+			for (std::uint64_t n = 0; n < readsPerThread; ++n) {
+				sum += quiet.Measure([&]() { return publisher.Get(); })->generation;
+			}
+			checks.Expect(sum > 0, kSuite, "quiet reads returned no snapshot");
+
+			for (auto& reader : readers) {
+				reader.Report();
+			}
+			writes.Report();
+			quiet.Report();
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,178 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                           Config Writer Benchmark                                           //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/ConfigIni.h"
+#include "SpellGems/Core/ConfigWriter.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		using namespace std::chrono_literals;
+
+		constexpr const char* kSuite = "config_writer";
+		constexpr auto kIdleTimeout = 10s;
+
+		std::string ReadFile(const std::filesystem::path& path)
+		{
+			std::ifstream file(path, std::ios::binary);
+			return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+		}
+
+		ConfigValues RandomValues(std::uint32_t& rng)
+		{
+			ConfigValues values{};
+			for (auto& tier : values.tiers) {
+				tier = { static_cast<float>(NextRandom(rng) % 600) / 7.0f, static_cast<std::int32_t>(NextRandom(rng) % 30) - 1 };
+			}
+			for (auto& key : values.activationKeys) {
+				key = NextRandom(rng) % 256;
+			}
+			values.fragmentCounts[NextRandom(rng) % kTierCount] = NextRandom(rng) % 10;
+			values.storeKey = NextRandom(rng) % 256;
+			values.fragmentFormId = NextRandom(rng);
+			values.focusSpellDuration = static_cast<float>(NextRandom(rng) % 31) / 10.0f;
+			values.starCooldown = static_cast<float>(NextRandom(rng) % 1000) / 3.0f;
+			values.maxStoredGems = static_cast<std::uint8_t>(kMinStoredGems + NextRandom(rng) % 3);
+			values.finiteUse = NextRandom(rng) % 2 == 0;
+			values.allowAnyGemTier = NextRandom(rng) % 2 == 0;
+			values.compressSaveData = NextRandom(rng) % 2 == 0;
+			values.rules.resize(NextRandom(rng) % 4);
+			for (auto& rule : values.rules) {
+				rule.spellId = NextRandom(rng) % 2 == 0 ? 0 : NextRandom(rng) | 1;
+				rule.schoolMask = static_cast<std::uint8_t>(NextRandom(rng) % kSchoolMaskCount);
+				rule.tierMask = static_cast<std::uint8_t>(NextRandom(rng) % (1 << kTierCount));
+				rule.gemMask = static_cast<std::uint8_t>(NextRandom(rng) % (1 << kGemClassCount));
+				rule.effects = static_cast<std::uint8_t>(NextRandom(rng) % 31 + 1);
+				rule.cooldown = (rule.effects & GemRule::kCooldown) != 0 ? static_cast<float>(NextRandom(rng) % 600) / 7.0f : 0.0f;
+				rule.uses = (rule.effects & GemRule::kUses) != 0 ? static_cast<std::int32_t>(NextRandom(rng) % 30) - 1 : 0;
+				rule.effectiveness = (rule.effects & GemRule::kEffectiveness) != 0 ? static_cast<float>(NextRandom(rng) % 300) / 100.0f : 1.0f;
+				rule.magnitudeOverride = (rule.effects & GemRule::kMagnitude) != 0 ? static_cast<float>(NextRandom(rng) % 300) / 100.0f : 0.0f;
+				rule.healthCostFraction = (rule.effects & GemRule::kHealthCost) != 0 ? static_cast<float>(NextRandom(rng) % 100) / 99.0f : 0.0f;
+			}
+			return values;
+		}
+
+		// Written text must parse back to the same values with nothing missing, floats and rules included. Rule is
+		// the one key that appears once per rule rather than once.
+		void CheckRoundTrip(std::uint32_t seed)
+		{
+			std::uint32_t rng = seed;
+			bool same = true;
+			bool complete = true;
+			for (int i = 0; i < 200; ++i) {
+				const auto values = RandomValues(rng);
+				std::string text;
+				ConfigIni::Write(values, text);
+				ConfigValues parsed{};
+				const auto result = ConfigIni::Parse(text, parsed);
+				same &= parsed == values;
+				complete &= result.issues.empty() && result.missingRequired == 0 && result.applied == ConfigIni::GetSettingCount() - 1 + values.rules.size();
+			}
+			Checks::Get().Expect(same, kSuite, "written config does not parse back to the same values");
+			Checks::Get().Expect(complete, kSuite, "written config is missing settings or has bad lines");
+		}
+
+		// A failed write must leave the old file intact and no temporary file behind.
+		void CheckFailure(const std::filesystem::path& directory)
+		{
+			const auto path = directory / "SpellGems.ini";
+			ConfigWriter::WriteFileAtomically(path, "[Input]\nStoreKey=1\n");
+			const auto blocked = directory / "SpellGems.ini.tmp";
+			std::filesystem::create_directory(blocked);
+			const bool written = ConfigWriter::WriteFileAtomically(path, "[Input]\nStoreKey=2\n");
+			auto& checks = Checks::Get();
+			checks.Expect(!written && ReadFile(path) == "[Input]\nStoreKey=1\n", kSuite, "failed write disturbed the old file");
+			std::filesystem::remove(blocked);
+		}
+
+		void Run(const Options& options)
+		{
+			CheckRoundTrip(options.seed);
+
+			const auto directory = std::filesystem::temp_directory_path() / "spellgems_writer_bench";
+			std::filesystem::remove_all(directory);
+			std::filesystem::create_directories(directory);
+			CheckFailure(directory);
+
+			auto& checks = Checks::Get();
+			const auto path = directory / "SpellGems.ini";
+			std::uint32_t rng = options.seed;
+			ConfigPublisher publisher;
+
+			// A burst of saves inside the coalescing window costs one write, of the last snapshot.
+			{
+				std::atomic<std::uint64_t> callbacks{ 0 };
+				ConfigWriter writer(100ms, [&](const std::filesystem::path&, bool) { ++callbacks; });
+				ConfigSnapshotPtr last;
+				LatencyRecorder submit("Submit (caller side)", 64);
+				for (int i = 0; i < 64; ++i) {
+					last = publisher.Publish(RandomValues(rng));
+					submit.Measure([&]() { writer.Submit(path, last); });
+				}
+				checks.Expect(writer.WaitIdle(kIdleTimeout), kSuite, "writer did not go idle");
+				const auto stats = writer.GetStats();
+				checks.Expect(stats.written == 1 && stats.superseded == 63 && callbacks.load() == 1, kSuite,
+					"burst of saves was not coalesced into one write");
+				ConfigValues onDisk{};
+				ConfigIni::Parse(ReadFile(path), onDisk);
+				checks.Expect(onDisk == last->values, kSuite, "coalesced write did not hold the last snapshot");
+				checks.Expect(!std::filesystem::exists(directory / "SpellGems.ini.tmp"), kSuite, "temporary file left behind");
+				submit.Report();
+			}
+
+			// Pending work is flushed when the writer is destroyed.
+			{
+				ConfigSnapshotPtr last = publisher.Publish(RandomValues(rng));
+				{
+					ConfigWriter writer(1s, {});
+					writer.Submit(path, last);
+				}
+				ConfigValues onDisk{};
+				ConfigIni::Parse(ReadFile(path), onDisk);
+				checks.Expect(onDisk == last->values, kSuite, "pending save was lost on shutdown");
+			}
+
+			// Serialization cost, and the full crash-safe write the worker performs.
+			const auto values = RandomValues(rng);
+			const auto repeats = std::max<std::uint64_t>(options.cycles / 10, 1'000);
+			LatencyRecorder serialize("ConfigIni::Write", repeats);
+			std::size_t bytes = 0;
+			for (std::uint64_t i = 0; i < repeats; ++i) {
+				std::string text;
+				serialize.Measure([&]() { ConfigIni::Write(values, text); });
+				bytes = text.size();
+			}
+
+			const auto fileRepeats = std::clamp<std::uint64_t>(options.cycles / 1'000, 5, 200);
+			LatencyRecorder atomicWrite("write + flush + rename", fileRepeats);
+			std::string text;
+			ConfigIni::Write(values, text);
+			for (std::uint64_t i = 0; i < fileRepeats; ++i) {
+				atomicWrite.Measure([&]() { return ConfigWriter::WriteFileAtomically(path, text); });
+			}
+			std::printf("  %zu bytes per file\n", bytes);
+			serialize.Report();
+			atomicWrite.Report();
+
+			std::filesystem::remove_all(directory);
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,139 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            Core Cycle Benchmark                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include <cstdio>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "core_cycles";
+		constexpr FormID kGemBase = 0x00100000;
+		constexpr FormID kSpellBase = 0x00200000;
+		constexpr std::uint32_t kGemForms = 64;
+		constexpr std::uint32_t kSpellForms = 512;
+		constexpr std::size_t kMaxLive = 256;
+		constexpr std::uint64_t kSaveInterval = 1024;
+
+		bool SameData(const StoredSpellData& lhs, const StoredSpellData& rhs)
+		{
+			return lhs.spellId == rhs.spellId && lhs.tier == rhs.tier && lhs.usesRemaining == rhs.usesRemaining &&
+			       lhs.lastUsedGameTime == rhs.lastUsedGameTime && lhs.isReusableStar == rhs.isReusableStar &&
+			       lhs.isBlackSoulGem == rhs.isBlackSoulGem;
+		}
+
+		bool SameStore(const GemStore& expected, const GemStore& actual)
+		{
+			if (expected.Size() != actual.Size() || expected.GetSlotIndex().Size() != actual.GetSlotIndex().Size()) {
+				return false;
+			}
+			for (const auto& [key, data] : expected.GetEntries()) {
+				const auto loaded = actual.Get(key);
+				if (!loaded || !SameData(data, *loaded)) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void LoadInto(GemStore& store, MemoryCoSave& cosave)
+		{
+			store.ClearEntries();
+			cosave.Rewind();
+			std::uint32_t type = 0;
+			std::uint32_t version = 0;
+			std::uint32_t length = 0;
+			while (cosave.GetNextRecordInfo(type, version, length)) {
+				store.LoadRecord(cosave, type, version, length);
+			}
+		}
+
+		// Replays the plugin's steady state: store a gem, fire a hotkey slot, use a gem from the inventory, and
+		// periodically save and reload the whole table.
+		void Run(const Options& options)
+		{
+			SimWorld world;
+			for (std::uint32_t i = 0; i < kGemForms; ++i) {
+				world.forms.AddGem(kGemBase + i, static_cast<SpellTier>(i % kTierCount));
+			}
+			for (std::uint32_t i = 0; i < kSpellForms; ++i) {
+				world.forms.AddSpell(kSpellBase + i);
+			}
+
+			const auto cycles = options.cycles;
+			LatencyRecorder store("store", cycles);
+			LatencyRecorder activate("activate", cycles);
+			LatencyRecorder consume("consume", cycles);
+			LatencyRecorder save("save", cycles / kSaveInterval + 1);
+			LatencyRecorder load("load", cycles / kSaveInterval + 1);
+
+			MemoryCoSave cosave;
+			GemStore loaded;
+			std::uint32_t rng = options.seed;
+			std::uint64_t rejected = 0;
+			std::uint64_t depleted = 0;
+			auto& checks = Checks::Get();
+
+			for (std::uint64_t cycle = 0; cycle < cycles; ++cycle) {
+				if (world.store.Size() < kMaxLive) {
+					const GemKey key{ kGemBase + NextRandom(rng) % kGemForms, world.store.AllocateUniqueId() };
+					StoredSpellData data{};
+					data.spellId = kSpellBase + NextRandom(rng) % kSpellForms;
+					data.tier = static_cast<SpellTier>(key.baseId % kTierCount);
+					data.usesRemaining = 1 + static_cast<std::int32_t>(NextRandom(rng) % 4);
+					data.isBlackSoulGem = (rng & 0x10) != 0;
+					if (!store.Measure([&]() { return world.core.Store(key, data, false); })) {
+						++rejected;
+					}
+				}
+
+				if (const auto size = world.store.GetSlotIndex().Size(); size > 0) {
+					const auto slot = NextRandom(rng) % size;
+					const auto result = activate.Measure([&]() { return world.core.Activate(slot, world.rules); });
+					checks.Expect(result.status == ActivateStatus::Cast, kSuite, "activation of a live slot did not cast");
+					depleted += result.consumed == ConsumeStatus::Depleted;
+				}
+				world.calendar.AdvanceSeconds(1.0f);
+
+				if (const auto size = world.store.GetSlotIndex().Size(); size > 0) {
+					const auto key = *world.store.GetSlotIndex().At(NextRandom(rng) % size);
+					const auto data = *world.store.Get(key);
+					const auto status = consume.Measure([&]() { return world.core.Consume(key, data, world.rules); });
+					depleted += status == ConsumeStatus::Depleted;
+				}
+
+				if (cycle % kSaveInterval == 0) {
+					cosave.Clear();
+					save.Measure([&]() { world.store.Save(cosave); });
+					load.Measure([&]() { LoadInto(loaded, cosave); });
+					checks.Expect(SameStore(world.store, loaded), kSuite, "save/load round trip changed the table");
+				}
+
+				checks.Expect(world.store.Size() == world.store.GetSlotIndex().Size(), kSuite, "slot index out of step with table");
+			}
+
+			store.Report();
+			activate.Report();
+			consume.Report();
+			save.Report();
+			load.Report();
+			std::printf("  casts %llu, depleted %llu, rejected stores %llu, live %zu, co-save %zu bytes\n",
+				static_cast<unsigned long long>(world.caster.GetCastCount()),
+				static_cast<unsigned long long>(depleted),
+				static_cast<unsigned long long>(rejected),
+				world.store.Size(),
+				cosave.GetSize());
+			checks.Expect(world.caster.GetCastCount() == activate.Count(), kSuite, "cast count does not match activations");
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,155 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            File Watcher Benchmark                                           //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/ConfigIni.h"
+#include "SpellGems/Core/ConfigSnapshot.h"
+#include "SpellGems/Core/FileWatcher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		using namespace std::chrono_literals;
+
+		constexpr const char* kSuite = "file_watcher";
+		constexpr auto kPollInterval = 20ms;
+		constexpr auto kDebounce = 60ms;
+		constexpr auto kSettle = 1s;
+
+		void WriteFile(const std::filesystem::path& path, const std::string& text)
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			file.write(text.data(), static_cast<std::streamsize>(text.size()));
+		}
+
+		std::string MakeIni(std::uint32_t storeKey, float noviceCooldown)
+		{
+			return "[Input]\nStoreKey=" + std::to_string(storeKey) + "\n[Novice]\nCooldown=" + std::to_string(noviceCooldown) + "\n";
+		}
+
+		// Waits until count reaches at least target or the deadline passes.
+		bool WaitFor(const std::atomic<std::uint64_t>& count, std::uint64_t target, FileWatcher::Clock::duration timeout)
+		{
+			const auto deadline = FileWatcher::Clock::now() + timeout;
+			while (count.load() < target) {
+				if (FileWatcher::Clock::now() > deadline) {
+					return false;
+				}
+				std::this_thread::sleep_for(1ms);
+			}
+			return true;
+		}
+
+		FileWatcher::Settings MakeSettings(bool allowNative)
+		{
+			FileWatcher::Settings settings{};
+			settings.pollInterval = kPollInterval;
+			settings.debounce = kDebounce;
+			settings.allowNative = allowNative;
+			return settings;
+		}
+
+		// A burst of writes is reported once, an acknowledged write not at all, and a reload that fails to parse
+		// leaves the published config alone.
+		void CheckBehaviour(const std::filesystem::path& path, bool allowNative)
+		{
+			auto& checks = Checks::Get();
+			WriteFile(path, MakeIni(10, 1.0f));
+
+			ConfigPublisher publisher;
+			std::atomic<std::uint64_t> calls{ 0 };
+			std::atomic<std::uint64_t> rejected{ 0 };
+			FileWatcher watcher;
+			watcher.Start(path, [&]() {
+				std::ifstream file(path, std::ios::binary);
+				const std::string text{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+				const auto published = publisher.Update([&](ConfigValues& values) {
+					const auto result = ConfigIni::Parse(text, values);
+					return result.issues.empty() && result.applied > 0;
+				});
+				rejected += published ? 0 : 1;
+				++calls;
+			}, MakeSettings(allowNative));
+			checks.Expect(watcher.GetBackend() == (allowNative ? FileWatcher::Backend::Native : FileWatcher::Backend::Polling), kSuite,
+				"watcher did not pick the expected backend");
+
+			for (std::uint32_t i = 0; i < 8; ++i) {
+				WriteFile(path, MakeIni(20 + i, 2.0f));
+				std::this_thread::sleep_for(5ms);
+			}
+			checks.Expect(WaitFor(calls, 1, kSettle), kSuite, "burst of writes was not reported");
+			std::this_thread::sleep_for(kDebounce * 3);
+			checks.Expect(calls.load() == 1, kSuite, "burst of writes was reported more than once");
+			checks.Expect(publisher.Get()->values.storeKey == 27 && publisher.Get()->values.tiers[0].cooldown == 2.0f, kSuite,
+				"reload did not publish the last write");
+
+			WriteFile(path, MakeIni(40, 3.0f));
+			watcher.Acknowledge();
+			std::this_thread::sleep_for(kDebounce * 4);
+			checks.Expect(calls.load() == 1 && watcher.GetStats().suppressed >= 1, kSuite, "acknowledged write was reported");
+
+			WriteFile(path, "[Input]\nStoreKey=oops\n");
+			checks.Expect(WaitFor(calls, 2, kSettle) && rejected.load() == 1, kSuite, "bad file was not rejected");
+			checks.Expect(publisher.Get()->values.storeKey == 27, kSuite, "bad file changed the published config");
+
+			watcher.Stop();
+			checks.Expect(watcher.GetBackend() == FileWatcher::Backend::None, kSuite, "stopped watcher still reports a backend");
+		}
+
+		// Write-to-callback latency for each backend; the debounce period is the floor for both.
+		void Run(const Options& options)
+		{
+			const auto directory = std::filesystem::temp_directory_path() / "spellgems_watch_bench";
+			std::filesystem::create_directories(directory);
+			const auto path = directory / "SpellGems.ini";
+
+			for (const bool allowNative : { true, false }) {
+				CheckBehaviour(path, allowNative);
+
+				WriteFile(path, MakeIni(1, 1.0f));
+				std::atomic<std::uint64_t> calls{ 0 };
+				FileWatcher watcher;
+				watcher.Start(path, [&]() { ++calls; }, MakeSettings(allowNative));
+
+				const auto samples = std::clamp<std::uint64_t>(options.cycles / 10'000, 3, 20);
+				LatencyRecorder detect(std::string(allowNative ? "native" : "polling") + " write to callback", samples);
+				for (std::uint64_t i = 0; i < samples; ++i) {
+					const auto target = calls.load() + 1;
+					const auto start = FileWatcher::Clock::now();
+					WriteFile(path, MakeIni(static_cast<std::uint32_t>(100 + i), 1.0f));
+					const bool seen = WaitFor(calls, target, kSettle);
+					detect.Add(FileWatcher::Clock::now() - start);
+					Checks::Get().Expect(seen, kSuite, "write was not detected");
+				}
+
+				LatencyRecorder stop(std::string(allowNative ? "native" : "polling") + " stop", 1);
+				stop.Measure([&]() { watcher.Stop(); });
+				const auto stats = watcher.GetStats();
+				std::printf("  %s: %llu wakeups, %llu changes, %llu fired\n", allowNative ? "native" : "polling",
+					static_cast<unsigned long long>(stats.wakeups), static_cast<unsigned long long>(stats.changes),
+					static_cast<unsigned long long>(stats.fired));
+				detect.Report();
+				stop.Report();
+			}
+			std::filesystem::remove_all(directory);
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,299 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                             Gem Rule Benchmark                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include "SpellGems/Core/ConfigIni.h"
+#include "SpellGems/Core/ConfigSnapshot.h"
+#include "SpellGems/Core/GemRuleTable.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "gem_rules";
+		constexpr FormID kSpellBase = 0x00012FCD;
+		constexpr FormID kGemBase = 0x0002E4E2;
+
+		constexpr std::uint8_t Bit(auto value)
+		{
+			return static_cast<std::uint8_t>(1u << static_cast<std::uint8_t>(value));
+		}
+
+		constexpr std::uint8_t School(SchoolFlags school)
+		{
+			return static_cast<std::uint8_t>(school);
+		}
+
+		// Store uses, cooldown and cast boosts exactly as the store path, GemCore and CastPlan derived them before
+		// the table existed.
+		GemOutcome LegacyOutcome(const ConfigValues& values, SpellTier tier, std::uint8_t schoolMask, GemClass gem)
+		{
+			const bool isReusableStar = gem == GemClass::AzurasStar || gem == GemClass::BlackStar;
+			const bool isBlackSoulGem = gem == GemClass::Black || gem == GemClass::BlackStar;
+			const auto& tierSettings = values.tiers[static_cast<std::size_t>(tier)];
+
+			GemOutcome outcome{};
+			outcome.cooldownSeconds = isReusableStar ? values.starCooldown : tierSettings.cooldown;
+			outcome.cooldownDays = outcome.cooldownSeconds / kSecondsPerGameDay;
+			outcome.uses = isReusableStar ? -1 : (values.finiteUse ? tierSettings.uses : -1);
+			if (gem == GemClass::AzurasStar && values.azurasStarBoost) {
+				outcome.effectiveness = 1.05f;
+				outcome.magnitudeOverride = 1.05f;
+			} else if (!isBlackSoulGem && !isReusableStar && values.normalGemPenalty) {
+				outcome.effectiveness = 0.9f;
+				outcome.magnitudeOverride = 0.9f;
+			} else if (isBlackSoulGem && values.blackSoulGemBoosts) {
+				if ((schoolMask & School(SchoolFlags::Destruction)) != 0) {
+					outcome.magnitudeOverride = 1.1f;
+				}
+				if ((schoolMask & (School(SchoolFlags::Conjuration) | School(SchoolFlags::Alteration))) != 0) {
+					outcome.effectiveness = 1.1f;
+				}
+				outcome.healthCostFraction = 0.05f;
+			}
+			return outcome;
+		}
+
+		GemRule RandomRule(std::uint32_t& rng)
+		{
+			GemRule rule{};
+			rule.spellId = NextRandom(rng) % 4 == 0 ? kSpellBase + NextRandom(rng) % 64 : 0;
+			rule.schoolMask = NextRandom(rng) % 2 == 0 ? 0 : static_cast<std::uint8_t>(NextRandom(rng) % kSchoolMaskCount);
+			rule.tierMask = NextRandom(rng) % 2 == 0 ? 0 : static_cast<std::uint8_t>(NextRandom(rng) % (1 << kTierCount));
+			rule.gemMask = NextRandom(rng) % 2 == 0 ? 0 : static_cast<std::uint8_t>(NextRandom(rng) % (1 << kGemClassCount));
+			rule.effects = static_cast<std::uint8_t>(NextRandom(rng) % 31 + 1);
+			// Fields without their effect bit stay at their defaults, as the parser leaves them.
+			if ((rule.effects & GemRule::kCooldown) != 0) {
+				rule.cooldown = static_cast<float>(NextRandom(rng) % 600) / 10.0f;
+			}
+			if ((rule.effects & GemRule::kUses) != 0) {
+				rule.uses = static_cast<std::int32_t>(NextRandom(rng) % 12) - 1;
+			}
+			if ((rule.effects & GemRule::kEffectiveness) != 0) {
+				rule.effectiveness = static_cast<float>(NextRandom(rng) % 200) / 100.0f;
+			}
+			if ((rule.effects & GemRule::kMagnitude) != 0) {
+				rule.magnitudeOverride = static_cast<float>(NextRandom(rng) % 200) / 100.0f;
+			}
+			if ((rule.effects & GemRule::kHealthCost) != 0) {
+				rule.healthCostFraction = static_cast<float>(NextRandom(rng) % 20) / 100.0f;
+			}
+			return rule;
+		}
+
+		ConfigValues RandomValues(std::uint32_t& rng, std::size_t ruleCount)
+		{
+			ConfigValues values{};
+			values.finiteUse = NextRandom(rng) % 4 != 0;
+			values.azurasStarBoost = NextRandom(rng) % 2 == 0;
+			values.normalGemPenalty = NextRandom(rng) % 2 == 0;
+			values.blackSoulGemBoosts = NextRandom(rng) % 2 == 0;
+			for (std::size_t i = 0; i < ruleCount; ++i) {
+				values.rules.push_back(RandomRule(rng));
+			}
+			return values;
+		}
+
+		// Without rules every cell must hold what the code paths the table replaced worked out.
+		void CheckLegacy(std::uint32_t seed)
+		{
+			std::uint32_t rng = seed;
+			bool same = true;
+			for (int round = 0; round < 16; ++round) {
+				const auto values = RandomValues(rng, 0);
+				const GemRuleTable table(values);
+				for (std::size_t tier = 0; tier < kTierCount; ++tier) {
+					for (std::size_t schoolMask = 0; schoolMask < kSchoolMaskCount; ++schoolMask) {
+						for (std::size_t gem = 0; gem < kGemClassCount; ++gem) {
+							const auto spellTier = static_cast<SpellTier>(tier);
+							const auto mask = static_cast<std::uint8_t>(schoolMask);
+							const auto gemClass = static_cast<GemClass>(gem);
+							same &= table.Find(kSpellBase, spellTier, mask, gemClass) == LegacyOutcome(values, spellTier, mask, gemClass);
+						}
+					}
+				}
+			}
+			Checks::Get().Expect(same, kSuite, "rule-free table differs from the legacy tier settings and boosts");
+		}
+
+		// Later rules win field by field, a spell rule only reaches its spell, and FiniteUse and reusable stars
+		// still force unlimited uses.
+		void CheckPrecedence()
+		{
+			constexpr FormID kWard = kSpellBase + 1;
+			constexpr FormID kFireball = kSpellBase + 2;
+			constexpr FormID kIncinerate = kSpellBase + 3;
+			const auto destruction = School(SchoolFlags::Destruction);
+
+			ConfigValues values{};
+			GemRule masterDestruction{};
+			masterDestruction.schoolMask = destruction;
+			masterDestruction.tierMask = Bit(SpellTier::Master);
+			masterDestruction.effects = GemRule::kUses | GemRule::kCooldown;
+			masterDestruction.uses = 2;
+			masterDestruction.cooldown = 40.0f;
+			GemRule ward{};
+			ward.spellId = kWard;
+			ward.effects = GemRule::kCooldown;
+			ward.cooldown = 0.5f;
+			GemRule blackDestruction{};
+			blackDestruction.schoolMask = destruction;
+			blackDestruction.gemMask = Bit(GemClass::Black);
+			blackDestruction.effects = GemRule::kCooldown | GemRule::kHealthCost;
+			blackDestruction.cooldown = 25.0f;
+			blackDestruction.healthCostFraction = 0.2f;
+			GemRule starUses{};
+			starUses.gemMask = Bit(GemClass::AzurasStar);
+			starUses.effects = GemRule::kUses;
+			starUses.uses = 3;
+			values.rules = { masterDestruction, ward, blackDestruction, starUses };
+
+			const GemRuleTable table(values);
+			auto& checks = Checks::Get();
+			const auto& master = table.Find(kIncinerate, SpellTier::Master, destruction, GemClass::Normal);
+			checks.Expect(master.uses == 2 && master.cooldownSeconds == 40.0f && master.effectiveness == 0.9f, kSuite,
+				"master destruction rule did not apply over the tier settings");
+			const auto& masterBlack = table.Find(kIncinerate, SpellTier::Master, destruction, GemClass::Black);
+			checks.Expect(masterBlack.uses == 2 && masterBlack.cooldownSeconds == 25.0f && masterBlack.healthCostFraction == 0.2f &&
+							  masterBlack.magnitudeOverride == 1.1f,
+				kSuite, "later rule did not override only the fields it sets");
+			const auto& adept = table.Find(kFireball, SpellTier::Adept, destruction, GemClass::Normal);
+			checks.Expect(adept.uses == values.tiers[2].uses && adept.cooldownSeconds == values.tiers[2].cooldown, kSuite,
+				"tier condition matched another tier");
+			const auto& wardOutcome = table.Find(kWard, SpellTier::Apprentice, School(SchoolFlags::Restoration), GemClass::Normal);
+			const auto& otherWard = table.Find(kFireball, SpellTier::Apprentice, School(SchoolFlags::Restoration), GemClass::Normal);
+			checks.Expect(wardOutcome.cooldownSeconds == 0.5f && otherWard.cooldownSeconds == values.tiers[1].cooldown &&
+							  table.GetNamedSpellCount() == 1,
+				kSuite, "spell rule did not stay with its spell");
+			checks.Expect(table.Find(kFireball, SpellTier::Novice, destruction, GemClass::AzurasStar).uses == -1, kSuite,
+				"a rule gave a reusable star finite uses");
+
+			values.finiteUse = false;
+			checks.Expect(GemRuleTable(values).Find(kIncinerate, SpellTier::Master, destruction, GemClass::Normal).uses == -1, kSuite,
+				"a rule gave finite uses with FiniteUse off");
+		}
+
+		// Random rule lists: every lookup must match walking the rules, and written rules must parse back.
+		void CheckRandom(std::uint32_t seed)
+		{
+			std::uint32_t rng = seed;
+			bool same = true;
+			bool roundTrip = true;
+			for (int round = 0; round < 32; ++round) {
+				const auto values = RandomValues(rng, 1 + NextRandom(rng) % kMaxGemRules);
+				const GemRuleTable table(values);
+				for (int query = 0; query < 2'000; ++query) {
+					const FormID spellId = kSpellBase + NextRandom(rng) % 96;
+					const auto tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+					const auto schoolMask = static_cast<std::uint8_t>(NextRandom(rng) % kSchoolMaskCount);
+					const auto gem = static_cast<GemClass>(NextRandom(rng) % kGemClassCount);
+					same &= table.Find(spellId, tier, schoolMask, gem) == GemRuleTable::Evaluate(values, spellId, tier, schoolMask, gem);
+				}
+
+				std::string text;
+				ConfigIni::Write(values, text);
+				ConfigValues parsed{};
+				roundTrip &= ConfigIni::Parse(text, parsed).issues.empty() && parsed.rules == values.rules;
+			}
+			auto& checks = Checks::Get();
+			checks.Expect(same, kSuite, "table lookup disagrees with evaluating the rules");
+			checks.Expect(roundTrip, kSuite, "written rules did not parse back");
+
+			ConfigValues values{};
+			const auto result = ConfigIni::Parse("[Rules]\nRule=school=Destruction uses=2\nRule=tier=Legend -> uses=2\n"
+												 "Rule=school=Destruction ->\nRule=gem=Black -> uses=two\nRule=-> cooldown=1\n",
+				values);
+			checks.Expect(result.issues.size() == 4 && values.rules.size() == 1, kSuite, "malformed rules were not rejected by line");
+		}
+
+		// A spell rule gates activation through GemCore: the ward rests between casts, its neighbour does not.
+		void CheckActivation()
+		{
+			constexpr FormID kWard = kSpellBase + 1;
+			constexpr FormID kFlames = kSpellBase + 2;
+			SimWorld world;
+			world.forms.AddSpell(kWard, School(SchoolFlags::Restoration));
+			world.forms.AddSpell(kFlames, School(SchoolFlags::Destruction));
+			for (const auto spellId : { kWard, kFlames }) {
+				StoredSpellData data{};
+				data.spellId = spellId;
+				data.usesRemaining = -1;
+				world.core.Store({ kGemBase + spellId - kSpellBase, 1 }, data, false);
+			}
+
+			ConfigValues values{};
+			values.tiers.fill({ 0.0f, 5 });
+			GemRule rule{};
+			rule.spellId = kWard;
+			rule.effects = GemRule::kCooldown;
+			rule.cooldown = 60.0f;
+			values.rules = { rule };
+			world.rules = MakeGemRules(values);
+
+			const auto ward = world.core.Activate(0, world.rules).status;
+			const auto wardAgain = world.core.Activate(0, world.rules).status;
+			const auto flames = world.core.Activate(1, world.rules).status;
+			const auto flamesAgain = world.core.Activate(1, world.rules).status;
+			Checks::Get().Expect(ward == ActivateStatus::Cast && wardAgain == ActivateStatus::OnCooldown &&
+									 flames == ActivateStatus::Cast && flamesAgain == ActivateStatus::Cast,
+				kSuite, "spell rule cooldown did not gate activation");
+		}
+
+		// Per-cast lookup against walking the rule list on every cast, at the rule cap, plus what a publish pays to
+		// compile the table.
+		void Run(const Options& options)
+		{
+			CheckLegacy(options.seed);
+			CheckPrecedence();
+			CheckRandom(options.seed);
+			CheckActivation();
+
+			auto& checks = Checks::Get();
+			for (const std::size_t ruleCount : { std::size_t{ 0 }, std::size_t{ 8 }, kMaxGemRules }) {
+				std::uint32_t rng = options.seed ^ static_cast<std::uint32_t>(ruleCount);
+				const auto values = RandomValues(rng, ruleCount);
+				const auto suffix = " (" + std::to_string(ruleCount) + " rules)";
+
+				const auto compiles = std::clamp<std::uint64_t>(options.cycles / 1'000, 10, 1'000);
+				LatencyRecorder compile("compile" + suffix, compiles);
+				for (std::uint64_t i = 0; i < compiles; ++i) {
+					compile.Measure([&]() { return GemRuleTable(values).GetNamedSpellCount(); });
+				}
+
+				const GemRuleTable table(values);
+				LatencyRecorder evaluate("evaluate per cast" + suffix, options.cycles);
+				LatencyRecorder lookup("table lookup" + suffix, options.cycles);
+				float checksum = 0.0f;
+				bool same = true;
+				for (std::uint64_t i = 0; i < options.cycles; ++i) {
+					const FormID spellId = kSpellBase + NextRandom(rng) % 96;
+					const auto tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+					const auto schoolMask = static_cast<std::uint8_t>(NextRandom(rng) % kSchoolMaskCount);
+					const auto gem = static_cast<GemClass>(NextRandom(rng) % kGemClassCount);
+					const auto slow = evaluate.Measure([&]() { return GemRuleTable::Evaluate(values, spellId, tier, schoolMask, gem); });
+					const auto fast = lookup.Measure([&]() { return table.Find(spellId, tier, schoolMask, gem); });
+					same &= slow == fast;
+					checksum += fast.cooldownDays;
+				}
+				checks.Expect(same && checksum >= 0.0f, kSuite, "timed lookups disagree with evaluation");
+
+				compile.Report();
+				evaluate.Report();
+				lookup.Report();
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
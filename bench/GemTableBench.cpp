@@ -0,0 +1,193 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            Gem Table Benchmark                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/GemTable.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "gem_table";
+
+		using NodeMap = std::unordered_map<GemKey, StoredSpellData, GemKeyHash>;
+
+		// Light-plugin style keys: 0xFE prefix, a 12-bit plugin index and a small per-plugin form range.
+		GemKey MakeKey(std::uint32_t& rng)
+		{
+			const auto plugin = NextRandom(rng) % 64;
+			const auto form = 0x800 + NextRandom(rng) % 32;
+			return { 0xFE000000 | (plugin << 12) | form, static_cast<std::uint16_t>(NextRandom(rng)) };
+		}
+
+		StoredSpellData MakeData(std::uint32_t& rng)
+		{
+			StoredSpellData data{};
+			data.spellId = 0x00012FCD + NextRandom(rng) % 512;
+			data.tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+			data.usesRemaining = static_cast<std::int32_t>(NextRandom(rng) % 8) - 1;
+			data.lastUsedGameTime = static_cast<float>(NextRandom(rng) % 1000) * 0.5f;
+			data.isReusableStar = (rng & 1) != 0;
+			data.isBlackSoulGem = (rng & 2) != 0;
+			return data;
+		}
+
+		bool SameData(const StoredSpellData& lhs, const StoredSpellData& rhs)
+		{
+			return lhs.spellId == rhs.spellId && lhs.tier == rhs.tier && lhs.usesRemaining == rhs.usesRemaining &&
+			       lhs.lastUsedGameTime == rhs.lastUsedGameTime && lhs.isReusableStar == rhs.isReusableStar &&
+			       lhs.isBlackSoulGem == rhs.isBlackSoulGem;
+		}
+
+		bool SameContents(const GemTable& table, const NodeMap& map)
+		{
+			if (table.Size() != map.size()) {
+				return false;
+			}
+			std::size_t visited = 0;
+			for (const auto& [key, data] : table) {
+				auto it = map.find(key);
+				if (it == map.end() || !SameData(it->second, data)) {
+					return false;
+				}
+				++visited;
+			}
+			return visited == map.size();
+		}
+
+		// Randomized insert/overwrite/erase against std::unordered_map as the oracle.
+		void CheckAgainstMap(const Options& options)
+		{
+			std::uint32_t rng = options.seed;
+			GemTable table;
+			NodeMap map;
+			bool agreed = true;
+			for (std::uint32_t i = 0; i < 200'000 && agreed; ++i) {
+				auto key = MakeKey(rng);
+				key.uniqueId %= 512;
+				const auto op = NextRandom(rng) % 3;
+				if (op < 2) {
+					const auto data = MakeData(rng);
+					agreed &= table.InsertOrAssign(key, data) == map.insert_or_assign(key, data).second;
+				} else {
+					agreed &= table.Erase(key) == (map.erase(key) > 0);
+				}
+				if (i % 4096 == 0) {
+					agreed &= SameContents(table, map);
+				}
+			}
+			agreed &= SameContents(table, map);
+			for (const auto& [key, data] : map) {
+				const auto found = table.Find(key);
+				agreed &= found.has_value() && SameData(*found, data);
+			}
+			Checks::Get().Expect(agreed, kSuite, "flat table diverged from std::unordered_map");
+		}
+
+		template <class Insert, class Find, class Erase, class Iterate>
+		void Measure(const std::string& label, const std::vector<GemKey>& keys, const std::vector<GemKey>& misses,
+			std::uint64_t lookups, std::uint32_t seed, Insert&& insert, Find&& find, Erase&& erase, Iterate&& iterate)
+		{
+			std::uint32_t rng = seed;
+			LatencyRecorder inserts(label + " insert", keys.size());
+			for (const auto& key : keys) {
+				const auto data = MakeData(rng);
+				inserts.Measure([&]() { insert(key, data); });
+			}
+
+			LatencyRecorder hits(label + " find hit", lookups);
+			LatencyRecorder missed(label + " find miss", lookups);
+			std::uint64_t sink = 0;
+			for (std::uint64_t i = 0; i < lookups; ++i) {
+				const auto& hitKey = keys[NextRandom(rng) % keys.size()];
+				sink += hits.Measure([&]() { return find(hitKey); });
+				const auto& missKey = misses[NextRandom(rng) % misses.size()];
+				sink += missed.Measure([&]() { return find(missKey); });
+			}
+
+			LatencyRecorder iterations(label + " iterate", 64);
+			for (int i = 0; i < 64; ++i) {
+				sink += iterations.Measure([&]() { return iterate(); });
+			}
+
+			LatencyRecorder erases(label + " erase", keys.size());
+			for (const auto& key : keys) {
+				erases.Measure([&]() { erase(key); });
+			}
+
+			inserts.Report();
+			hits.Report();
+			missed.Report();
+			iterations.Report();
+			erases.Report();
+			Checks::Get().Expect(sink > 0, kSuite, "lookups found nothing");
+		}
+
+		// Same keys, data and access pattern through the old node map and the flat table at 1k/10k/100k entries.
+		void Run(const Options& options)
+		{
+			CheckAgainstMap(options);
+
+			for (const std::size_t count : { 1'000u, 10'000u, 100'000u }) {
+				std::uint32_t rng = options.seed ^ static_cast<std::uint32_t>(count);
+				NodeMap unique;
+				std::vector<GemKey> keys;
+				while (keys.size() < count) {
+					const auto key = MakeKey(rng);
+					if (unique.emplace(key, StoredSpellData{}).second) {
+						keys.push_back(key);
+					}
+				}
+				std::vector<GemKey> misses;
+				while (misses.size() < 4096) {
+					auto key = MakeKey(rng);
+					key.baseId ^= 0x00800000;
+					misses.push_back(key);
+				}
+
+				const auto suffix = " (" + std::to_string(count) + ")";
+				NodeMap map;
+				Measure("unordered_map" + suffix, keys, misses, options.cycles, options.seed,
+					[&](const GemKey& key, const StoredSpellData& data) { map.insert_or_assign(key, data); },
+					[&](const GemKey& key) { auto it = map.find(key); return it != map.end() ? it->second.usesRemaining + 2 : 0; },
+					[&](const GemKey& key) { map.erase(key); },
+					[&]() {
+						std::int64_t uses = 0;
+						for (const auto& [key, data] : map) {
+							uses += data.usesRemaining + 2;
+						}
+						return uses;
+					});
+
+				GemTable table;
+				Measure("GemTable" + suffix, keys, misses, options.cycles, options.seed,
+					[&](const GemKey& key, const StoredSpellData& data) { table.InsertOrAssign(key, data); },
+					[&](const GemKey& key) {
+						const auto index = table.FindIndex(key);
+						return index != GemTable::kNotFound ? table.GetHot(index).usesRemaining + 2 : 0;
+					},
+					[&](const GemKey& key) { table.Erase(key); },
+					[&]() {
+						std::int64_t uses = 0;
+						for (const auto& [key, data] : table) {
+							uses += data.usesRemaining + 2;
+						}
+						return uses;
+					});
+				Checks::Get().Expect(table.Empty() && map.empty(), kSuite, "erase left entries behind");
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,220 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            ID Allocator Benchmark                                           //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include "SpellGems/Core/GemIdAllocator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "id_allocator";
+		constexpr FormID kGemBase = 0xFE000800;
+		constexpr std::size_t kUsableIds = GemIdAllocator::kIdCount - 1;
+
+		// The obvious next-fit allocator: one bool per ID and a linear walk from the cursor.
+		class LinearAllocator
+		{
+		public:
+			std::uint16_t Allocate()
+			{
+				for (std::size_t step = 0; step < GemIdAllocator::kIdCount; ++step) {
+					const auto id = static_cast<std::uint16_t>(cursor_ + step);
+					if (id != 0 && !used_[id]) {
+						used_[id] = true;
+						cursor_ = static_cast<std::uint16_t>(id + 1);
+						return id;
+					}
+				}
+				return 0;
+			}
+
+			void Free(std::uint16_t id) { used_[id] = false; }
+
+		private:
+			std::vector<bool> used_ = std::vector<bool>(GemIdAllocator::kIdCount);
+			std::uint16_t cursor_{ 1 };
+		};
+
+		StoredSpellData MakeData()
+		{
+			StoredSpellData data{};
+			data.spellId = 0x00012FCD;
+			data.usesRemaining = 3;
+			return data;
+		}
+
+		void LoadInto(GemStore& store, MemoryCoSave& cosave)
+		{
+			store.ClearEntries();
+			cosave.Rewind();
+			std::uint32_t type = 0;
+			std::uint32_t version = 0;
+			std::uint32_t length = 0;
+			while (cosave.GetNextRecordInfo(type, version, length)) {
+				store.LoadRecord(cosave, type, version, length);
+			}
+		}
+
+		// Exhaustion, wraparound past the cursor and the state encoding.
+		void CheckAllocator()
+		{
+			auto& checks = Checks::Get();
+			GemIdAllocator ids;
+			std::vector<bool> seen(GemIdAllocator::kIdCount);
+			bool distinct = true;
+			for (std::size_t i = 0; i < kUsableIds; ++i) {
+				const auto id = ids.Allocate();
+				distinct &= id != 0 && !seen[id];
+				seen[id] = true;
+			}
+			checks.Expect(distinct, kSuite, "allocation handed out 0 or a live ID before exhaustion");
+			checks.Expect(ids.Allocate() == 0 && ids.GetUsedCount() == GemIdAllocator::kIdCount, kSuite,
+				"full allocator returned an ID");
+
+			// The cursor sits at the top after exhaustion, so the next ID comes from past the wrap.
+			ids.Free(40'000);
+			ids.Free(7);
+			checks.Expect(ids.Allocate() == 7, kSuite, "allocation did not wrap to the lowest free ID");
+			checks.Expect(ids.Allocate() == 40'000, kSuite, "allocation did not continue from the cursor");
+			checks.Expect(ids.Allocate() == 0, kSuite, "full allocator returned an ID after recycling");
+
+			ids.Free(0);
+			checks.Expect(ids.IsUsed(0), kSuite, "ID 0 was freed");
+
+			std::uint32_t rng = 0xA110C;
+			for (int i = 0; i < 20'000; ++i) {
+				ids.Free(static_cast<std::uint16_t>(NextRandom(rng)));
+			}
+			std::vector<std::uint8_t> state;
+			ids.EncodeState(state);
+			GemIdAllocator decoded;
+			bool same = decoded.DecodeState(state) && decoded.GetCursor() == ids.GetCursor() &&
+			            decoded.GetUsedCount() == ids.GetUsedCount();
+			for (std::size_t id = 0; same && id < GemIdAllocator::kIdCount; ++id) {
+				same = decoded.IsUsed(static_cast<std::uint16_t>(id)) == ids.IsUsed(static_cast<std::uint16_t>(id));
+			}
+			checks.Expect(same, kSuite, "allocator state did not round-trip");
+			checks.Expect(decoded.Allocate() == ids.Allocate(), kSuite, "decoded allocator diverged");
+
+			state.resize(state.size() - 1);
+			checks.Expect(!decoded.DecodeState(state) && decoded.GetUsedCount() == 1, kSuite,
+				"truncated state was accepted");
+		}
+
+		// Remove frees IDs, shared IDs survive until their last key goes, and a load rebuilds the bitmap.
+		void CheckStore()
+		{
+			auto& checks = Checks::Get();
+			GemStore store;
+			const auto first = store.AllocateUniqueId();
+			const auto second = store.AllocateUniqueId();
+			store.Store({ kGemBase, first }, MakeData());
+			store.Store({ kGemBase, second }, MakeData());
+			store.Store({ kGemBase + 1, second }, MakeData());
+			const auto& ids = store.GetIdAllocator();
+
+			store.Remove({ kGemBase, first });
+			checks.Expect(!ids.IsUsed(first), kSuite, "removed key kept its ID");
+			store.Remove({ kGemBase, second });
+			checks.Expect(ids.IsUsed(second), kSuite, "shared ID was freed while another key held it");
+			store.Remove({ kGemBase + 1, second });
+			checks.Expect(!ids.IsUsed(second), kSuite, "shared ID was not freed with its last key");
+
+			// An ID handed out but never stored stays reserved across a save; a game-assigned one is picked up.
+			const auto pending = store.AllocateUniqueId();
+			store.Store({ kGemBase, 900 }, MakeData());
+			MemoryCoSave cosave;
+			store.Save(cosave);
+			GemStore loaded;
+			LoadInto(loaded, cosave);
+			checks.Expect(loaded.GetIdAllocator().IsUsed(pending) && loaded.GetIdAllocator().IsUsed(900) &&
+			                  loaded.GetIdAllocator().GetUsedCount() == 3,
+				kSuite, "v6 load did not restore the allocator");
+			loaded.Remove({ kGemBase, 900 });
+			checks.Expect(!loaded.GetIdAllocator().IsUsed(900), kSuite, "loaded key did not free its ID");
+
+			// A v5 state record carries only the counter: the cursor resumes there, the bitmap is the live keys.
+			cosave.Clear();
+			cosave.OpenRecord(GemStore::kRecordState, 5);
+			const std::uint16_t nextUniqueId = 300;
+			cosave.Write(nextUniqueId);
+			cosave.OpenRecord(GemStore::kRecordSpells, 5);
+			GemTable table;
+			table.InsertOrAssign({ kGemBase, 12 }, MakeData());
+			table.InsertOrAssign({ kGemBase, 299 }, MakeData());
+			const GemKey order[] = { { kGemBase, 12 }, { kGemBase, 299 } };
+			std::vector<std::uint8_t> body;
+			SpellRecordCodec::Encode(table, order, SpellRecordCodec::Encoding::Packed, body);
+			cosave.WriteRaw(body.data(), static_cast<std::uint32_t>(body.size()));
+			LoadInto(loaded, cosave);
+			checks.Expect(loaded.GetIdAllocator().GetUsedCount() == 3 && loaded.AllocateUniqueId() == 300, kSuite,
+				"v5 load did not rebuild the allocator from live keys");
+		}
+
+		// Random free followed by allocate at a fixed occupancy; the free-list oracle catches a live ID coming back.
+		template <class Allocator>
+		void Churn(Allocator& allocator, const std::string& label, std::size_t occupied, std::uint64_t steps,
+			std::uint32_t seed, bool verify)
+		{
+			std::vector<std::uint16_t> live;
+			live.reserve(occupied);
+			std::vector<bool> used(GemIdAllocator::kIdCount);
+			while (live.size() < occupied) {
+				const auto id = allocator.Allocate();
+				live.push_back(id);
+				used[id] = true;
+			}
+
+			std::uint32_t rng = seed;
+			bool valid = true;
+			LatencyRecorder allocate(label, steps);
+			for (std::uint64_t i = 0; i < steps; ++i) {
+				const auto slot = NextRandom(rng) % live.size();
+				allocator.Free(live[slot]);
+				used[live[slot]] = false;
+				const auto id = allocate.Measure([&]() { return allocator.Allocate(); });
+				valid &= id != 0 && !used[id];
+				used[id] = true;
+				live[slot] = id;
+			}
+			if (verify) {
+				Checks::Get().Expect(valid, kSuite, "churn handed out a live ID");
+			}
+			allocate.Report();
+		}
+
+		// Allocation latency under free/allocate churn from half full to one free ID in a thousand, bitmap with
+		// summary words against a linear scan.
+		void Run(const Options& options)
+		{
+			CheckAllocator();
+			CheckStore();
+
+			const auto steps = std::clamp<std::uint64_t>(options.cycles / 10, 1'000, 200'000);
+			for (const double occupancy : { 0.5, 0.9, 0.99, 0.999 }) {
+				const auto occupied = static_cast<std::size_t>(occupancy * kUsableIds);
+				const auto suffix = " (" + std::to_string(occupied) + " live)";
+				GemIdAllocator bitmap;
+				Churn(bitmap, "bitmap allocate" + suffix, occupied, steps, options.seed, true);
+				LinearAllocator linear;
+				Churn(linear, "linear allocate" + suffix, occupied, std::min<std::uint64_t>(steps, 20'000), options.seed,
+					false);
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
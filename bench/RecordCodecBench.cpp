@@ -0,0 +1,176 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                           Record Codec Benchmark                                            //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/GemSlotIndex.h"
+#include "SpellGems/Core/SpellRecordCodec.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "record_codec";
+
+		using SpellRecordCodec::Encoding;
+
+		struct Fixture
+		{
+			GemTable table;
+			GemSlotIndex order;
+
+			void Add(const GemKey& key, const StoredSpellData& data)
+			{
+				if (table.InsertOrAssign(key, data)) {
+					order.Insert(key);
+				}
+			}
+		};
+
+		// A long playthrough: a handful of gem and spell plugins, most gems still fresh, sequential unique IDs.
+		void FillTypical(Fixture& fixture, std::size_t count, std::uint32_t& rng)
+		{
+			constexpr FormID kGemForms[] = { 0x0002E4E2, 0x0002E4E4, 0x0002E4E6, 0x0002E4F4, 0x0002E4FC, 0x0002E500,
+				0x0002E504, 0x0001DCF4, 0xFE001800, 0xFE001801 };
+			constexpr FormID kSpellPlugins[] = { 0x00000000, 0x02000000, 0x04000000, 0xFE003000 };
+			for (std::size_t i = 0; fixture.table.Size() < count; ++i) {
+				const GemKey key{ kGemForms[NextRandom(rng) % std::size(kGemForms)], static_cast<std::uint16_t>(i + 1) };
+				StoredSpellData data{};
+				data.spellId = kSpellPlugins[NextRandom(rng) % std::size(kSpellPlugins)] | (0x00012000 + NextRandom(rng) % 0x1000);
+				data.tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+				data.usesRemaining = NextRandom(rng) % 8 == 0 ? -1 : static_cast<std::int32_t>(NextRandom(rng) % 10 + 1);
+				data.lastUsedGameTime = NextRandom(rng) % 4 == 0 ? 12.0f + static_cast<float>(NextRandom(rng) % 4096) / 97.0f : 0.0f;
+				data.isReusableStar = NextRandom(rng) % 32 == 0;
+				data.isBlackSoulGem = NextRandom(rng) % 16 == 0;
+				fixture.Add(key, data);
+			}
+		}
+
+		// No structure to exploit: the worst case for the compressed encoding.
+		void FillRandom(Fixture& fixture, std::size_t count, std::uint32_t& rng)
+		{
+			while (fixture.table.Size() < count) {
+				const GemKey key{ NextRandom(rng), static_cast<std::uint16_t>(NextRandom(rng)) };
+				StoredSpellData data{};
+				data.spellId = NextRandom(rng);
+				data.tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+				data.usesRemaining = static_cast<std::int32_t>(NextRandom(rng));
+				data.lastUsedGameTime = static_cast<float>(NextRandom(rng) % 100000) / 7.0f + 1.0f;
+				data.isReusableStar = (rng & 1) != 0;
+				data.isBlackSoulGem = (rng & 2) != 0;
+				fixture.Add(key, data);
+			}
+		}
+
+		bool Matches(const GemTable& table, const std::vector<SpellRecordCodec::Entry>& decoded, std::size_t expected)
+		{
+			if (decoded.size() != expected) {
+				return false;
+			}
+			for (const auto& [key, data] : decoded) {
+				const auto stored = table.Find(key);
+				if (!stored || stored->spellId != data.spellId || stored->tier != data.tier ||
+					stored->usesRemaining != data.usesRemaining || stored->lastUsedGameTime != data.lastUsedGameTime ||
+					stored->isReusableStar != data.isReusableStar || stored->isBlackSoulGem != data.isBlackSoulGem) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Field extremes and every prefix of a compressed body: decoding must stop cleanly at the cut.
+		void CheckEdges()
+		{
+			auto& checks = Checks::Get();
+			Fixture fixture;
+			const std::int32_t uses[] = { -1, -2, 0, 1, 127, 128, INT_MAX, INT_MIN };
+			const FormID bases[] = { 0x00000001, 0x00000001, 0x0000FFFF, 0xFEFFF800, 0xFFFFFFFF };
+			const std::uint16_t ids[] = { 0, 65535, 1, 2, 65535 };
+			for (std::size_t i = 0; i < std::size(bases); ++i) {
+				for (std::size_t j = 0; j < std::size(uses); ++j) {
+					StoredSpellData data{};
+					data.spellId = (j & 1) ? 0xFFFFFFFF - static_cast<FormID>(i) : static_cast<FormID>(j);
+					data.tier = static_cast<SpellTier>((i + j) % kTierCount);
+					data.usesRemaining = uses[j];
+					data.lastUsedGameTime = j % 3 == 0 ? 0.0f : -0.5f * static_cast<float>(j);
+					data.isReusableStar = (j & 2) != 0;
+					data.isBlackSoulGem = (j & 4) != 0;
+					fixture.Add({ bases[i], static_cast<std::uint16_t>(ids[i] + j * 7) }, data);
+				}
+			}
+
+			std::vector<std::uint8_t> body;
+			std::vector<SpellRecordCodec::Entry> decoded;
+			for (const auto encoding : { Encoding::Packed, Encoding::Compressed }) {
+				SpellRecordCodec::Encode(fixture.table, fixture.order.GetKeys(), encoding, body);
+				SpellRecordCodec::Decode(body, decoded);
+				checks.Expect(Matches(fixture.table, decoded, fixture.table.Size()), kSuite, "edge values did not round-trip");
+			}
+
+			bool prefixesClean = true;
+			for (std::size_t cut = 0; cut < body.size(); ++cut) {
+				const auto count = SpellRecordCodec::Decode(std::span(body).first(cut), decoded);
+				prefixesClean &= count < fixture.table.Size() && Matches(fixture.table, decoded, count);
+			}
+			checks.Expect(prefixesClean, kSuite, "truncated compressed body decoded garbage");
+
+			body[4] = 0x7F;
+			checks.Expect(SpellRecordCodec::Decode(body, decoded) == 0, kSuite, "unknown encoding was decoded");
+		}
+
+		void Measure(const char* profile, const Fixture& fixture, std::uint64_t cycles)
+		{
+			auto& checks = Checks::Get();
+			const auto count = fixture.table.Size();
+			const auto repeats = std::clamp<std::uint64_t>(cycles / count, 3, 500);
+			std::vector<std::uint8_t> body;
+			std::vector<SpellRecordCodec::Entry> decoded;
+			for (const auto encoding : { Encoding::Packed, Encoding::Compressed }) {
+				const std::string label = std::string(encoding == Encoding::Packed ? "packed " : "compressed ") + profile +
+					" (" + std::to_string(count) + ")";
+				LatencyRecorder encode(label + " encode", repeats);
+				LatencyRecorder decode(label + " decode", repeats);
+				for (std::uint64_t i = 0; i < repeats; ++i) {
+					encode.Measure([&]() { SpellRecordCodec::Encode(fixture.table, fixture.order.GetKeys(), encoding, body); });
+					decode.Measure([&]() { SpellRecordCodec::Decode(body, decoded); });
+				}
+				checks.Expect(Matches(fixture.table, decoded, count), kSuite, "bulk body did not round-trip");
+
+				encode.Report();
+				decode.Report();
+				std::printf("  %s: %zu bytes, %.2f bytes/entry\n", label.c_str(), body.size(),
+					static_cast<double>(body.size() - SpellRecordCodec::kHeaderSize) / static_cast<double>(count));
+			}
+		}
+
+		// Encode/decode throughput and bytes per entry for both v5 encodings, on typical and structureless data.
+		void Run(const Options& options)
+		{
+			CheckEdges();
+
+			for (const std::size_t count : { 1'000u, 10'000u, 100'000u }) {
+				std::uint32_t rng = options.seed ^ static_cast<std::uint32_t>(count);
+				Fixture typical;
+				FillTypical(typical, count, rng);
+				Measure("typical", typical, options.cycles);
+
+				Fixture random;
+				FillRandom(random, count, rng);
+				Measure("random", random, options.cycles);
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
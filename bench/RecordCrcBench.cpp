@@ -0,0 +1,248 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            Record CRC Benchmark                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include "SpellGems/Core/Crc32c.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "record_crc";
+		constexpr FormID kGemBase = 0xFE000800;
+
+		struct Record
+		{
+			std::uint32_t type;
+			std::uint32_t version;
+			std::vector<std::uint8_t> data;
+		};
+
+		std::vector<Record> ReadRecords(MemoryCoSave& cosave)
+		{
+			std::vector<Record> records;
+			cosave.Rewind();
+			std::uint32_t type = 0;
+			std::uint32_t version = 0;
+			std::uint32_t length = 0;
+			while (cosave.GetNextRecordInfo(type, version, length)) {
+				Record record{ type, version, std::vector<std::uint8_t>(length) };
+				record.data.resize(cosave.ReadRaw(record.data.data(), length));
+				records.push_back(std::move(record));
+			}
+			return records;
+		}
+
+		void WriteRecords(MemoryCoSave& cosave, const std::vector<Record>& records)
+		{
+			cosave.Clear();
+			for (const auto& record : records) {
+				cosave.OpenRecord(record.type, record.version);
+				cosave.WriteRaw(record.data.data(), static_cast<std::uint32_t>(record.data.size()));
+			}
+		}
+
+		void LoadInto(GemStore& store, MemoryCoSave& cosave)
+		{
+			store.ClearEntries();
+			cosave.Rewind();
+			std::uint32_t type = 0;
+			std::uint32_t version = 0;
+			std::uint32_t length = 0;
+			while (cosave.GetNextRecordInfo(type, version, length)) {
+				store.LoadRecord(cosave, type, version, length);
+			}
+		}
+
+		void Fill(GemStore& store, std::size_t count, std::uint32_t& rng)
+		{
+			store.Clear();
+			for (std::size_t i = 0; i < count; ++i) {
+				const GemKey key{ kGemBase + NextRandom(rng) % 4096, static_cast<std::uint16_t>(i + 1) };
+				StoredSpellData data{};
+				data.spellId = 0x00012FCD + NextRandom(rng) % 1024;
+				data.tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+				data.usesRemaining = static_cast<std::int32_t>(NextRandom(rng) % 12) - 1;
+				data.lastUsedGameTime = static_cast<float>(NextRandom(rng) % 100000) / 64.0f;
+				store.Store(key, data);
+			}
+		}
+
+		bool AllPlausible(const GemStore& store)
+		{
+			for (const auto& [key, data] : store.GetEntries()) {
+				if (static_cast<std::size_t>(data.tier) >= kTierCount || data.usesRemaining < -1 || data.lastUsedGameTime < 0.0f) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void CheckCrc(std::uint32_t seed)
+		{
+			auto& checks = Checks::Get();
+			constexpr std::string_view kCheck = "123456789";
+			const std::span<const std::uint8_t> check(reinterpret_cast<const std::uint8_t*>(kCheck.data()), kCheck.size());
+			checks.Expect(Crc32c::Compute(check) == 0xE3069283 && Crc32c::ExtendSoftware(0, check) == 0xE3069283, kSuite,
+				"CRC32C check value is wrong");
+
+			std::uint32_t rng = seed;
+			std::vector<std::uint8_t> buffer(8'192);
+			for (auto& byte : buffer) {
+				byte = static_cast<std::uint8_t>(NextRandom(rng));
+			}
+			// Short tails, and lengths around the three-lane block of the hardware path.
+			std::vector<std::size_t> sizes;
+			for (std::size_t size = 0; size <= 80; ++size) {
+				sizes.push_back(size);
+			}
+			for (const std::size_t size : { 767u, 768u, 769u, 1'536u, 2'000u, 4'099u, 8'000u }) {
+				sizes.push_back(size);
+			}
+			bool same = true;
+			for (std::size_t offset = 0; offset < 8; ++offset) {
+				for (const auto size : sizes) {
+					const auto data = std::span(buffer).subspan(offset, size);
+					const auto crc = Crc32c::Compute(data);
+					same &= crc == Crc32c::ExtendSoftware(0, data);
+					same &= crc == Crc32c::Extend(Crc32c::Compute(data.first(size / 3)), data.subspan(size / 3));
+				}
+			}
+			checks.Expect(same, kSuite, "hardware, software and chained CRCs disagree");
+		}
+
+		// Damage each way a record can arrive damaged and make sure the load notices and keeps only sane entries.
+		void CheckSalvage(std::uint32_t seed)
+		{
+			auto& checks = Checks::Get();
+			std::uint32_t rng = seed;
+			GemStore original;
+			Fill(original, 2'000, rng);
+			MemoryCoSave cosave;
+			original.Save(cosave);
+			const auto records = ReadRecords(cosave);
+			const auto spells = std::find_if(records.begin(), records.end(),
+				[](const Record& record) { return record.type == GemStore::kRecordSpells; }) - records.begin();
+
+			GemStore loaded;
+			LoadInto(loaded, cosave);
+			checks.Expect(loaded.GetLoadStats().corrupt == 0 && loaded.Size() == original.Size(), kSuite,
+				"intact records were rejected");
+
+			auto damaged = records;
+			damaged[spells].data[100] ^= 0x10;
+			WriteRecords(cosave, damaged);
+			LoadInto(loaded, cosave);
+			checks.Expect(loaded.GetLoadStats().corrupt == 1 && loaded.Size() >= original.Size() - 1, kSuite,
+				"flipped bit was not caught or cost more than its entry");
+
+			damaged = records;
+			damaged[spells].data.resize(damaged[spells].data.size() / 2);
+			WriteRecords(cosave, damaged);
+			LoadInto(loaded, cosave);
+			checks.Expect(loaded.GetLoadStats().corrupt == 1 && loaded.Size() < original.Size() && AllPlausible(loaded), kSuite,
+				"truncated record was not caught");
+
+			damaged = records;
+			for (auto& byte : damaged[spells].data) {
+				byte = static_cast<std::uint8_t>(NextRandom(rng));
+			}
+			damaged[spells].data[4] = 0;
+			WriteRecords(cosave, damaged);
+			LoadInto(loaded, cosave);
+			const auto stats = loaded.GetLoadStats();
+			checks.Expect(stats.corrupt == 1 && stats.dropped > 0 && AllPlausible(loaded), kSuite,
+				"foreign record was trusted");
+
+			// A damaged state record is ignored and the allocator comes from the live keys alone.
+			damaged = records;
+			damaged[1 - spells].data[0] ^= 1;
+			WriteRecords(cosave, damaged);
+			LoadInto(loaded, cosave);
+			checks.Expect(loaded.GetLoadStats().corrupt == 1 && loaded.Size() == original.Size() &&
+			                  loaded.GetIdAllocator().GetUsedCount() == original.Size() + 1,
+				kSuite, "damaged state record was trusted");
+		}
+
+		double Median(std::vector<double>& samples)
+		{
+			std::sort(samples.begin(), samples.end());
+			return samples[samples.size() / 2];
+		}
+
+		// What verifying both trailers costs against the whole load at 10k and 100k entries, with the instruction and
+		// with the table fallback.
+		void Run(const Options& options)
+		{
+			CheckCrc(options.seed);
+			CheckSalvage(options.seed);
+
+			auto& checks = Checks::Get();
+			for (const std::size_t count : { 10'000u, 100'000u }) {
+				std::uint32_t rng = options.seed ^ static_cast<std::uint32_t>(count);
+				GemStore original;
+				Fill(original, count, rng);
+				MemoryCoSave cosave;
+				original.Save(cosave);
+				const auto records = ReadRecords(cosave);
+				const auto repeats = std::clamp<std::uint64_t>(options.cycles / count, 5, 200);
+				const auto suffix = " (" + std::to_string(count) + ")";
+
+				GemStore loaded;
+				LatencyRecorder load("load" + suffix, repeats);
+				LatencyRecorder hardware("crc32c" + std::string(Crc32c::HasHardware() ? " sse4.2" : " table") + suffix, repeats);
+				LatencyRecorder software("crc32c slicing-by-8" + suffix, repeats);
+				std::vector<double> loadUs;
+				std::vector<double> crcUs;
+				std::uint32_t crc = 0;
+				for (std::uint64_t i = 0; i < repeats; ++i) {
+					auto start = LatencyRecorder::Clock::now();
+					load.Measure([&]() { LoadInto(loaded, cosave); });
+					loadUs.push_back(std::chrono::duration<double, std::micro>(LatencyRecorder::Clock::now() - start).count());
+
+					start = LatencyRecorder::Clock::now();
+					hardware.Measure([&]() {
+						for (const auto& record : records) {
+							crc = Crc32c::Compute(record.data);
+						}
+					});
+					crcUs.push_back(std::chrono::duration<double, std::micro>(LatencyRecorder::Clock::now() - start).count());
+
+					software.Measure([&]() {
+						for (const auto& record : records) {
+							crc = Crc32c::ExtendSoftware(0, record.data);
+						}
+					});
+				}
+				checks.Expect(loaded.GetLoadStats().corrupt == 0 && loaded.Size() == original.Size(), kSuite,
+					"bulk load rejected intact records");
+
+				load.Report();
+				hardware.Report();
+				software.Report();
+				const auto share = 100.0 * Median(crcUs) / Median(loadUs);
+				std::printf("  checksum share of load%s: %.2f%% (%zu bytes, last crc %08X)\n", suffix.c_str(), share,
+					cosave.GetSize(), crc);
+				if (count == 100'000u && Crc32c::HasHardware()) {
+					checks.Expect(share < 1.0, kSuite, "checksum costs 1% or more of a 100k-entry load");
+				}
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,199 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Simulated World                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SimWorld.h"
+
+#include "SpellGems/Core/ConfigSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace SpellGems::Bench
+{
+	void SimForms::AddSpell(FormID spellId, std::uint8_t schoolMask)
+	{
+		spells_.insert_or_assign(spellId, schoolMask);
+	}
+
+	void SimForms::AddGem(FormID gemId, SpellTier tier)
+	{
+		gems_.insert_or_assign(gemId, tier);
+	}
+
+	bool SimForms::TryGetSpellSchools(FormID spellId, std::uint8_t& schoolMask) const
+	{
+		auto it = spells_.find(spellId);
+		if (it == spells_.end()) {
+			return false;
+		}
+
+		schoolMask = it->second;
+		return true;
+	}
+
+	bool SimForms::TryGetGemTier(FormID gemId, SpellTier& tier) const
+	{
+		auto it = gems_.find(gemId);
+		if (it == gems_.end()) {
+			return false;
+		}
+
+		tier = it->second;
+		return true;
+	}
+
+	void SimInventory::Add(FormID formId, std::int32_t count)
+	{
+		counts_[formId] += count;
+	}
+
+	void SimInventory::Remove(FormID formId, std::int32_t count)
+	{
+		counts_[formId] -= count;
+	}
+
+	std::int64_t SimInventory::GetCount(FormID formId) const
+	{
+		auto it = counts_.find(formId);
+		return it != counts_.end() ? it->second : 0;
+	}
+
+	bool SimCaster::Cast(const GemKey&, const StoredSpellData&)
+	{
+		++casts_;
+		return true;
+	}
+
+	std::uint64_t SimCaster::GetCastCount() const
+	{
+		return casts_;
+	}
+
+	float SimCalendar::GetCurrentGameTime() const
+	{
+		return gameDays_;
+	}
+
+	float SimCalendar::GetTimescale() const
+	{
+		return timescale_;
+	}
+
+	void SimCalendar::AdvanceSeconds(float seconds)
+	{
+		gameDays_ += seconds * timescale_ / (60.0f * 60.0f * 24.0f);
+	}
+
+	void MemoryCoSave::Clear()
+	{
+		buffer_.clear();
+		openHeader_ = kNoRecord;
+		dataCalls_ = 0;
+		Rewind();
+	}
+
+	void MemoryCoSave::Rewind()
+	{
+		readPos_ = 0;
+		recordEnd_ = 0;
+	}
+
+	std::size_t MemoryCoSave::GetSize() const
+	{
+		return buffer_.size();
+	}
+
+	const std::vector<std::uint8_t>& MemoryCoSave::GetBuffer() const
+	{
+		return buffer_;
+	}
+
+	std::uint64_t MemoryCoSave::GetDataCalls() const
+	{
+		return dataCalls_;
+	}
+
+	bool MemoryCoSave::OpenRecord(std::uint32_t type, std::uint32_t version)
+	{
+		const RecordHeader header{ type, version, 0 };
+		openHeader_ = buffer_.size();
+		buffer_.resize(buffer_.size() + sizeof(header));
+		std::memcpy(buffer_.data() + openHeader_, &header, sizeof(header));
+		return true;
+	}
+
+	bool MemoryCoSave::WriteRaw(const void* data, std::uint32_t length)
+	{
+		++dataCalls_;
+		if (openHeader_ == kNoRecord) {
+			return false;
+		}
+		if (length == 0) {
+			return true;
+		}
+
+		const auto offset = buffer_.size();
+		buffer_.resize(offset + length);
+		std::memcpy(buffer_.data() + offset, data, length);
+
+		RecordHeader header{};
+		std::memcpy(&header, buffer_.data() + openHeader_, sizeof(header));
+		header.length += length;
+		std::memcpy(buffer_.data() + openHeader_, &header, sizeof(header));
+		return true;
+	}
+
+	// Skips whatever the caller left unread in the current record, as SKSE does.
+	bool MemoryCoSave::GetNextRecordInfo(std::uint32_t& type, std::uint32_t& version, std::uint32_t& length)
+	{
+		readPos_ = std::max(readPos_, recordEnd_);
+		if (readPos_ + sizeof(RecordHeader) > buffer_.size()) {
+			return false;
+		}
+
+		RecordHeader header{};
+		std::memcpy(&header, buffer_.data() + readPos_, sizeof(header));
+		readPos_ += sizeof(header);
+		recordEnd_ = std::min(readPos_ + header.length, buffer_.size());
+		type = header.type;
+		version = header.version;
+		length = header.length;
+		return true;
+	}
+
+	std::uint32_t MemoryCoSave::ReadRaw(void* data, std::uint32_t length)
+	{
+		++dataCalls_;
+		const auto available = recordEnd_ > readPos_ ? recordEnd_ - readPos_ : 0;
+		const auto count = static_cast<std::uint32_t>(std::min<std::size_t>(length, available));
+		if (count == 0) {
+			return 0;
+		}
+		std::memcpy(data, buffer_.data() + readPos_, count);
+		readPos_ += count;
+		return count;
+	}
+
+	bool MemoryCoSave::ResolveFormID(FormID oldId, FormID& newId) const
+	{
+		newId = oldId;
+		return true;
+	}
+
+	SimWorld::SimWorld()
+	{
+		ConfigValues values{};
+		for (std::size_t i = 0; i < kTierCount; ++i) {
+			values.tiers[i] = { 0.0f, 5 };
+			values.fragmentCounts[i] = static_cast<std::uint32_t>(i + 1);
+		}
+		values.starCooldown = 3.0f;
+		values.fragmentFormId = 0x00067181;
+		rules = MakeGemRules(values);
+	}
+}
@@ -0,0 +1,112 @@
+// In-memory stand-ins for the game services the spell gem core talks to.
+#pragma once
+
+#include "SpellGems/Core/GemCore.h"
+#include "SpellGems/Core/GemStore.h"
+#include "SpellGems/Core/Interfaces.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	class SimForms : public IFormLookup
+	{
+	public:
+		void AddSpell(FormID spellId, std::uint8_t schoolMask = 0);
+		void AddGem(FormID gemId, SpellTier tier);
+
+		bool TryGetSpellSchools(FormID spellId, std::uint8_t& schoolMask) const override;
+		bool TryGetGemTier(FormID gemId, SpellTier& tier) const override;
+
+	private:
+		std::unordered_map<FormID, std::uint8_t> spells_;
+		std::unordered_map<FormID, SpellTier> gems_;
+	};
+
+	class SimInventory : public IInventory
+	{
+	public:
+		void Add(FormID formId, std::int32_t count) override;
+		void Remove(FormID formId, std::int32_t count) override;
+
+		std::int64_t GetCount(FormID formId) const;
+
+	private:
+		std::unordered_map<FormID, std::int64_t> counts_;
+	};
+
+	class SimCaster : public ICaster
+	{
+	public:
+		bool Cast(const GemKey& key, const StoredSpellData& data) override;
+
+		std::uint64_t GetCastCount() const;
+
+	private:
+		std::uint64_t casts_{};
+	};
+
+	class SimCalendar : public ICalendar
+	{
+	public:
+		float GetCurrentGameTime() const override;
+		float GetTimescale() const override;
+
+		void AdvanceSeconds(float seconds);
+
+	private:
+		float gameDays_{ 1.0f };
+		float timescale_{ 20.0f };
+	};
+
+	// SKSE-shaped co-save: a flat byte buffer of {type, version, length} headers followed by record data.
+	class MemoryCoSave : public ICoSaveWriter, public ICoSaveReader
+	{
+	public:
+		void Clear();
+		void Rewind();
+		std::size_t GetSize() const;
+		const std::vector<std::uint8_t>& GetBuffer() const;
+		// WriteRaw/ReadRaw calls since the last Clear, the per-call cost SKSE charges for record data.
+		std::uint64_t GetDataCalls() const;
+
+		bool OpenRecord(std::uint32_t type, std::uint32_t version) override;
+		bool WriteRaw(const void* data, std::uint32_t length) override;
+
+		bool GetNextRecordInfo(std::uint32_t& type, std::uint32_t& version, std::uint32_t& length) override;
+		std::uint32_t ReadRaw(void* data, std::uint32_t length) override;
+		bool ResolveFormID(FormID oldId, FormID& newId) const override;
+
+	private:
+		struct RecordHeader
+		{
+			std::uint32_t type;
+			std::uint32_t version;
+			std::uint32_t length;
+		};
+
+		std::vector<std::uint8_t> buffer_;
+		std::size_t openHeader_{ kNoRecord };
+		std::size_t readPos_{};
+		std::size_t recordEnd_{};
+		std::uint64_t dataCalls_{};
+
+		static constexpr std::size_t kNoRecord = static_cast<std::size_t>(-1);
+	};
+
+	// A store plus every stand-in, wired into a GemCore the same way the plugin wires the game.
+	struct SimWorld
+	{
+		SimWorld();
+
+		GemStore store;
+		SimForms forms;
+		SimInventory inventory;
+		SimCaster caster;
+		SimCalendar calendar;
+		GemCore core{ store, forms, inventory, caster, calendar };
+		GemRules rules{};
+	};
+}
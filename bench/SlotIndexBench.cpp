@@ -0,0 +1,81 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            Slot Index Benchmark                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "slot_index";
+		constexpr FormID kGemBase = 0x00100000;
+		constexpr FormID kSpell = 0x00200000;
+
+		// Hotkey activation against tables of growing size. Unlimited-use gems keep the table fixed so every
+		// sample is a pure lookup-and-cast; the rebuild-and-sort line is the pre-index behaviour for reference.
+		void Run(const Options& options)
+		{
+			auto& checks = Checks::Get();
+			for (const std::size_t live : { 16u, 256u, 4096u, 65536u }) {
+				SimWorld world;
+				world.forms.AddSpell(kSpell);
+				std::uint32_t rng = options.seed;
+				while (world.store.Size() < live) {
+					const GemKey key{ kGemBase + NextRandom(rng) % 1024, static_cast<std::uint16_t>(NextRandom(rng)) };
+					StoredSpellData data{};
+					data.spellId = kSpell;
+					data.usesRemaining = -1;
+					world.core.Store(key, data, false);
+				}
+
+				bool ordered = true;
+				for (std::size_t i = 1; i < world.store.GetSlotIndex().Size(); ++i) {
+					const auto& prev = *world.store.GetSlotIndex().At(i - 1);
+					const auto& next = *world.store.GetSlotIndex().At(i);
+					ordered &= prev.baseId < next.baseId || (prev.baseId == next.baseId && prev.uniqueId < next.uniqueId);
+				}
+				checks.Expect(ordered, kSuite, "slot index is not in activation order");
+
+				const auto suffix = " (" + std::to_string(live) + " gems)";
+				LatencyRecorder activate("activate" + suffix, options.cycles);
+				for (std::uint64_t i = 0; i < options.cycles; ++i) {
+					const auto slot = NextRandom(rng) % live;
+					const auto result = activate.Measure([&]() { return world.core.Activate(slot, world.rules); });
+					checks.Expect(result.status == ActivateStatus::Cast, kSuite, "activation did not cast");
+				}
+				activate.Report();
+
+				const auto rebuilds = std::max<std::uint64_t>(16, options.cycles / live);
+				LatencyRecorder rebuild("rebuild+sort" + suffix, rebuilds);
+				std::vector<GemKey> slots;
+				for (std::uint64_t i = 0; i < rebuilds; ++i) {
+					rebuild.Measure([&]() {
+						slots.clear();
+						for (const auto& [key, _] : world.store.GetEntries()) {
+							slots.push_back(key);
+						}
+						std::sort(slots.begin(), slots.end(), [](const GemKey& lhs, const GemKey& rhs) {
+							return lhs.baseId != rhs.baseId ? lhs.baseId < rhs.baseId : lhs.uniqueId < rhs.uniqueId;
+						});
+					});
+				}
+				rebuild.Report();
+				checks.Expect(slots.size() == live && slots.front() == *world.store.GetSlotIndex().At(0), kSuite,
+					"rebuilt slot list disagrees with the index");
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,168 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                             Snapshot Benchmark                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+#include "SimWorld.h"
+
+#include "SpellGems/Core/SnapshotEncoder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "snapshot";
+		constexpr FormID kGemBase = 0xFE000800;
+		constexpr auto kIdleTimeout = std::chrono::seconds(10);
+
+		void Fill(GemStore& store, std::size_t count, std::uint32_t& rng)
+		{
+			while (store.Size() < count) {
+				const GemKey key{ kGemBase + NextRandom(rng) % 512, store.AllocateUniqueId() };
+				StoredSpellData data{};
+				data.spellId = 0x00012FCD + NextRandom(rng) % 256;
+				data.tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+				data.usesRemaining = static_cast<std::int32_t>(NextRandom(rng) % 9) + 1;
+				store.Store(key, data);
+			}
+		}
+
+		// One gameplay step: spend a use, or drop the gem and store a fresh one.
+		void Mutate(GemStore& store, std::uint32_t& rng)
+		{
+			const auto& slots = store.GetSlotIndex();
+			const GemKey key = *slots.At(NextRandom(rng) % slots.Size());
+			auto data = *store.Get(key);
+			if (--data.usesRemaining > 0) {
+				store.Store(key, data);
+				return;
+			}
+			store.Remove(key);
+			data.usesRemaining = 5;
+			store.Store({ key.baseId, store.AllocateUniqueId() }, data);
+		}
+
+		std::vector<std::uint8_t> SaveBytes(const GemStore& store, const GemStore::Image* image)
+		{
+			MemoryCoSave cosave;
+			if (image) {
+				store.SaveImage(cosave, *image);
+			} else {
+				store.Save(cosave);
+			}
+			return cosave.GetBuffer();
+		}
+
+		// The image must be byte-identical to an inline save, and a stale one must be refused.
+		void CheckImages(std::uint32_t seed)
+		{
+			auto& checks = Checks::Get();
+			std::uint32_t rng = seed;
+			GemStore store;
+			Fill(store, 2'000, rng);
+
+			SnapshotEncoder encoder;
+			for (const auto encoding : { SpellRecordCodec::Encoding::Packed, SpellRecordCodec::Encoding::Compressed }) {
+				store.SetRecordEncoding(encoding);
+				encoder.Submit(store.CaptureSnapshot(), encoding);
+				checks.Expect(encoder.WaitIdle(kIdleTimeout), kSuite, "encoder did not go idle");
+				const auto image = encoder.GetLatest();
+				checks.Expect(image && store.IsCurrent(*image), kSuite, "fresh image was not current");
+				checks.Expect(image && SaveBytes(store, image.get()) == SaveBytes(store, nullptr), kSuite,
+					"image differs from an inline save");
+
+				Mutate(store, rng);
+				checks.Expect(image && !store.IsCurrent(*image), kSuite, "stale image was accepted");
+			}
+			store.SetRecordEncoding(SpellRecordCodec::Encoding::Packed);
+			const auto image = encoder.GetLatest();
+			checks.Expect(image && !store.IsCurrent(*image), kSuite, "image with another encoding was accepted");
+		}
+
+		// The game thread keeps mutating and submitting while the worker encodes; the last image must match.
+		void CheckConcurrent(std::uint32_t seed, std::uint64_t steps)
+		{
+			std::uint32_t rng = seed;
+			GemStore store;
+			Fill(store, 4'000, rng);
+			SnapshotEncoder encoder;
+			for (std::uint64_t i = 0; i < steps; ++i) {
+				Mutate(store, rng);
+				if (i % 64 == 0) {
+					encoder.Submit(store.CaptureSnapshot(), SpellRecordCodec::Encoding::Packed);
+				}
+			}
+			encoder.Submit(store.CaptureSnapshot(), SpellRecordCodec::Encoding::Packed);
+			const bool idle = encoder.WaitIdle(kIdleTimeout);
+			const auto image = encoder.GetLatest();
+			Checks::Get().Expect(idle && image && store.IsCurrent(*image) && SaveBytes(store, image.get()) == SaveBytes(store, nullptr),
+				kSuite, "final image does not match the store after concurrent churn");
+			const auto stats = encoder.GetStats();
+			std::printf("  churn: %llu submitted, %llu encoded, %llu superseded\n",
+				static_cast<unsigned long long>(stats.submitted), static_cast<unsigned long long>(stats.encoded),
+				static_cast<unsigned long long>(stats.superseded));
+		}
+
+		// What the save callback costs with inline encoding against handing over a pre-encoded image, and what the
+		// main thread pays per snapshot instead. The larger table sits near the 65535-ID ceiling.
+		void Run(const Options& options)
+		{
+			CheckImages(options.seed);
+			CheckConcurrent(options.seed, std::min<std::uint64_t>(options.cycles, 200'000));
+
+			auto& checks = Checks::Get();
+			SnapshotEncoder encoder;
+			for (const std::size_t count : { 10'000u, 60'000u }) {
+				for (const auto encoding : { SpellRecordCodec::Encoding::Packed, SpellRecordCodec::Encoding::Compressed }) {
+					std::uint32_t rng = options.seed ^ static_cast<std::uint32_t>(count);
+					GemStore store;
+					Fill(store, count, rng);
+					store.SetRecordEncoding(encoding);
+					const auto repeats = std::clamp<std::uint64_t>(options.cycles / count, 3, 100);
+					const auto label = std::string(encoding == SpellRecordCodec::Encoding::Packed ? " packed (" : " compressed (") +
+						std::to_string(count) + ")";
+
+					LatencyRecorder capture("capture" + label, repeats);
+					LatencyRecorder background("background encode" + label, repeats);
+					LatencyRecorder inlineSave("callback inline" + label, repeats);
+					LatencyRecorder imageSave("callback pre-encoded" + label, repeats);
+					MemoryCoSave cosave;
+					bool current = true;
+					for (std::uint64_t i = 0; i < repeats; ++i) {
+						Mutate(store, rng);
+						auto snapshot = capture.Measure([&]() { return store.CaptureSnapshot(); });
+						background.Measure([&]() {
+							encoder.Submit(std::move(snapshot), encoding);
+							return encoder.WaitIdle(kIdleTimeout);
+						});
+
+						cosave.Clear();
+						inlineSave.Measure([&]() { store.Save(cosave); });
+
+						cosave.Clear();
+						const auto image = encoder.GetLatest();
+						current &= image && store.IsCurrent(*image);
+						imageSave.Measure([&]() { store.SaveImage(cosave, *image); });
+					}
+					checks.Expect(current, kSuite, "pre-encoded image was not current at save time");
+
+					capture.Report();
+					background.Report();
+					inlineSave.Report();
+					imageSave.Report();
+				}
+			}
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,133 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                            Timer Wheel Benchmark                                            //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include "SpellGems/Core/TimerWheel.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace SpellGems::Bench
+{
+	namespace
+	{
+		constexpr const char* kSuite = "timer_wheel";
+
+		// What the scheduler does each frame: advance, then run and finish every expired timer with the wheel free
+		// for the callbacks to use.
+		std::size_t Step(TimerWheel& wheel, std::uint64_t ticks, std::vector<TimerWheel::Expired>& expired)
+		{
+			wheel.Advance(ticks, expired);
+			std::size_t fired = 0;
+			for (auto& timer : expired) {
+				if (wheel.IsArmed(timer.handle)) {
+					timer.callback();
+					++fired;
+				}
+				wheel.Finish(timer.handle, std::move(timer.callback));
+			}
+			expired.clear();
+			return fired;
+		}
+
+		// Advance only collects; callbacks that arm, cancel or fire later in the same batch behave as they would
+		// between frames.
+		void CheckDeferredFiring()
+		{
+			auto& checks = Checks::Get();
+			TimerWheel wheel;
+			std::vector<TimerWheel::Expired> expired;
+
+			int ran = 0;
+			wheel.Arm(5, [&]() { ++ran; });
+			wheel.Advance(10, expired);
+			checks.Expect(ran == 0 && expired.size() == 1, kSuite, "advance ran a callback instead of collecting it");
+			checks.Expect(wheel.IsArmed(expired.front().handle), kSuite, "collected timer was not cancellable");
+			expired.front().callback();
+			wheel.Finish(expired.front().handle, std::move(expired.front().callback));
+			expired.clear();
+			checks.Expect(ran == 1 && wheel.GetArmedCount() == 0, kSuite, "finished one-shot was not released");
+
+			// The first callback cancels the second, which expires on the same tick, and arms a follow-up.
+			TimerHandle second{};
+			TimerHandle followUp{};
+			int secondRan = 0;
+			int followUpRan = 0;
+			wheel.Arm(3, [&]() {
+				wheel.Cancel(second);
+				followUp = wheel.Arm(2, [&]() { ++followUpRan; });
+			});
+			second = wheel.Arm(3, [&]() { ++secondRan; });
+			const auto fired = Step(wheel, 3, expired);
+			checks.Expect(fired == 1 && secondRan == 0, kSuite, "timer cancelled earlier in the batch still fired");
+			checks.Expect(wheel.IsArmed(followUp) && !wheel.IsArmed(second), kSuite, "arm or cancel from a callback was lost");
+			Step(wheel, 2, expired);
+			checks.Expect(followUpRan == 1 && wheel.GetArmedCount() == 0, kSuite, "timer armed from a callback did not fire");
+
+			// A repeating timer fires once per batch, is re-armed by Finish and stops when cancelled from its callback.
+			int repeats = 0;
+			TimerHandle repeating{};
+			repeating = wheel.Arm(4, [&]() {
+				if (++repeats == 3) {
+					wheel.Cancel(repeating);
+				}
+			}, 4);
+			Step(wheel, 4, expired);
+			checks.Expect(repeats == 1 && wheel.IsArmed(repeating), kSuite, "repeating timer was not re-armed");
+			Step(wheel, 100, expired);
+			checks.Expect(repeats == 2, kSuite, "repeating timer fired more than once in one batch");
+			Step(wheel, 4, expired);
+			checks.Expect(repeats == 3 && !wheel.IsArmed(repeating) && wheel.GetArmedCount() == 0, kSuite,
+				"repeating timer cancelled from its callback was re-armed");
+
+			// Clear while a timer is out for running: its handle goes stale and Finish releases it.
+			wheel.Arm(1, []() {});
+			wheel.Advance(1, expired);
+			wheel.Clear();
+			checks.Expect(!wheel.IsArmed(expired.front().handle), kSuite, "cleared running timer still armed");
+			wheel.Finish(expired.front().handle, std::move(expired.front().callback));
+			expired.clear();
+			checks.Expect(wheel.GetArmedCount() == 0, kSuite, "cleared running timer was not released on finish");
+		}
+
+		// Frame-sized steps over a population of one-shot and repeating timers, re-arming every one-shot that fires.
+		void Run(const Options& options)
+		{
+			CheckDeferredFiring();
+
+			TimerWheel wheel;
+			std::vector<TimerWheel::Expired> expired;
+			std::uint32_t rng = options.seed;
+			std::uint64_t fired = 0;
+			std::vector<TimerHandle> oneShots;
+			for (int i = 0; i < 256; ++i) {
+				oneShots.push_back(wheel.Arm(1 + NextRandom(rng) % 5'000, [&fired]() { ++fired; }));
+			}
+			for (int i = 0; i < 16; ++i) {
+				wheel.Arm(250, [&fired]() { ++fired; }, 250);
+			}
+
+			const auto frames = std::clamp<std::uint64_t>(options.cycles / 10, 1'000, 100'000);
+			LatencyRecorder step("advance 16 ticks + fire (272 timers)", frames);
+			for (std::uint64_t frame = 0; frame < frames; ++frame) {
+				step.Measure([&]() { return Step(wheel, 16, expired); });
+				for (auto& handle : oneShots) {
+					if (!wheel.IsArmed(handle)) {
+						handle = wheel.Arm(1 + NextRandom(rng) % 5'000, [&fired]() { ++fired; });
+					}
+				}
+			}
+			Checks::Get().Expect(wheel.GetArmedCount() == oneShots.size() + 16 && fired > 0, kSuite,
+				"timer population drifted under churn");
+			step.Report();
+		}
+
+		const Registry::Registrar registrar{ kSuite, &Run };
+	}
+}
@@ -0,0 +1,67 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Headless Benchmarks                                            //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "BenchHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::printf("usage: SpellGemsBench [--cycles N] [--seed N] [--filter NAME] [--list]\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	using namespace SpellGems::Bench;
+
+	Options options{};
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--cycles" && hasValue) {
+			options.cycles = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "--seed" && hasValue) {
+			options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+		} else if (arg == "--filter" && hasValue) {
+			options.filter = argv[++i];
+		} else if (arg == "--list") {
+			for (const auto& suite : Registry::Suites()) {
+				std::printf("%s\n", suite.name);
+			}
+			return 0;
+		} else {
+			PrintUsage();
+			return 2;
+		}
+	}
+	if (options.cycles == 0 || options.seed == 0) {
+		PrintUsage();
+		return 2;
+	}
+
+	std::size_t ran = 0;
+	for (const auto& suite : Registry::Suites()) {
+		if (!options.filter.empty() && options.filter != suite.name) {
+			continue;
+		}
+
+		std::printf("[%s] %llu cycles\n", suite.name, static_cast<unsigned long long>(options.cycles));
+		suite.run(options);
+		++ran;
+	}
+
+	const auto failures = Checks::Get().GetFailures();
+	std::printf("%zu suite(s) run, %d check failure(s)\n", ran, failures);
+	return failures == 0 && ran > 0 ? 0 : 1;
+}
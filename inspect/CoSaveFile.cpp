@@ -0,0 +1,234 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                Co-Save File                                                 //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "CoSaveFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SpellGems::Inspect
+{
+	namespace
+	{
+		constexpr char kMagic[4] = { 'S', 'K', 'S', 'E' };
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const char* path, std::string& error)
+	{
+		Close();
+		const int fd = ::open(path, O_RDONLY);
+		if (fd < 0) {
+			error = std::string("cannot open: ") + std::strerror(errno);
+			return false;
+		}
+
+		struct stat info{};
+		if (::fstat(fd, &info) != 0) {
+			error = std::string("cannot stat: ") + std::strerror(errno);
+			::close(fd);
+			return false;
+		}
+
+		size_ = static_cast<std::size_t>(info.st_size);
+		if (size_ > 0) {
+			void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data == MAP_FAILED) {
+				error = std::string("cannot map: ") + std::strerror(errno);
+				size_ = 0;
+				::close(fd);
+				return false;
+			}
+			data_ = data;
+		}
+		// The mapping keeps its own reference to the file.
+		::close(fd);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (data_) {
+			::munmap(data_, size_);
+		}
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	std::span<const std::uint8_t> MappedFile::GetBytes() const
+	{
+		return { static_cast<const std::uint8_t*>(data_), size_ };
+	}
+
+	std::uint32_t GetU32(const std::uint8_t* in)
+	{
+		return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 8) |
+		       (static_cast<std::uint32_t>(in[2]) << 16) | (static_cast<std::uint32_t>(in[3]) << 24);
+	}
+
+	bool ParseCoSave(std::span<const std::uint8_t> bytes, CoSaveFile& out, std::string& error)
+	{
+		out = {};
+		if (bytes.size() < kFileHeaderSize || std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+			error = "not an SKSE co-save";
+			return false;
+		}
+
+		out.header.formatVersion = GetU32(bytes.data() + 4);
+		out.header.skseVersion = GetU32(bytes.data() + 8);
+		out.header.runtimeVersion = GetU32(bytes.data() + 12);
+		out.header.pluginCount = GetU32(bytes.data() + 16);
+
+		// A corrupt count must not size the allocation; every block needs at least its header.
+		out.plugins.reserve(std::min<std::size_t>(out.header.pluginCount, (bytes.size() - kFileHeaderSize) / kPluginHeaderSize));
+		std::size_t offset = kFileHeaderSize;
+		for (std::uint32_t i = 0; i < out.header.pluginCount; ++i) {
+			if (bytes.size() - offset < kPluginHeaderSize) {
+				out.truncated = true;
+				break;
+			}
+
+			PluginBlock block{};
+			block.uid = GetU32(bytes.data() + offset);
+			block.chunkCount = GetU32(bytes.data() + offset + 4);
+			const std::size_t length = GetU32(bytes.data() + offset + 8);
+			offset += kPluginHeaderSize;
+			if (bytes.size() - offset < length) {
+				block.data = bytes.subspan(offset);
+				out.plugins.push_back(block);
+				out.truncated = true;
+				break;
+			}
+
+			block.data = bytes.subspan(offset, length);
+			out.plugins.push_back(block);
+			offset += length;
+		}
+		return true;
+	}
+
+	std::vector<Chunk> ReadChunks(const PluginBlock& block, bool& truncated)
+	{
+		std::vector<Chunk> chunks;
+		const auto data = block.data;
+		std::size_t offset = 0;
+		for (std::uint32_t i = 0; i < block.chunkCount; ++i) {
+			if (data.size() - offset < kChunkHeaderSize) {
+				truncated = true;
+				break;
+			}
+
+			Chunk chunk{};
+			chunk.type = GetU32(data.data() + offset);
+			chunk.version = GetU32(data.data() + offset + 4);
+			const std::size_t length = GetU32(data.data() + offset + 8);
+			offset += kChunkHeaderSize;
+			if (data.size() - offset < length) {
+				chunk.data = data.subspan(offset);
+				chunks.push_back(chunk);
+				truncated = true;
+				break;
+			}
+
+			chunk.data = data.subspan(offset, length);
+			chunks.push_back(chunk);
+			offset += length;
+		}
+		return chunks;
+	}
+
+	CoSaveBuilder::CoSaveBuilder(const CoSaveHeader& header)
+	{
+		bytes_.resize(kFileHeaderSize);
+		std::memcpy(bytes_.data(), kMagic, sizeof(kMagic));
+		PutU32(4, header.formatVersion);
+		PutU32(8, header.skseVersion);
+		PutU32(12, header.runtimeVersion);
+	}
+
+	void CoSaveBuilder::BeginPlugin(std::uint32_t uid)
+	{
+		ClosePlugin();
+		pluginHeader_ = bytes_.size();
+		bytes_.resize(bytes_.size() + kPluginHeaderSize);
+		PutU32(pluginHeader_, uid);
+		chunkCount_ = 0;
+		++pluginCount_;
+	}
+
+	bool CoSaveBuilder::OpenRecord(std::uint32_t type, std::uint32_t version)
+	{
+		if (pluginHeader_ == kNone) {
+			return false;
+		}
+
+		CloseChunk();
+		chunkHeader_ = bytes_.size();
+		bytes_.resize(bytes_.size() + kChunkHeaderSize);
+		PutU32(chunkHeader_, type);
+		PutU32(chunkHeader_ + 4, version);
+		++chunkCount_;
+		return true;
+	}
+
+	bool CoSaveBuilder::WriteRaw(const void* data, std::uint32_t length)
+	{
+		if (chunkHeader_ == kNone) {
+			return false;
+		}
+
+		const auto offset = bytes_.size();
+		bytes_.resize(offset + length);
+		if (length > 0) {
+			std::memcpy(bytes_.data() + offset, data, length);
+		}
+		return true;
+	}
+
+	std::vector<std::uint8_t> CoSaveBuilder::Finish()
+	{
+		ClosePlugin();
+		PutU32(16, pluginCount_);
+		return std::move(bytes_);
+	}
+
+	void CoSaveBuilder::PutU32(std::size_t offset, std::uint32_t value)
+	{
+		for (std::size_t i = 0; i < 4; ++i) {
+			bytes_[offset + i] = static_cast<std::uint8_t>(value >> (i * 8));
+		}
+	}
+
+	void CoSaveBuilder::CloseChunk()
+	{
+		if (chunkHeader_ != kNone) {
+			PutU32(chunkHeader_ + 8, static_cast<std::uint32_t>(bytes_.size() - chunkHeader_ - kChunkHeaderSize));
+			chunkHeader_ = kNone;
+		}
+	}
+
+	void CoSaveBuilder::ClosePlugin()
+	{
+		CloseChunk();
+		if (pluginHeader_ != kNone) {
+			PutU32(pluginHeader_ + 4, chunkCount_);
+			PutU32(pluginHeader_ + 8, static_cast<std::uint32_t>(bytes_.size() - pluginHeader_ - kPluginHeaderSize));
+			pluginHeader_ = kNone;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+// SKSE co-save container: a read-only file mapping, a single-pass block parser and a writer for sample files.
+#pragma once
+
+#include "SpellGems/Core/Interfaces.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SpellGems::Inspect
+{
+	// File header ('SKSE' magic, format, SKSE and runtime versions, plugin count), then per plugin a header (unique
+	// ID, chunk count, byte length) and its chunks, each a header (type, version, length) followed by the data. All
+	// fields are little-endian u32.
+	inline constexpr std::size_t kFileHeaderSize = 20;
+	inline constexpr std::size_t kPluginHeaderSize = 12;
+	inline constexpr std::size_t kChunkHeaderSize = 12;
+
+	struct CoSaveHeader
+	{
+		std::uint32_t formatVersion{};
+		std::uint32_t skseVersion{};
+		std::uint32_t runtimeVersion{};
+		std::uint32_t pluginCount{};
+	};
+
+	struct PluginBlock
+	{
+		std::uint32_t uid{};
+		std::uint32_t chunkCount{};
+		std::span<const std::uint8_t> data;
+	};
+
+	struct Chunk
+	{
+		std::uint32_t type{};
+		std::uint32_t version{};
+		std::span<const std::uint8_t> data;
+	};
+
+	struct CoSaveFile
+	{
+		CoSaveHeader header;
+		std::vector<PluginBlock> plugins;
+		// Set when the plugin list ends before the header's count or a block runs past the end of the file.
+		bool truncated{};
+	};
+
+	// Read-only mapping of a whole file; the pages are only touched when read.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const char* path, std::string& error);
+		void Close();
+		std::span<const std::uint8_t> GetBytes() const;
+
+	private:
+		void* data_{};
+		std::size_t size_{};
+	};
+
+	std::uint32_t GetU32(const std::uint8_t* in);
+
+	// Walks the plugin headers only, jumping over each block's data, so the cost is per plugin rather than per byte.
+	bool ParseCoSave(std::span<const std::uint8_t> bytes, CoSaveFile& out, std::string& error);
+
+	// Chunks of one block, in file order. Sets truncated when a chunk runs past the block.
+	std::vector<Chunk> ReadChunks(const PluginBlock& block, bool& truncated);
+
+	// Builds a co-save in memory. Records opened through the ICoSaveWriter interface go to the current plugin.
+	class CoSaveBuilder : public ICoSaveWriter
+	{
+	public:
+		explicit CoSaveBuilder(const CoSaveHeader& header);
+
+		void BeginPlugin(std::uint32_t uid);
+		bool OpenRecord(std::uint32_t type, std::uint32_t version) override;
+		bool WriteRaw(const void* data, std::uint32_t length) override;
+		std::vector<std::uint8_t> Finish();
+
+	private:
+		void PutU32(std::size_t offset, std::uint32_t value);
+		void CloseChunk();
+		void ClosePlugin();
+
+		static constexpr std::size_t kNone = ~std::size_t{ 0 };
+
+		std::vector<std::uint8_t> bytes_;
+		std::size_t pluginHeader_{ kNone };
+		std::size_t chunkHeader_{ kNone };
+		std::uint32_t pluginCount_{};
+		std::uint32_t chunkCount_{};
+	};
+}
@@ -0,0 +1,388 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Gem Record Check                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "GemRecordCheck.h"
+
+#include "SpellGems/Core/GemIdAllocator.h"
+#include "SpellGems/Core/GemStore.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace SpellGems::Inspect
+{
+	namespace
+	{
+		constexpr std::uint32_t kRecordPluginList = 'PLGN';
+		constexpr std::uint32_t kRecordModList = 'MODS';
+		constexpr std::uint32_t kRecordLightModList = 'LMOD';
+		constexpr std::size_t kMaxSamples = 8;
+
+		std::string FourCC(std::uint32_t value)
+		{
+			std::string text;
+			for (int shift = 24; shift >= 0; shift -= 8) {
+				const auto c = static_cast<char>(value >> shift);
+				text.push_back(c >= 0x20 && c < 0x7F ? c : '?');
+			}
+			return text;
+		}
+
+		// Feeds the plugin's chunks to GemStore::LoadRecord the way SKSE's serialization interface would.
+		class ChunkReader : public ICoSaveReader
+		{
+		public:
+			ChunkReader(const std::vector<Chunk>& chunks, const PluginList& plugins) :
+				chunks_(chunks),
+				plugins_(plugins)
+			{}
+
+			bool GetNextRecordInfo(std::uint32_t& type, std::uint32_t& version, std::uint32_t& length) override
+			{
+				if (next_ >= chunks_.size()) {
+					return false;
+				}
+				current_ = &chunks_[next_++];
+				position_ = 0;
+				type = current_->type;
+				version = current_->version;
+				length = static_cast<std::uint32_t>(current_->data.size());
+				return true;
+			}
+
+			std::uint32_t ReadRaw(void* data, std::uint32_t length) override
+			{
+				if (!current_) {
+					return 0;
+				}
+				const auto count = std::min<std::size_t>(length, current_->data.size() - position_);
+				std::copy_n(current_->data.data() + position_, count, static_cast<std::uint8_t*>(data));
+				position_ += count;
+				return static_cast<std::uint32_t>(count);
+			}
+
+			bool ResolveFormID(FormID oldId, FormID& newId) const override
+			{
+				newId = oldId;
+				return plugins_.Contains(oldId);
+			}
+
+		private:
+			const std::vector<Chunk>& chunks_;
+			const PluginList& plugins_;
+			const Chunk* current_{};
+			std::size_t next_{};
+			std::size_t position_{};
+		};
+
+		// Strips the trailer the way the load path does and notes a record that fails it.
+		std::span<const std::uint8_t> CheckTrailer(const Chunk& chunk, Report& report, bool& intact)
+		{
+			std::span<const std::uint8_t> body;
+			intact = GemStore::CheckRecord(chunk.data, chunk.version, body);
+			if (!intact) {
+				++report.corruptRecords;
+				report.problems.push_back(FourCC(chunk.type) + " record fails its checksum; the plugin will salvage it");
+			}
+			return body;
+		}
+
+		void CheckSpells(const Chunk& chunk, const PluginList& plugins, Report& report)
+		{
+			report.hasSpells = true;
+			report.spellVersion = chunk.version;
+			bool intact = true;
+			const auto body = CheckTrailer(chunk, report, intact);
+			if (body.size() >= 4) {
+				report.declared = GetU32(body.data());
+			}
+			if (chunk.version >= 5 && body.size() > 4) {
+				report.encoding = body[4];
+			}
+
+			std::vector<SpellRecordCodec::Entry> decoded;
+			report.decoded = GemStore::DecodeSpells(body, chunk.version, decoded);
+			if (!intact) {
+				report.salvageDropped = GemStore::SalvageEntries(decoded);
+			}
+			if (report.decoded < report.declared) {
+				report.problems.push_back("spell record declares " + std::to_string(report.declared) + " entries but only " +
+					std::to_string(report.decoded) + " decode");
+			}
+
+			// One sort answers both questions: equal keys are duplicates, equal unique IDs across bases collide.
+			std::vector<GemKey> keys;
+			keys.reserve(decoded.size());
+			for (const auto& [key, data] : decoded) {
+				keys.push_back(key);
+				report.zeroUniqueIds += key.uniqueId == 0 ? 1 : 0;
+				for (const auto formId : { key.baseId, data.spellId }) {
+					if (!plugins.Contains(formId)) {
+						(formId == key.baseId ? report.unresolvedGems : report.unresolvedSpells) += 1;
+						if (report.unresolvedSamples.size() < kMaxSamples) {
+							report.unresolvedSamples.push_back(formId);
+						}
+					}
+				}
+			}
+			std::sort(keys.begin(), keys.end(), [](const GemKey& lhs, const GemKey& rhs) {
+				return lhs.uniqueId != rhs.uniqueId ? lhs.uniqueId < rhs.uniqueId : lhs.baseId < rhs.baseId;
+			});
+			for (std::size_t i = 1; i < keys.size(); ++i) {
+				if (keys[i] == keys[i - 1]) {
+					++report.duplicateKeys;
+				} else if (keys[i].uniqueId == keys[i - 1].uniqueId && keys[i].uniqueId != 0 &&
+						   (i < 2 || keys[i - 1].uniqueId != keys[i - 2].uniqueId)) {
+					++report.sharedUniqueIds;
+				}
+			}
+
+			if (report.duplicateKeys > 0) {
+				report.problems.push_back(std::to_string(report.duplicateKeys) + " duplicate gem keys");
+			}
+			if (report.unresolvedGems + report.unresolvedSpells > 0) {
+				report.problems.push_back(std::to_string(report.unresolvedGems) + " gem and " +
+					std::to_string(report.unresolvedSpells) + " spell form IDs from plugins missing at save time");
+			}
+		}
+
+		void CheckState(const Chunk& chunk, Report& report)
+		{
+			report.hasState = true;
+			report.stateVersion = chunk.version;
+			bool intact = true;
+			const auto body = CheckTrailer(chunk, report, intact);
+			auto ids = std::make_unique<GemIdAllocator>();
+			report.stateValid = intact && GemStore::DecodeState(body, chunk.version, *ids);
+			report.cursor = ids->GetCursor();
+			report.reservedIds = ids->GetUsedCount() - 1;
+			if (intact && !report.stateValid) {
+				report.problems.push_back("state record does not decode");
+			}
+		}
+	}
+
+	void PluginList::Parse(const CoSaveFile& file)
+	{
+		*this = {};
+		for (const auto& block : file.plugins) {
+			if (block.uid == kPluginId) {
+				continue;
+			}
+
+			bool truncated = false;
+			for (const auto& chunk : ReadChunks(block, truncated)) {
+				switch (chunk.type) {
+				case kRecordPluginList:
+					ParsePlgn(chunk.data);
+					break;
+				case kRecordModList:
+					ParseNames(chunk.data, 1, false);
+					break;
+				case kRecordLightModList:
+					ParseNames(chunk.data, 2, true);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+	}
+
+	bool PluginList::IsKnown() const
+	{
+		return known_;
+	}
+
+	std::size_t PluginList::GetCount() const
+	{
+		return full_.count() + light_.count();
+	}
+
+	// Runtime-created forms (index 0xFF) always resolve, as they do in game.
+	bool PluginList::Contains(FormID formId) const
+	{
+		if (!known_) {
+			return true;
+		}
+
+		const auto index = formId >> 24;
+		if (index == 0xFF) {
+			return true;
+		}
+		if (index == 0xFE) {
+			return light_.test((formId >> 12) & 0xFFF);
+		}
+		return full_.test(index);
+	}
+
+	// u16 count, then per plugin a u8 load index, a u16 light index when that is 0xFE, and a u16-length name.
+	void PluginList::ParsePlgn(std::span<const std::uint8_t> data)
+	{
+		if (data.size() < 2) {
+			return;
+		}
+
+		known_ = true;
+		const std::size_t count = data[0] | (data[1] << 8);
+		std::size_t offset = 2;
+		for (std::size_t i = 0; i < count && offset < data.size(); ++i) {
+			const auto index = data[offset++];
+			if (index == 0xFE) {
+				if (data.size() - offset < 2) {
+					return;
+				}
+				light_.set((data[offset] | (data[offset + 1] << 8)) & 0xFFF);
+				offset += 2;
+			} else {
+				full_.set(index);
+			}
+			if (data.size() - offset < 2) {
+				return;
+			}
+			offset += 2 + static_cast<std::size_t>(data[offset] | (data[offset + 1] << 8));
+		}
+	}
+
+	// Older records: a count, then u16-length names whose position is the load index.
+	void PluginList::ParseNames(std::span<const std::uint8_t> data, std::size_t countSize, bool light)
+	{
+		if (data.size() < countSize) {
+			return;
+		}
+
+		known_ = true;
+		const std::size_t count = countSize == 1 ? data[0] : static_cast<std::size_t>(data[0] | (data[1] << 8));
+		std::size_t offset = countSize;
+		for (std::size_t i = 0; i < count && data.size() - offset >= 2; ++i) {
+			if (light) {
+				light_.set(i & 0xFFF);
+			} else {
+				full_.set(i & 0xFF);
+			}
+			offset += 2 + static_cast<std::size_t>(data[offset] | (data[offset + 1] << 8));
+			offset = std::min(offset, data.size());
+		}
+	}
+
+	Report Check(std::span<const std::uint8_t> bytes)
+	{
+		Report report{};
+		report.fileBytes = bytes.size();
+
+		CoSaveFile file;
+		std::string error;
+		if (!ParseCoSave(bytes, file, error)) {
+			report.problems.push_back(error);
+			return report;
+		}
+		report.header = file.header;
+		report.pluginBlocks = file.plugins.size();
+		report.truncated = file.truncated;
+		if (file.truncated) {
+			report.problems.push_back("plugin list is truncated");
+		}
+
+		PluginList plugins;
+		plugins.Parse(file);
+		report.pluginListKnown = plugins.IsKnown();
+		report.pluginListCount = plugins.GetCount();
+
+		const auto block = std::find_if(file.plugins.begin(), file.plugins.end(),
+			[](const PluginBlock& candidate) { return candidate.uid == kPluginId; });
+		if (block == file.plugins.end()) {
+			report.problems.push_back("no Spell Gems data in this co-save");
+			return report;
+		}
+
+		report.foundPlugin = true;
+		bool truncated = false;
+		report.chunks = ReadChunks(*block, truncated);
+		if (truncated) {
+			report.problems.push_back("Spell Gems block is truncated");
+		}
+		const Chunk* state = nullptr;
+		for (const auto& chunk : report.chunks) {
+			if (chunk.type == GemStore::kRecordSpells) {
+				CheckSpells(chunk, plugins, report);
+			} else if (chunk.type == GemStore::kRecordState) {
+				CheckState(chunk, report);
+				state = &chunk;
+			}
+		}
+
+		// The plugin's own load path, as the game would run it.
+		auto store = std::make_unique<GemStore>();
+		ChunkReader reader{ report.chunks, plugins };
+		std::uint32_t type = 0;
+		std::uint32_t version = 0;
+		std::uint32_t length = 0;
+		while (reader.GetNextRecordInfo(type, version, length)) {
+			store->LoadRecord(reader, type, version, length);
+		}
+		report.loaded = store->Size();
+
+		// A v6 bitmap must cover every live gem, or the next allocation could hand out a held ID.
+		if (state && report.stateValid && report.stateVersion >= 6) {
+			std::span<const std::uint8_t> body;
+			GemStore::CheckRecord(state->data, state->version, body);
+			auto saved = std::make_unique<GemIdAllocator>();
+			GemStore::DecodeState(body, state->version, *saved);
+			for (const auto& [key, _] : store->GetEntries()) {
+				report.liveIdsNotReserved += key.uniqueId != 0 && !saved->IsUsed(key.uniqueId) ? 1 : 0;
+			}
+			if (report.liveIdsNotReserved > 0) {
+				report.problems.push_back(std::to_string(report.liveIdsNotReserved) +
+					" stored gems hold unique IDs the saved allocator marks free");
+			}
+		}
+		return report;
+	}
+
+	void Print(const Report& report, std::FILE* out)
+	{
+		std::fprintf(out, "  file: %zu bytes, co-save format %u, SKSE %08X, runtime %08X, %zu plugin block(s)\n",
+			report.fileBytes, report.header.formatVersion, report.header.skseVersion, report.header.runtimeVersion,
+			report.pluginBlocks);
+		if (report.pluginListKnown) {
+			std::fprintf(out, "  save-time plugins: %zu\n", report.pluginListCount);
+		} else {
+			std::fprintf(out, "  save-time plugins: no plugin list record, form IDs not checked\n");
+		}
+
+		for (const auto& chunk : report.chunks) {
+			std::fprintf(out, "  record %s v%u: %zu bytes\n", FourCC(chunk.type).c_str(), chunk.version, chunk.data.size());
+		}
+		if (report.hasSpells) {
+			std::fprintf(out, "  spells: %zu of %u decoded (%s), %zu loaded, %zu duplicate keys, %zu shared unique IDs, %zu without unique ID\n",
+				report.decoded, report.declared,
+				report.encoding < 0 ? "fixed-width" : report.encoding == 0 ? "packed" : report.encoding == 1 ? "compressed" : "unknown encoding",
+				report.loaded, report.duplicateKeys, report.sharedUniqueIds, report.zeroUniqueIds);
+			if (report.corruptRecords > 0) {
+				std::fprintf(out, "  salvage: %zu implausible entries dropped\n", report.salvageDropped);
+			}
+			if (report.unresolvedGems + report.unresolvedSpells > 0) {
+				std::fprintf(out, "  unresolved: %zu gem forms, %zu spell forms, e.g.", report.unresolvedGems, report.unresolvedSpells);
+				for (const auto formId : report.unresolvedSamples) {
+					std::fprintf(out, " %08X", formId);
+				}
+				std::fprintf(out, "\n");
+			}
+		}
+		if (report.hasState && report.stateVersion >= 6) {
+			std::fprintf(out, "  state: v%u, next-fit cursor %u, %zu unique IDs reserved\n", report.stateVersion, report.cursor,
+				report.reservedIds);
+		} else if (report.hasState) {
+			std::fprintf(out, "  state: v%u, next unique ID %u\n", report.stateVersion, report.cursor);
+		}
+
+		for (const auto& problem : report.problems) {
+			std::fprintf(out, "  PROBLEM: %s\n", problem.c_str());
+		}
+	}
+}
@@ -0,0 +1,80 @@
+// Decodes and validates the Spell Gems records of a parsed co-save with the plugin's own record code.
+#pragma once
+
+#include "CoSaveFile.h"
+
+#include "SpellGems/Core/GemTypes.h"
+
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SpellGems::Inspect
+{
+	inline constexpr std::uint32_t kPluginId = 'SGEM';
+
+	// Which plugin slots existed when the game was saved, from SKSE's own plugin list records ('PLGN', or the
+	// older 'MODS'/'LMOD' pair). Without a fresh load order to remap against, a form ID counts as resolvable when
+	// its slot was occupied at save time.
+	class PluginList
+	{
+	public:
+		void Parse(const CoSaveFile& file);
+
+		bool IsKnown() const;
+		std::size_t GetCount() const;
+		bool Contains(FormID formId) const;
+
+	private:
+		void ParsePlgn(std::span<const std::uint8_t> data);
+		void ParseNames(std::span<const std::uint8_t> data, std::size_t countSize, bool light);
+
+		std::bitset<256> full_;
+		std::bitset<4096> light_;
+		bool known_{};
+	};
+
+	struct Report
+	{
+		std::size_t fileBytes{};
+		CoSaveHeader header;
+		std::size_t pluginBlocks{};
+		bool truncated{};
+		bool pluginListKnown{};
+		std::size_t pluginListCount{};
+
+		bool foundPlugin{};
+		std::vector<Chunk> chunks;
+		std::size_t corruptRecords{};
+		std::size_t salvageDropped{};
+
+		bool hasSpells{};
+		std::uint32_t spellVersion{};
+		int encoding{ -1 };
+		std::uint32_t declared{};
+		std::size_t decoded{};
+		std::size_t duplicateKeys{};
+		std::size_t sharedUniqueIds{};
+		std::size_t zeroUniqueIds{};
+		std::size_t unresolvedGems{};
+		std::size_t unresolvedSpells{};
+		std::vector<FormID> unresolvedSamples;
+
+		bool hasState{};
+		std::uint32_t stateVersion{};
+		bool stateValid{};
+		std::uint16_t cursor{};
+		std::size_t reservedIds{};
+		std::size_t liveIdsNotReserved{};
+
+		// Entries left after GemStore::LoadRecord, which drops duplicates and unresolved forms.
+		std::size_t loaded{};
+
+		std::vector<std::string> problems;
+	};
+
+	Report Check(std::span<const std::uint8_t> bytes);
+	void Print(const Report& report, std::FILE* out);
+}
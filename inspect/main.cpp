@@ -0,0 +1,196 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Co-Save Inspector                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "CoSaveFile.h"
+#include "GemRecordCheck.h"
+
+#include "SpellGems/Core/GemStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	using namespace SpellGems;
+	using namespace SpellGems::Inspect;
+	using Clock = std::chrono::steady_clock;
+
+	struct Options
+	{
+		const char* path{};
+		std::uint64_t repeat{ 1 };
+		bool generate{};
+		std::size_t entries{ 10'000 };
+		std::size_t paddingMb{};
+		std::size_t unresolved{};
+		bool compressed{};
+		std::uint32_t seed{ 0x5EED5EED };
+	};
+
+	void PrintUsage()
+	{
+		std::printf("usage: SpellGemsInspect FILE [--repeat N]\n"
+					"       SpellGemsInspect --generate FILE [--entries N] [--padding-mb N] [--unresolved N] [--compressed] [--seed N]\n");
+	}
+
+	std::uint32_t NextRandom(std::uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// A save-time plugin list of four full and two light plugins in SKSE's 'PLGN' layout.
+	void WritePluginList(CoSaveBuilder& builder)
+	{
+		std::vector<std::uint8_t> body{ 6, 0 };
+		const auto name = [&body](std::string_view text) {
+			body.push_back(static_cast<std::uint8_t>(text.size()));
+			body.push_back(static_cast<std::uint8_t>(text.size() >> 8));
+			body.insert(body.end(), text.begin(), text.end());
+		};
+		for (std::uint8_t index = 0; index < 4; ++index) {
+			body.push_back(index);
+			name("Sample" + std::to_string(index) + ".esm");
+		}
+		for (std::uint8_t light = 0; light < 2; ++light) {
+			body.insert(body.end(), { 0xFE, light, 0 });
+			name("SampleLight" + std::to_string(light) + ".esl");
+		}
+		builder.OpenRecord('PLGN', 0);
+		builder.WriteRaw(body.data(), static_cast<std::uint32_t>(body.size()));
+	}
+
+	// Other plugins' data sits between the header and the Spell Gems block, as it does in a real co-save.
+	int Generate(const Options& options)
+	{
+		CoSaveBuilder builder{ { 2, 0x02020060, 0x01060470, 0 } };
+		builder.BeginPlugin(0);
+		WritePluginList(builder);
+
+		const std::vector<std::uint8_t> filler(1 << 20);
+		for (std::size_t i = 0; i < options.paddingMb; ++i) {
+			builder.BeginPlugin('FILL');
+			builder.OpenRecord('DATA', 1);
+			builder.WriteRaw(filler.data(), static_cast<std::uint32_t>(filler.size()));
+		}
+
+		constexpr FormID kGemBases[] = { 0x02000800, 0x03001000, 0xFE001800, 0xFF000A00 };
+		auto store = std::make_unique<GemStore>();
+		store->SetRecordEncoding(options.compressed ? SpellRecordCodec::Encoding::Compressed : SpellRecordCodec::Encoding::Packed);
+		std::uint32_t rng = options.seed;
+		while (store->Size() < options.entries) {
+			const auto uniqueId = store->AllocateUniqueId();
+			if (uniqueId == 0) {
+				std::printf("  stopped at %zu entries: unique IDs exhausted\n", store->Size());
+				break;
+			}
+			const bool stale = store->Size() < options.unresolved;
+			StoredSpellData data{};
+			data.spellId = (stale ? 0x40000000 : (NextRandom(rng) % 2) << 24) | (0x00012000 + NextRandom(rng) % 0x1000);
+			data.tier = static_cast<SpellTier>(NextRandom(rng) % kTierCount);
+			data.usesRemaining = NextRandom(rng) % 8 == 0 ? -1 : static_cast<std::int32_t>(NextRandom(rng) % 10 + 1);
+			data.isBlackSoulGem = NextRandom(rng) % 16 == 0;
+			store->Store({ kGemBases[NextRandom(rng) % std::size(kGemBases)] + NextRandom(rng) % 64, uniqueId }, data);
+		}
+		builder.BeginPlugin(kPluginId);
+		store->Save(builder);
+
+		const auto bytes = builder.Finish();
+		std::FILE* file = std::fopen(options.path, "wb");
+		if (!file) {
+			std::printf("cannot create %s\n", options.path);
+			return 2;
+		}
+		bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+		written &= std::fclose(file) == 0;
+		if (!written) {
+			std::printf("cannot write %s\n", options.path);
+			return 2;
+		}
+		std::printf("wrote %s: %zu bytes, %zu entries\n", options.path, bytes.size(), store->Size());
+		return 0;
+	}
+
+	// Maps the file once, then checks it repeat times; the first pass pays the page faults.
+	int InspectFile(const Options& options)
+	{
+		const auto mapStart = Clock::now();
+		MappedFile file;
+		std::string error;
+		if (!file.Open(options.path, error)) {
+			std::printf("%s: %s\n", options.path, error.c_str());
+			return 2;
+		}
+		const auto mapUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - mapStart).count();
+
+		Report report;
+		std::vector<double> passUs;
+		passUs.reserve(options.repeat);
+		for (std::uint64_t i = 0; i < options.repeat; ++i) {
+			const auto start = Clock::now();
+			report = Check(file.GetBytes());
+			passUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+		}
+
+		std::printf("%s\n", options.path);
+		Print(report, stdout);
+		std::printf("  timing: map %lld us, first pass %.0f us", static_cast<long long>(mapUs), passUs.front());
+		if (passUs.size() > 1) {
+			std::sort(passUs.begin(), passUs.end());
+			const auto median = passUs[passUs.size() / 2];
+			std::printf(", median of %zu %.0f us (%.0f MB/s file, %.1f M entries/s decoded)", passUs.size(), median,
+				static_cast<double>(report.fileBytes) / median, static_cast<double>(report.decoded) / median);
+		}
+		std::printf("\n");
+		return report.problems.empty() ? 0 : 1;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options{};
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--generate" && hasValue) {
+			options.generate = true;
+			options.path = argv[++i];
+		} else if (arg == "--repeat" && hasValue) {
+			options.repeat = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "--entries" && hasValue) {
+			options.entries = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "--padding-mb" && hasValue) {
+			options.paddingMb = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "--unresolved" && hasValue) {
+			options.unresolved = std::strtoull(argv[++i], nullptr, 10);
+		} else if (arg == "--compressed") {
+			options.compressed = true;
+		} else if (arg == "--seed" && hasValue) {
+			options.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+		} else if (!options.path && !arg.starts_with("--")) {
+			options.path = argv[i];
+		} else {
+			PrintUsage();
+			return 2;
+		}
+	}
+	if (!options.path || options.repeat == 0 || options.seed == 0) {
+		PrintUsage();
+		return 2;
+	}
+
+	return options.generate ? Generate(options) : InspectFile(options);
+}
@@ -0,0 +1,55 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                  Cast Plans                                                 //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/CastPlan.h"
+
+#include "SpellGems/Config.h"
+#include "SpellGems/SpellProfileCache.h"
+
+namespace SpellGems
+{
+	namespace
+	{
+		const RE::BSFixedString& GetCastAnimationEvent(bool isConcentration)
+		{
+			static const RE::BSFixedString focusEvent{ "MT_BreathExhaleShort" };
+			static const RE::BSFixedString releaseEvent{ "ShoutStart" };
+			return isConcentration ? focusEvent : releaseEvent;
+		}
+	}
+
+	// Resolves gem bonuses, targeting and animation for a stored spell against the current config.
+	CastPlan CastPlan::Build(const RE::SpellItem& spell, const StoredSpellData& data)
+	{
+		const auto snapshot = Config::GetSingleton().GetSnapshot();
+		const auto& profile = SpellProfileCache::GetSingleton().Get(spell);
+		const auto& outcome = snapshot->rules.outcomes.Find(data.spellId, data.tier, profile.schoolMask,
+			GetGemClass(data.isReusableStar, data.isBlackSoulGem));
+
+		CastPlan plan{};
+		plan.spellId = data.spellId;
+		plan.configGeneration = snapshot->generation;
+		plan.tier = data.tier;
+		plan.isBlackSoulGem = data.isBlackSoulGem;
+		plan.isReusableStar = data.isReusableStar;
+		plan.isConcentration = profile.castingType == RE::MagicSystem::CastingType::kConcentration;
+		plan.targetSelf = profile.delivery == RE::MagicSystem::Delivery::kSelf;
+		plan.animationEvent = &GetCastAnimationEvent(plan.isConcentration);
+		plan.effectiveness = outcome.effectiveness;
+		plan.magnitudeOverride = outcome.magnitudeOverride;
+		plan.healthCostFraction = outcome.healthCostFraction;
+		return plan;
+	}
+
+	// True while the plan still describes the stored entry and no config change has invalidated it.
+	bool CastPlan::IsCurrent(const StoredSpellData& data) const
+	{
+		return animationEvent && spellId == data.spellId && tier == data.tier && isBlackSoulGem == data.isBlackSoulGem &&
+			isReusableStar == data.isReusableStar && configGeneration == Config::GetSingleton().GetGeneration();
+	}
+}
@@ -0,0 +1,30 @@
+// Cast parameters resolved once per stored gem so activation does no config or effect inspection.
+#pragma once
+
+#include "SpellGems/Serialization.h"
+
+#include <cstdint>
+
+#include "RE/B/BSFixedString.h"
+#include "RE/S/SpellItem.h"
+
+namespace SpellGems
+{
+	struct CastPlan
+	{
+		const RE::BSFixedString* animationEvent{};
+		float effectiveness{ 1.0f };
+		float magnitudeOverride{ 0.0f };
+		float healthCostFraction{ 0.0f };
+		RE::FormID spellId{};
+		std::uint32_t configGeneration{};
+		SpellTier tier{};
+		bool targetSelf{};
+		bool isConcentration{};
+		bool isBlackSoulGem{};
+		bool isReusableStar{};
+
+		static CastPlan Build(const RE::SpellItem& spell, const StoredSpellData& data);
+		bool IsCurrent(const StoredSpellData& data) const;
+	};
+}
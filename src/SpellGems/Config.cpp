@@ -8,11 +8,13 @@
 
 #include "SpellGems/Config.h"
 
+#include "SpellGems/Core/ConfigIni.h"
+#include "SpellGems/Scheduler.h"
+
 #include <algorithm>
-#include <cctype>
 #include <fstream>
-#include <iomanip>
-#include <sstream>
+#include <optional>
+#include <utility>
 
 namespace SpellGems
 {
@@ -26,66 +28,37 @@ namespace SpellGems
 			"Master"
 		};
 
+		constexpr auto kWatchPollInterval = std::chrono::seconds(1);
+		constexpr auto kWatchDebounce = std::chrono::milliseconds(300);
+		constexpr auto kSaveCoalesceDelay = std::chrono::milliseconds(250);
+
 		// Returns the path to the SpellGems INI file.
 		std::filesystem::path GetConfigPath()
 		{
 			return std::filesystem::path("Data/SKSE/Plugins") / "SpellGems.ini";
 		}
 
-		// Trims leading and trailing whitespace from a string.
-		std::string Trim(const std::string& value)
-		{
-			auto begin = value.find_first_not_of(" \t\r\n");
-			if (begin == std::string::npos) {
-				return {};
-			}
-			auto end = value.find_last_not_of(" \t\r\n");
-			return value.substr(begin, end - begin + 1);
-		}
-
-		// Parses a boolean value from common string representations.
-		bool TryParseBool(const std::string& value, bool& out)
+		// Reads the whole file in one go; empty when it cannot be opened.
+		std::optional<std::string> ReadConfigText(const std::filesystem::path& path)
 		{
-			const auto lowered = [&]() {
-				std::string result = value;
-				std::transform(result.begin(), result.end(), result.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
-				return result;
-			}();
-
-			if (lowered == "true" || lowered == "1" || lowered == "yes") {
-				out = true;
-				return true;
-			}
-			if (lowered == "false" || lowered == "0" || lowered == "no") {
-				out = false;
-				return true;
+			std::ifstream file(path, std::ios::binary | std::ios::ate);
+			if (!file.is_open()) {
+				return std::nullopt;
 			}
 
-			return false;
+			std::string text(static_cast<std::size_t>(std::max<std::streamoff>(file.tellg(), 0)), '\0');
+			file.seekg(0);
+			file.read(text.data(), static_cast<std::streamsize>(text.size()));
+			text.resize(static_cast<std::size_t>(file.gcount()));
+			return text;
 		}
 	}
 
-	// Initializes configuration defaults.
-	Config::Config()
+	// Defaults live in ConfigValues.
+	Config::Config() :
+		writer_(kSaveCoalesceDelay, [this](const std::filesystem::path& path, bool written) { OnWritten(path, written); }),
+		notified_(published_.Get())
 	{
-		storeKey_ = 0x4C;
-		activationKeys_ = { 2, 3, 4, 5, 6 };
-		maxStoredGems_ = 5;
-		requireFilledSoulGem_ = true;
-		allowAnyGemTier_ = false;
-		blackSoulGemBoosts_ = true;
-		normalGemPenalty_ = true;
-		azurasStarBoost_ = true;
-		focusSpellDuration_ = 2.0f;
-		starCooldown_ = 3.0f;
-		fragmentFormId_ = 0x00067181;
-		fragmentCounts_.fill(1);
-
-		tierSettings_[static_cast<std::size_t>(SpellTier::Novice)] = { 3.0f, 10 };
-		tierSettings_[static_cast<std::size_t>(SpellTier::Apprentice)] = { 6.0f, 8 };
-		tierSettings_[static_cast<std::size_t>(SpellTier::Adept)] = { 12.0f, 6 };
-		tierSettings_[static_cast<std::size_t>(SpellTier::Expert)] = { 20.0f, 4 };
-		tierSettings_[static_cast<std::size_t>(SpellTier::Master)] = { 30.0f, 3 };
 	}
 
 	// Returns the singleton config instance.
@@ -95,12 +68,13 @@ namespace SpellGems
 		return instance;
 	}
 
-	// Loads configuration from the INI file, falling back to defaults.
+	// Loads configuration from the INI file, falling back to defaults. The file is read in one go and parsed in
+	// place; a bad line is logged and skipped without disturbing the rest.
 	void Config::Load()
 	{
 		const auto path = GetConfigPath();
-		std::ifstream file(path);
-		if (!file.is_open()) {
+		const auto text = ReadConfigText(path);
+		if (!text) {
 			logger::info("Config file not found, using defaults: {}", path.string());
 			Save();
 			return;
@@ -108,361 +82,320 @@ namespace SpellGems
 
 		logger::info("Loading config from {}", path.string());
 
-		std::string currentSection;
-		std::string line;
-		bool sawStoreKey = false;
-		bool sawFiniteUse = false;
-		bool sawShowUsesRemaining = false;
-		bool sawRequireFilledSoulGem = false;
-		bool sawMaxStoredGems = false;
-		std::array<bool, 4> sawSlotKey{};
-		std::array<bool, static_cast<std::size_t>(SpellTier::Total)> sawCooldown{};
-		std::array<bool, static_cast<std::size_t>(SpellTier::Total)> sawUses{};
-		while (std::getline(file, line)) {
-			line = Trim(line);
-			if (line.empty() || line.front() == ';' || line.front() == '#') {
-				continue;
-			}
+		auto values = published_.Get()->values;
+		const auto result = ConfigIni::Parse(*text, values);
+		for (const auto& issue : result.issues) {
+			logger::info("Config line {}: {}", issue.line, issue.message);
+		}
+		logger::info("Config applied {} settings ({} unknown keys, {} bad lines).", result.applied, result.unknown,
+			result.issues.size());
 
-			if (line.front() == '[' && line.back() == ']') {
-				currentSection = Trim(line.substr(1, line.size() - 2));
-				continue;
-			}
+		const auto snapshot = published_.Publish(values);
+		if (!values.rules.empty()) {
+			logger::info("Compiled {} gem rules ({} naming a spell).", values.rules.size(), snapshot->rules.outcomes.GetNamedSpellCount());
+		}
+		QueueChangeDispatch();
 
-			auto delimiter = line.find('=');
-			if (delimiter == std::string::npos) {
-				continue;
-			}
+		if (result.missingRequired > 0) {
+			logger::info("Config missing {} entries; writing defaults to {}", result.missingRequired, path.string());
+			Save();
+		}
+	}
 
-			auto key = Trim(line.substr(0, delimiter));
-			auto value = Trim(line.substr(delimiter + 1));
+	// Queues the current settings for the background writer and returns without touching the disk.
+	void Config::Save()
+	{
+		writer_.Submit(GetConfigPath(), published_.Get());
+	}
 
-			if (currentSection == "Settings" && key == "StarCooldown") {
-				starCooldown_ = std::stof(value);
-				starCooldown_ = starCooldown_ < 0.0f ? 0.0f : starCooldown_;
-				logger::info("Config StarCooldown = {}", starCooldown_);
-				continue;
-			}
+	// Worker thread, after each save attempt.
+	void Config::OnWritten(const std::filesystem::path& path, bool written)
+	{
+		if (!written) {
+			logger::info("Failed to write config to {}", path.string());
+			return;
+		}
+		watcher_.Acknowledge();
+		logger::info("Config saved to {}", path.string());
+	}
 
-			if (currentSection == "Input" && key == "StoreKey") {
-				storeKey_ = static_cast<std::uint32_t>(std::stoul(value));
-				logger::info("Config StoreKey = {}", storeKey_);
-				sawStoreKey = true;
-				continue;
-			}
-			if (currentSection == "Activation" && key == "MaxStoredGems") {
-				SetMaxStoredGems(static_cast<std::uint8_t>(std::stoul(value)));
-				logger::info("Config MaxStoredGems = {}", maxStoredGems_);
-				sawMaxStoredGems = true;
-				continue;
-			}
-			if (currentSection == "Activation" && key.starts_with("Slot") && key.ends_with("Key")) {
-				auto indexText = key.substr(4, key.size() - 7);
-				std::size_t index = static_cast<std::size_t>(std::stoul(indexText));
-				if (index > 0 && index <= activationKeys_.size()) {
-					activationKeys_[index - 1] = static_cast<std::uint32_t>(std::stoul(value));
-					logger::info("Config Slot{}Key = {}", index, activationKeys_[index - 1]);
-					sawSlotKey[index - 1] = true;
-				}
-				continue;
-			}
-			if (currentSection == "Settings" && key == "FiniteUse") {
-				bool parsed = finiteUse_;
-				if (TryParseBool(value, parsed)) {
-					finiteUse_ = parsed;
-					logger::info("Config FiniteUse = {}", finiteUse_);
-					sawFiniteUse = true;
-				}
-				continue;
-			}
-			if (currentSection == "Settings" && key == "RequireFilledSoulGem") {
-				bool parsed = requireFilledSoulGem_;
-				if (TryParseBool(value, parsed)) {
-					requireFilledSoulGem_ = parsed;
-					logger::info("Config RequireFilledSoulGem = {}", requireFilledSoulGem_);
-					sawRequireFilledSoulGem = true;
-				}
-				continue;
-			}
-			if (currentSection == "Settings" && key == "AllowAnyGemTier") {
-				bool parsed = allowAnyGemTier_;
-				if (TryParseBool(value, parsed)) {
-					allowAnyGemTier_ = parsed;
-					logger::info("Config AllowAnyGemTier = {}", allowAnyGemTier_);
-				}
-				continue;
-			}
-			if (currentSection == "Settings" && key == "BlackSoulGemBoosts") {
-				bool parsed = blackSoulGemBoosts_;
-				if (TryParseBool(value, parsed)) {
-					blackSoulGemBoosts_ = parsed;
-					logger::info("Config BlackSoulGemBoosts = {}", blackSoulGemBoosts_);
-				}
-				continue;
-			}
-			if (currentSection == "Settings" && key == "NormalGemPenalty") {
-				bool parsed = normalGemPenalty_;
-				if (TryParseBool(value, parsed)) {
-					normalGemPenalty_ = parsed;
-					logger::info("Config NormalGemPenalty = {}", normalGemPenalty_);
-				}
-				continue;
-			}
-			if (currentSection == "Settings" && key == "AzurasStarBoost") {
-				bool parsed = azurasStarBoost_;
-				if (TryParseBool(value, parsed)) {
-					azurasStarBoost_ = parsed;
-					logger::info("Config AzurasStarBoost = {}", azurasStarBoost_);
-				}
-				continue;
-			}
-			if (currentSection == "Settings" && key == "ShowUsesRemaining") {
-				bool parsed = showUsesRemaining_;
-				if (TryParseBool(value, parsed)) {
-					showUsesRemaining_ = parsed;
-					logger::info("Config ShowUsesRemaining = {}", showUsesRemaining_);
-					sawShowUsesRemaining = true;
-				}
-				continue;
-			}
+	ConfigWriter::Stats Config::GetWriterStats() const
+	{
+		return writer_.GetStats();
+	}
 
-			for (std::size_t i = 0; i < tierSettings_.size(); ++i) {
-				const auto* tierName = kTierNames[i];
-				if (currentSection != tierName) {
-					continue;
-				}
-
-				auto& settings = tierSettings_[i];
-			if (key == "Cooldown") {
-					settings.cooldown = std::stof(value);
-					logger::info("Config {} Cooldown = {}", tierName, settings.cooldown);
-					sawCooldown[i] = true;
-				} else if (key == "Uses") {
-					settings.uses = std::stoi(value);
-					logger::info("Config {} Uses = {}", tierName, settings.uses);
-					sawUses[i] = true;
-			} else if (key == "FragmentCount") {
-				fragmentCounts_[i] = static_cast<std::uint32_t>(std::stoul(value));
-				logger::info("Config {} FragmentCount = {}", tierName, fragmentCounts_[i]);
-				}
-			}
+	void Config::StartWatching()
+	{
+		FileWatcher::Settings settings{};
+		settings.pollInterval = kWatchPollInterval;
+		settings.debounce = kWatchDebounce;
+		if (watcher_.Start(GetConfigPath(), []() { GetSingleton().Reload(); }, settings)) {
+			logger::info("Watching {} for changes ({} backend).", GetConfigPath().string(),
+				watcher_.GetBackend() == FileWatcher::Backend::Native ? "native" : "polling");
 		}
+	}
 
-		const bool missingActivationKeys = std::any_of(sawSlotKey.begin(), sawSlotKey.end(), [](bool value) { return !value; });
-		const bool missingCooldowns = std::any_of(sawCooldown.begin(), sawCooldown.end(), [](bool value) { return !value; });
-		const bool missingUses = std::any_of(sawUses.begin(), sawUses.end(), [](bool value) { return !value; });
-		const bool needsSave = !sawStoreKey || !sawFiniteUse || !sawShowUsesRemaining || !sawRequireFilledSoulGem ||
-			!sawMaxStoredGems || missingActivationKeys || missingCooldowns || missingUses;
-		if (needsSave) {
-			logger::info("Config missing entries; writing defaults to {}", path.string());
-			Save();
-		}
+	void Config::StopWatching()
+	{
+		watcher_.Stop();
+	}
+
+	Config::ReloadStats Config::GetReloadStats() const
+	{
+		return {
+			reloadsApplied_.load(std::memory_order_relaxed),
+			reloadsRejected_.load(std::memory_order_relaxed),
+			reloadsUnchanged_.load(std::memory_order_relaxed),
+			watcher_.GetBackend()
+		};
+	}
+
+	void Config::AddChangeListener(ChangeListener listener)
+	{
+		listeners_.push_back(std::move(listener));
 	}
 
-	// Writes the current configuration to the INI file.
-	void Config::Save() const
+	// Runs on the watcher thread. The file is parsed over the live values and swapped in only if every line
+	// parsed, so a half-written or mistyped file leaves the running config alone until the next edit.
+	void Config::Reload()
 	{
 		const auto path = GetConfigPath();
-		std::filesystem::create_directories(path.parent_path());
+		const auto text = ReadConfigText(path);
+		if (!text) {
+			reloadsRejected_.fetch_add(1, std::memory_order_relaxed);
+			logger::info("Config reload skipped; {} could not be read.", path.string());
+			return;
+		}
 
-		std::ofstream file(path, std::ios::trunc);
-		if (!file.is_open()) {
-			logger::info("Failed to write config to {}", path.string());
+		ConfigIni::Result result{};
+		bool changed = false;
+		const auto snapshot = published_.Update([&](ConfigValues& values) {
+			const auto before = values;
+			result = ConfigIni::Parse(*text, values);
+			changed = values != before;
+			return result.issues.empty() && result.applied > 0 && changed;
+		});
+		if (snapshot) {
+			reloadsApplied_.fetch_add(1, std::memory_order_relaxed);
+			logger::info("Config reloaded from {} (generation {}).", path.string(), snapshot->generation);
+			QueueChangeDispatch();
 			return;
 		}
 
-		file << "[Input]\n";
-		file << "StoreKey=" << storeKey_ << "\n\n";
-
-		file << "[Settings]\n";
-		file << "FiniteUse=" << (finiteUse_ ? "true" : "false") << "\n";
-		file << "RequireFilledSoulGem=" << (requireFilledSoulGem_ ? "true" : "false") << "\n";
-		file << "AllowAnyGemTier=" << (allowAnyGemTier_ ? "true" : "false") << "\n";
-		file << "BlackSoulGemBoosts=" << (blackSoulGemBoosts_ ? "true" : "false") << "\n";
-		file << "NormalGemPenalty=" << (normalGemPenalty_ ? "true" : "false") << "\n";
-		file << "AzurasStarBoost=" << (azurasStarBoost_ ? "true" : "false") << "\n";
-		file << "FocusSpellDuration=" << focusSpellDuration_ << "\n";
-		file << "StarCooldown=" << starCooldown_ << "\n";
-		{
-			std::ostringstream fragmentStream;
-			fragmentStream << "0x" << std::uppercase << std::hex << std::setw(8) << std::setfill('0') << fragmentFormId_;
-			file << "FragmentFormID=" << fragmentStream.str() << "\n";
+		if (result.issues.empty() && result.applied > 0) {
+			reloadsUnchanged_.fetch_add(1, std::memory_order_relaxed);
+			return;
 		}
-		file << "ShowUsesRemaining=" << (showUsesRemaining_ ? "true" : "false") << "\n\n";
+		reloadsRejected_.fetch_add(1, std::memory_order_relaxed);
+		for (const auto& issue : result.issues) {
+			logger::info("Config line {}: {}", issue.line, issue.message);
+		}
+		logger::info("Config reload rejected ({} bad lines, {} settings); keeping the running config.", result.issues.size(),
+			result.applied);
+	}
 
-		file << "[Activation]\n";
-		file << "MaxStoredGems=" << static_cast<int>(maxStoredGems_) << "\n";
-		for (std::size_t i = 0; i < activationKeys_.size(); ++i) {
-			file << "Slot" << (i + 1) << "Key=" << activationKeys_[i] << "\n";
+	// Any thread. At most one dispatch is queued at a time; it reports whatever is current when it runs.
+	void Config::QueueChangeDispatch()
+	{
+		if (dispatchPending_.exchange(true, std::memory_order_acq_rel)) {
+			return;
 		}
-		file << "\n";
-
-		for (std::size_t i = 0; i < tierSettings_.size(); ++i) {
-			const auto* tierName = kTierNames[i];
-			const auto& settings = tierSettings_[i];
-			file << '[' << tierName << "]\n";
-			file << "Cooldown=" << settings.cooldown << "\n";
-			file << "Uses=" << settings.uses << "\n";
-			file << "FragmentCount=" << fragmentCounts_[i] << "\n\n";
+		Scheduler::GetSingleton().ScheduleNextFrame([]() { GetSingleton().DispatchChanges(); });
+	}
+
+	void Config::DispatchChanges()
+	{
+		dispatchPending_.store(false, std::memory_order_release);
+		const auto current = published_.Get();
+		const auto previous = std::exchange(notified_, current);
+		if (previous->generation == current->generation) {
+			return;
 		}
+		for (const auto& listener : listeners_) {
+			listener(*previous, *current);
+		}
+	}
 
-		logger::info("Config saved to {}", path.string());
+	ConfigSnapshotPtr Config::GetSnapshot() const
+	{
+		return published_.Get();
+	}
+
+	TierSettings Config::GetTierSettings(SpellTier tier) const
+	{
+		return published_.Get()->values.tiers[static_cast<std::size_t>(tier)];
 	}
 
-	const TierSettings& Config::GetTierSettings(SpellTier tier) const
+	void Config::SetTierCooldown(SpellTier tier, float value)
 	{
-		return tierSettings_[static_cast<std::size_t>(tier)];
+		Edit([&](ConfigValues& values) { values.tiers[static_cast<std::size_t>(tier)].cooldown = value; });
 	}
 
-	TierSettings& Config::GetTierSettings(SpellTier tier)
+	void Config::SetTierUses(SpellTier tier, std::int32_t value)
 	{
-		return tierSettings_[static_cast<std::size_t>(tier)];
+		Edit([&](ConfigValues& values) { values.tiers[static_cast<std::size_t>(tier)].uses = value; });
 	}
 
 	std::uint32_t Config::GetStoreKey() const
 	{
-		return storeKey_;
+		return published_.Get()->values.storeKey;
 	}
 
 	void Config::SetStoreKey(std::uint32_t key)
 	{
-		storeKey_ = key;
+		Edit([&](ConfigValues& values) { values.storeKey = key; });
 	}
 
 	std::uint32_t Config::GetActivationKey(std::size_t index) const
 	{
-		if (index >= activationKeys_.size()) {
+		if (index >= kActivationSlotCount) {
 			return 0;
 		}
-		return activationKeys_[index];
+		return published_.Get()->values.activationKeys[index];
 	}
 
 	void Config::SetActivationKey(std::size_t index, std::uint32_t key)
 	{
-		if (index >= activationKeys_.size()) {
+		if (index >= kActivationSlotCount) {
 			return;
 		}
-		activationKeys_[index] = key;
+		Edit([&](ConfigValues& values) { values.activationKeys[index] = key; });
 	}
 
 	std::uint8_t Config::GetMaxStoredGems() const
 	{
-		return maxStoredGems_;
+		return published_.Get()->values.maxStoredGems;
 	}
 
 	void Config::SetMaxStoredGems(std::uint8_t value)
 	{
-		maxStoredGems_ = std::clamp<std::uint8_t>(value, 3, 5);
+		Edit([&](ConfigValues& values) { values.maxStoredGems = std::clamp(value, kMinStoredGems, kMaxStoredGems); });
 	}
 
 	bool Config::IsFiniteUse() const
 	{
-		return finiteUse_;
+		return published_.Get()->values.finiteUse;
 	}
 
 	void Config::SetFiniteUse(bool value)
 	{
-		finiteUse_ = value;
+		Edit([&](ConfigValues& values) { values.finiteUse = value; });
 	}
 
 	bool Config::ShowUsesRemaining() const
 	{
-		return showUsesRemaining_;
+		return published_.Get()->values.showUsesRemaining;
 	}
 
 	void Config::SetShowUsesRemaining(bool value)
 	{
-		showUsesRemaining_ = value;
+		Edit([&](ConfigValues& values) { values.showUsesRemaining = value; });
+	}
+
+	bool Config::CompressSaveData() const
+	{
+		return published_.Get()->values.compressSaveData;
+	}
+
+	void Config::SetCompressSaveData(bool value)
+	{
+		Edit([&](ConfigValues& values) { values.compressSaveData = value; });
 	}
 
 	bool Config::RequireFilledSoulGem() const
 	{
-		return requireFilledSoulGem_;
+		return published_.Get()->values.requireFilledSoulGem;
 	}
 
 	void Config::SetRequireFilledSoulGem(bool value)
 	{
-		requireFilledSoulGem_ = value;
+		Edit([&](ConfigValues& values) { values.requireFilledSoulGem = value; });
 	}
 
 	bool Config::AllowAnyGemTier() const
 	{
-		return allowAnyGemTier_;
+		return published_.Get()->values.allowAnyGemTier;
 	}
 
 	void Config::SetAllowAnyGemTier(bool value)
 	{
-		allowAnyGemTier_ = value;
+		Edit([&](ConfigValues& values) { values.allowAnyGemTier = value; });
 	}
 
 	bool Config::BlackSoulGemBoosts() const
 	{
-		return blackSoulGemBoosts_;
+		return published_.Get()->values.blackSoulGemBoosts;
 	}
 
 	void Config::SetBlackSoulGemBoosts(bool value)
 	{
-		blackSoulGemBoosts_ = value;
+		Edit([&](ConfigValues& values) { values.blackSoulGemBoosts = value; });
 	}
 
 	bool Config::NormalGemPenalty() const
 	{
-		return normalGemPenalty_;
+		return published_.Get()->values.normalGemPenalty;
 	}
 
 	void Config::SetNormalGemPenalty(bool value)
 	{
-		normalGemPenalty_ = value;
+		Edit([&](ConfigValues& values) { values.normalGemPenalty = value; });
 	}
 
 	bool Config::AzurasStarBoost() const
 	{
-		return azurasStarBoost_;
+		return published_.Get()->values.azurasStarBoost;
 	}
 
 	void Config::SetAzurasStarBoost(bool value)
 	{
-		azurasStarBoost_ = value;
+		Edit([&](ConfigValues& values) { values.azurasStarBoost = value; });
 	}
 
 	float Config::GetFocusSpellDuration() const
 	{
-		return focusSpellDuration_;
+		return published_.Get()->values.focusSpellDuration;
 	}
 
 	void Config::SetFocusSpellDuration(float value)
 	{
-		focusSpellDuration_ = std::clamp(value, 0.0f, 3.0f);
+		Edit([&](ConfigValues& values) { values.focusSpellDuration = std::clamp(value, 0.0f, kMaxFocusSpellDuration); });
 	}
 
 	float Config::GetStarCooldown() const
 	{
-		return starCooldown_;
+		return published_.Get()->values.starCooldown;
 	}
 
 	void Config::SetStarCooldown(float value)
 	{
-		starCooldown_ = value < 0.0f ? 0.0f : value;
+		Edit([&](ConfigValues& values) { values.starCooldown = value < 0.0f ? 0.0f : value; });
 	}
 
 	std::uint32_t Config::GetFragmentFormId() const
 	{
-		return fragmentFormId_;
+		return published_.Get()->values.fragmentFormId;
 	}
 
 	void Config::SetFragmentFormId(std::uint32_t value)
 	{
-		fragmentFormId_ = value;
+		Edit([&](ConfigValues& values) { values.fragmentFormId = value; });
 	}
 
 	std::uint32_t Config::GetFragmentCount(SpellTier tier) const
 	{
-		return fragmentCounts_[static_cast<std::size_t>(tier)];
+		return published_.Get()->values.fragmentCounts[static_cast<std::size_t>(tier)];
 	}
 
 	void Config::SetFragmentCount(SpellTier tier, std::uint32_t value)
 	{
-		fragmentCounts_[static_cast<std::size_t>(tier)] = value;
+		Edit([&](ConfigValues& values) { values.fragmentCounts[static_cast<std::size_t>(tier)] = value; });
+	}
+
+	// Every published snapshot has its own generation, so any settings change invalidates cached cast plans.
+	std::uint32_t Config::GetGeneration() const
+	{
+		return published_.Get()->generation;
 	}
 
 	std::string_view Config::GetTierName(SpellTier tier)
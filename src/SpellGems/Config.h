@@ -1,39 +1,56 @@
 // Configuration types and accessors for SpellGems.
 #pragma once
 
+#include "SpellGems/Core/ConfigSnapshot.h"
+#include "SpellGems/Core/ConfigWriter.h"
+#include "SpellGems/Core/FileWatcher.h"
+#include "SpellGems/Core/GemTypes.h"
+
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace SpellGems
 {
-	enum class SpellTier : std::uint8_t
-	{
-		Novice = 0,
-		Apprentice,
-		Adept,
-		Expert,
-		Master,
-		Total
-	};
-
-	struct TierSettings
-	{
-		float cooldown;
-		std::int32_t uses;
-	};
-
 	class Config
 	{
 	public:
+		using ChangeListener = std::function<void(const ConfigSnapshot& previous, const ConfigSnapshot& current)>;
+
+		struct ReloadStats
+		{
+			std::uint64_t applied;
+			std::uint64_t rejected;
+			std::uint64_t unchanged;
+			FileWatcher::Backend backend;
+		};
+
 		static Config& GetSingleton();
 
 		void Load();
-		void Save() const;
+		void Save();
+		ConfigWriter::Stats GetWriterStats() const;
+
+		// Watches the INI from a background thread and applies edits to it while the game runs.
+		void StartWatching();
+		void StopWatching();
+		ReloadStats GetReloadStats() const;
+
+		// Listeners run on the main thread the frame after any change, with the snapshots before and after.
+		// Several changes within one frame arrive as one call. Main thread only.
+		void AddChangeListener(ChangeListener listener);
+
+		// The current settings in one consistent view; safe from any thread and cheap enough for hot paths.
+		ConfigSnapshotPtr GetSnapshot() const;
 
-		const TierSettings& GetTierSettings(SpellTier tier) const;
-		TierSettings& GetTierSettings(SpellTier tier);
+		// Single-value reads each take the current snapshot; read several through one GetSnapshot instead.
+		TierSettings GetTierSettings(SpellTier tier) const;
+		void SetTierCooldown(SpellTier tier, float value);
+		void SetTierUses(SpellTier tier, std::int32_t value);
 
 		std::uint32_t GetStoreKey() const;
 		void SetStoreKey(std::uint32_t key);
@@ -47,6 +64,8 @@ namespace SpellGems
 
 		bool ShowUsesRemaining() const;
 		void SetShowUsesRemaining(bool value);
+		bool CompressSaveData() const;
+		void SetCompressSaveData(bool value);
 		bool RequireFilledSoulGem() const;
 		void SetRequireFilledSoulGem(bool value);
 		bool AllowAnyGemTier() const;
@@ -66,25 +85,42 @@ namespace SpellGems
 		std::uint32_t GetFragmentCount(SpellTier tier) const;
 		void SetFragmentCount(SpellTier tier, std::uint32_t value);
 
+		std::uint32_t GetGeneration() const;
+
 		static std::string_view GetTierName(SpellTier tier);
 
 	private:
 		Config();
 
-		std::array<TierSettings, static_cast<std::size_t>(SpellTier::Total)> tierSettings_{};
-		std::uint32_t storeKey_{};
-		std::array<std::uint32_t, 5> activationKeys_{};
-		std::uint8_t maxStoredGems_{ 3 };
-		bool finiteUse_{ true };
-		bool showUsesRemaining_{ true };
-		bool requireFilledSoulGem_{ true };
-		bool allowAnyGemTier_{ false };
-		bool blackSoulGemBoosts_{ true };
-		bool normalGemPenalty_{ true };
-		bool azurasStarBoost_{ true };
-		float focusSpellDuration_{ 2.0f };
-		float starCooldown_{ 3.0f };
-		std::uint32_t fragmentFormId_{ 0x00067181 };
-		std::array<std::uint32_t, static_cast<std::size_t>(SpellTier::Total)> fragmentCounts_{};
+		// Publishes only when the edit changed a value, as Reload does, so a setter called with the current value
+		// leaves the generation and the listeners alone.
+		template <class Fn>
+		void Edit(Fn&& edit)
+		{
+			const auto snapshot = published_.Update([&](ConfigValues& values) {
+				const auto before = values;
+				edit(values);
+				return values != before;
+			});
+			if (snapshot) {
+				QueueChangeDispatch();
+			}
+		}
+
+		void Reload();
+		void OnWritten(const std::filesystem::path& path, bool written);
+		void QueueChangeDispatch();
+		void DispatchChanges();
+
+		ConfigPublisher published_;
+		FileWatcher watcher_;
+		// Declared after watcher_ so it stops first; its completion callback acknowledges writes to the watcher.
+		ConfigWriter writer_;
+		std::vector<ChangeListener> listeners_;
+		ConfigSnapshotPtr notified_;
+		std::atomic<bool> dispatchPending_{ false };
+		std::atomic<std::uint64_t> reloadsApplied_{ 0 };
+		std::atomic<std::uint64_t> reloadsRejected_{ 0 };
+		std::atomic<std::uint64_t> reloadsUnchanged_{ 0 };
 	};
 }
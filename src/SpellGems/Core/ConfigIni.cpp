@@ -0,0 +1,581 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                 Config INI                                                  //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/ConfigIni.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <charconv>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace SpellGems::ConfigIni
+{
+	namespace
+	{
+		using Apply = bool (*)(ConfigValues&, std::string_view);
+
+		struct Setting
+		{
+			std::string_view section;
+			std::string_view key;
+			Apply apply;
+			// Written by Config::Save, so a file without it predates the setting.
+			bool required;
+		};
+
+		constexpr std::array<std::string_view, kTierCount> kTierSections{ "Novice", "Apprentice", "Adept", "Expert", "Master" };
+
+		constexpr std::string_view kWhitespace = " \t\r\n";
+
+		std::string_view Trim(std::string_view text)
+		{
+			const auto begin = text.find_first_not_of(kWhitespace);
+			if (begin == std::string_view::npos) {
+				return {};
+			}
+			return text.substr(begin, text.find_last_not_of(kWhitespace) - begin + 1);
+		}
+
+		// A ';' or '#' after whitespace starts a trailing comment.
+		std::string_view StripComment(std::string_view value)
+		{
+			for (std::size_t i = 1; i < value.size(); ++i) {
+				if ((value[i] == ';' || value[i] == '#') && (value[i - 1] == ' ' || value[i - 1] == '\t')) {
+					return Trim(value.substr(0, i));
+				}
+			}
+			return value;
+		}
+
+		bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs)
+		{
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+				return (a | 0x20) == (b | 0x20);
+			});
+		}
+
+		bool ParseBool(std::string_view text, bool& out)
+		{
+			if (text == "1" || EqualsIgnoreCase(text, "true") || EqualsIgnoreCase(text, "yes")) {
+				out = true;
+				return true;
+			}
+			if (text == "0" || EqualsIgnoreCase(text, "false") || EqualsIgnoreCase(text, "no")) {
+				out = false;
+				return true;
+			}
+			return false;
+		}
+
+		// The whole value must be the number; integers also accept a 0x prefix.
+		template <class T>
+		bool ParseNumber(std::string_view text, T& out)
+		{
+			const char* first = text.data();
+			const char* last = first + text.size();
+			T value{};
+			std::from_chars_result parsed{};
+			if constexpr (std::is_integral_v<T>) {
+				int base = 10;
+				if (text.size() > 2 && text[0] == '0' && (text[1] | 0x20) == 'x') {
+					first += 2;
+					base = 16;
+				}
+				parsed = std::from_chars(first, last, value, base);
+			} else {
+				parsed = std::from_chars(first, last, value);
+			}
+			if (parsed.ec != std::errc{} || parsed.ptr != last || first == last) {
+				return false;
+			}
+			out = value;
+			return true;
+		}
+
+		template <auto Member>
+		bool ApplyBool(ConfigValues& values, std::string_view text)
+		{
+			return ParseBool(text, values.*Member);
+		}
+
+		template <auto Member>
+		bool ApplyNumber(ConfigValues& values, std::string_view text)
+		{
+			return ParseNumber(text, values.*Member);
+		}
+
+		bool ApplyMaxStoredGems(ConfigValues& values, std::string_view text)
+		{
+			std::uint32_t count = 0;
+			if (!ParseNumber(text, count)) {
+				return false;
+			}
+			values.maxStoredGems = static_cast<std::uint8_t>(std::clamp<std::uint32_t>(count, kMinStoredGems, kMaxStoredGems));
+			return true;
+		}
+
+		bool ApplyFocusSpellDuration(ConfigValues& values, std::string_view text)
+		{
+			float duration = 0.0f;
+			if (!ParseNumber(text, duration)) {
+				return false;
+			}
+			values.focusSpellDuration = std::clamp(duration, 0.0f, kMaxFocusSpellDuration);
+			return true;
+		}
+
+		bool ApplyStarCooldown(ConfigValues& values, std::string_view text)
+		{
+			float cooldown = 0.0f;
+			if (!ParseNumber(text, cooldown)) {
+				return false;
+			}
+			values.starCooldown = std::max(cooldown, 0.0f);
+			return true;
+		}
+
+		template <std::size_t Slot>
+		bool ApplySlotKey(ConfigValues& values, std::string_view text)
+		{
+			return ParseNumber(text, values.activationKeys[Slot]);
+		}
+
+		template <std::size_t Tier>
+		bool ApplyCooldown(ConfigValues& values, std::string_view text)
+		{
+			return ParseNumber(text, values.tiers[Tier].cooldown);
+		}
+
+		template <std::size_t Tier>
+		bool ApplyUses(ConfigValues& values, std::string_view text)
+		{
+			return ParseNumber(text, values.tiers[Tier].uses);
+		}
+
+		template <std::size_t Tier>
+		bool ApplyFragmentCount(ConfigValues& values, std::string_view text)
+		{
+			return ParseNumber(text, values.fragmentCounts[Tier]);
+		}
+
+		constexpr std::array<std::string_view, kSchoolCount> kSchoolNames{ "Alteration", "Conjuration", "Destruction", "Illusion", "Restoration" };
+		constexpr std::array<std::string_view, kGemClassCount> kGemClassNames{ "Normal", "Black", "AzurasStar", "BlackStar" };
+
+		// Splits off the next whitespace-separated name=value pair. Returns false once text is used up.
+		bool NextPair(std::string_view& text, std::string_view& name, std::string_view& value)
+		{
+			text = Trim(text);
+			if (text.empty()) {
+				return false;
+			}
+			const auto token = text.substr(0, text.find_first_of(" \t"));
+			text.remove_prefix(token.size());
+			const auto delimiter = token.find('=');
+			name = token.substr(0, delimiter);
+			value = delimiter == std::string_view::npos ? std::string_view{} : token.substr(delimiter + 1);
+			return true;
+		}
+
+		// A '|' separated list of names, matched case-insensitively; each sets its index as a bit in mask.
+		template <std::size_t N>
+		bool ParseNameMask(std::string_view text, const std::array<std::string_view, N>& names, std::uint8_t& mask)
+		{
+			mask = 0;
+			while (!text.empty()) {
+				const auto end = text.find('|');
+				const auto name = text.substr(0, end);
+				text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+				const auto it = std::find_if(names.begin(), names.end(), [&](std::string_view candidate) {
+					return EqualsIgnoreCase(name, candidate);
+				});
+				if (it == names.end()) {
+					return false;
+				}
+				mask |= static_cast<std::uint8_t>(1u << (it - names.begin()));
+			}
+			return mask != 0;
+		}
+
+		bool ParseCondition(std::string_view name, std::string_view value, GemRule& rule)
+		{
+			if (EqualsIgnoreCase(name, "spell")) {
+				return ParseNumber(value, rule.spellId) && rule.spellId != 0;
+			}
+			if (EqualsIgnoreCase(name, "school")) {
+				return ParseNameMask(value, kSchoolNames, rule.schoolMask);
+			}
+			if (EqualsIgnoreCase(name, "tier")) {
+				return ParseNameMask(value, kTierSections, rule.tierMask);
+			}
+			if (EqualsIgnoreCase(name, "gem")) {
+				return ParseNameMask(value, kGemClassNames, rule.gemMask);
+			}
+			return false;
+		}
+
+		bool ParseEffect(std::string_view name, std::string_view value, GemRule& rule)
+		{
+			float number = 0.0f;
+			if (EqualsIgnoreCase(name, "uses")) {
+				if (!ParseNumber(value, rule.uses)) {
+					return false;
+				}
+				rule.effects |= GemRule::kUses;
+				return true;
+			}
+			if (!ParseNumber(value, number)) {
+				return false;
+			}
+			if (EqualsIgnoreCase(name, "cooldown")) {
+				rule.cooldown = std::max(number, 0.0f);
+				rule.effects |= GemRule::kCooldown;
+			} else if (EqualsIgnoreCase(name, "effectiveness")) {
+				rule.effectiveness = std::max(number, 0.0f);
+				rule.effects |= GemRule::kEffectiveness;
+			} else if (EqualsIgnoreCase(name, "magnitude")) {
+				rule.magnitudeOverride = std::max(number, 0.0f);
+				rule.effects |= GemRule::kMagnitude;
+			} else if (EqualsIgnoreCase(name, "healthcost")) {
+				rule.healthCostFraction = std::clamp(number, 0.0f, 1.0f);
+				rule.effects |= GemRule::kHealthCost;
+			} else {
+				return false;
+			}
+			return true;
+		}
+
+		// Rule=[spell=0x...] [school=A|B] [tier=T|U] [gem=G|H] -> effect=value ...; at least one effect.
+		bool ApplyRule(ConfigValues& values, std::string_view text)
+		{
+			const auto arrow = text.find("->");
+			if (arrow == std::string_view::npos || values.rules.size() >= kMaxGemRules) {
+				return false;
+			}
+
+			GemRule rule{};
+			std::string_view name;
+			std::string_view value;
+			for (auto conditions = text.substr(0, arrow); NextPair(conditions, name, value);) {
+				if (!ParseCondition(name, value, rule)) {
+					return false;
+				}
+			}
+			for (auto effects = text.substr(arrow + 2); NextPair(effects, name, value);) {
+				if (!ParseEffect(name, value, rule)) {
+					return false;
+				}
+			}
+			if (rule.effects == 0) {
+				return false;
+			}
+			values.rules.push_back(rule);
+			return true;
+		}
+
+		constexpr std::array kFixedSettings{
+			Setting{ "Input", "StoreKey", &ApplyNumber<&ConfigValues::storeKey>, true },
+			Setting{ "Settings", "FiniteUse", &ApplyBool<&ConfigValues::finiteUse>, true },
+			Setting{ "Settings", "RequireFilledSoulGem", &ApplyBool<&ConfigValues::requireFilledSoulGem>, true },
+			Setting{ "Settings", "AllowAnyGemTier", &ApplyBool<&ConfigValues::allowAnyGemTier>, false },
+			Setting{ "Settings", "BlackSoulGemBoosts", &ApplyBool<&ConfigValues::blackSoulGemBoosts>, false },
+			Setting{ "Settings", "NormalGemPenalty", &ApplyBool<&ConfigValues::normalGemPenalty>, false },
+			Setting{ "Settings", "AzurasStarBoost", &ApplyBool<&ConfigValues::azurasStarBoost>, false },
+			Setting{ "Settings", "FocusSpellDuration", &ApplyFocusSpellDuration, false },
+			Setting{ "Settings", "StarCooldown", &ApplyStarCooldown, false },
+			Setting{ "Settings", "FragmentFormID", &ApplyNumber<&ConfigValues::fragmentFormId>, false },
+			Setting{ "Settings", "CompressSaveData", &ApplyBool<&ConfigValues::compressSaveData>, false },
+			Setting{ "Settings", "ShowUsesRemaining", &ApplyBool<&ConfigValues::showUsesRemaining>, true },
+			Setting{ "Activation", "MaxStoredGems", &ApplyMaxStoredGems, true },
+			Setting{ "Rules", "Rule", &ApplyRule, false },
+		};
+
+		constexpr std::array<std::string_view, kActivationSlotCount> kSlotKeys{ "Slot1Key", "Slot2Key", "Slot3Key", "Slot4Key", "Slot5Key" };
+
+		template <std::size_t... Slot, std::size_t... Tier>
+		constexpr auto MakeSettings(std::index_sequence<Slot...>, std::index_sequence<Tier...>)
+		{
+			std::array<Setting, kFixedSettings.size() + sizeof...(Slot) + sizeof...(Tier) * 3> settings{};
+			std::size_t next = 0;
+			for (const auto& setting : kFixedSettings) {
+				settings[next++] = setting;
+			}
+			((settings[next++] = Setting{ "Activation", kSlotKeys[Slot], &ApplySlotKey<Slot>, true }), ...);
+			((settings[next++] = Setting{ kTierSections[Tier], "Cooldown", &ApplyCooldown<Tier>, true },
+				 settings[next++] = Setting{ kTierSections[Tier], "Uses", &ApplyUses<Tier>, true },
+				 settings[next++] = Setting{ kTierSections[Tier], "FragmentCount", &ApplyFragmentCount<Tier>, false }),
+				...);
+			return settings;
+		}
+
+		constexpr auto kSettings = MakeSettings(std::make_index_sequence<kActivationSlotCount>{}, std::make_index_sequence<kTierCount>{});
+
+		// FNV-1a over section, a separator and key, salted with a seed chosen below so that no two settings share
+		// a slot. A lookup is one hash, one table load and one string compare.
+		constexpr std::size_t kSlotCount = 128;
+
+		constexpr std::uint32_t Hash(std::uint32_t seed, std::string_view section, std::string_view key)
+		{
+			std::uint32_t hash = 2166136261u ^ seed;
+			for (const char c : section) {
+				hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+			}
+			hash = (hash ^ 0x1F) * 16777619u;
+			for (const char c : key) {
+				hash = (hash ^ static_cast<std::uint8_t>(c)) * 16777619u;
+			}
+			return hash ^ (hash >> 15);
+		}
+
+		constexpr std::uint32_t FindSeed()
+		{
+			for (std::uint32_t seed = 1; seed < 100'000; ++seed) {
+				std::array<bool, kSlotCount> used{};
+				bool clash = false;
+				for (const auto& setting : kSettings) {
+					auto& slot = used[Hash(seed, setting.section, setting.key) % kSlotCount];
+					clash = clash || slot;
+					slot = true;
+				}
+				if (!clash) {
+					return seed;
+				}
+			}
+			return 0;
+		}
+
+		constexpr std::uint32_t kSeed = FindSeed();
+		static_assert(kSeed != 0, "no collision-free seed for the settings table");
+		static_assert(kSettings.size() < 0xFF, "slot table stores indices in a byte");
+
+		constexpr auto kSlots = [] {
+			std::array<std::uint8_t, kSlotCount> slots{};
+			for (std::size_t i = 0; i < kSettings.size(); ++i) {
+				slots[Hash(kSeed, kSettings[i].section, kSettings[i].key) % kSlotCount] = static_cast<std::uint8_t>(i + 1);
+			}
+			return slots;
+		}();
+
+		// Index into kSettings, or kSettings.size() when the pair is unknown.
+		std::size_t Find(std::string_view section, std::string_view key)
+		{
+			const auto slot = kSlots[Hash(kSeed, section, key) % kSlotCount];
+			if (slot == 0) {
+				return kSettings.size();
+			}
+			const auto& setting = kSettings[slot - 1];
+			return setting.section == section && setting.key == key ? slot - 1u : kSettings.size();
+		}
+
+		void AddIssue(Result& result, std::size_t line, std::string message)
+		{
+			result.issues.push_back({ line, std::move(message) });
+		}
+	}
+
+	Result Parse(std::string_view text, ConfigValues& values)
+	{
+		Result result{};
+		std::bitset<kSettings.size()> seen;
+		if (text.starts_with("\xEF\xBB\xBF")) {
+			text.remove_prefix(3);
+		}
+
+		// The file's Rule lines are the whole rule list, not additions to the one already in values.
+		values.rules.clear();
+
+		std::string_view section;
+		for (std::size_t lineNumber = 1; !text.empty(); ++lineNumber) {
+			const auto end = text.find('\n');
+			const auto line = Trim(text.substr(0, end));
+			text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+			if (line.empty() || line.front() == ';' || line.front() == '#') {
+				continue;
+			}
+
+			if (line.front() == '[') {
+				if (line.back() != ']') {
+					AddIssue(result, lineNumber, "unterminated section header");
+					continue;
+				}
+				section = Trim(line.substr(1, line.size() - 2));
+				continue;
+			}
+
+			const auto delimiter = line.find('=');
+			if (delimiter == std::string_view::npos) {
+				AddIssue(result, lineNumber, "expected Key=Value");
+				continue;
+			}
+
+			const auto key = Trim(line.substr(0, delimiter));
+			const auto value = StripComment(Trim(line.substr(delimiter + 1)));
+			const auto index = Find(section, key);
+			if (index == kSettings.size()) {
+				++result.unknown;
+				continue;
+			}
+			if (!kSettings[index].apply(values, value)) {
+				AddIssue(result, lineNumber,
+					"invalid value '" + std::string(value) + "' for [" + std::string(section) + "] " + std::string(key));
+				continue;
+			}
+			seen.set(index);
+			++result.applied;
+		}
+
+		for (std::size_t i = 0; i < kSettings.size(); ++i) {
+			result.missingRequired += kSettings[i].required && !seen.test(i) ? 1 : 0;
+		}
+		return result;
+	}
+
+	namespace
+	{
+		template <class T>
+		void AppendNumber(std::string& out, T value)
+		{
+			char buffer[32];
+			const auto written = std::to_chars(buffer, buffer + sizeof(buffer), value);
+			out.append(buffer, written.ptr);
+		}
+
+		void AppendSetting(std::string& out, std::string_view key, std::string_view value)
+		{
+			out.append(key).append("=").append(value).append("\n");
+		}
+
+		template <class T>
+		void AppendNumberSetting(std::string& out, std::string_view key, T value)
+		{
+			out.append(key).append("=");
+			AppendNumber(out, value);
+			out.append("\n");
+		}
+
+		void AppendBoolSetting(std::string& out, std::string_view key, bool value)
+		{
+			AppendSetting(out, key, value ? "true" : "false");
+		}
+
+		// 0x and eight uppercase hex digits.
+		void AppendFormId(std::string& out, std::uint32_t formId)
+		{
+			char digits[8];
+			const auto hex = std::to_chars(digits, digits + sizeof(digits), formId, 16);
+			out.append("0x").append(sizeof(digits) - static_cast<std::size_t>(hex.ptr - digits), '0');
+			std::transform(digits, hex.ptr, std::back_inserter(out), [](char c) { return c >= 'a' ? static_cast<char>(c - 'a' + 'A') : c; });
+		}
+
+		template <std::size_t N>
+		void AppendNameMask(std::string& out, std::string_view name, std::uint8_t mask, const std::array<std::string_view, N>& names)
+		{
+			if (mask == 0) {
+				return;
+			}
+			out.append(name).append("=");
+			std::string_view separator;
+			for (std::size_t i = 0; i < N; ++i) {
+				if ((mask >> i & 1) != 0) {
+					out.append(separator).append(names[i]);
+					separator = "|";
+				}
+			}
+			out.append(" ");
+		}
+
+		template <class T>
+		void AppendEffect(std::string& out, std::string_view name, T value)
+		{
+			out.append(" ").append(name).append("=");
+			AppendNumber(out, value);
+		}
+
+		void AppendRule(std::string& out, const GemRule& rule)
+		{
+			out.append("Rule=");
+			if (rule.spellId != 0) {
+				out.append("spell=");
+				AppendFormId(out, rule.spellId);
+				out.append(" ");
+			}
+			AppendNameMask(out, "school", rule.schoolMask, kSchoolNames);
+			AppendNameMask(out, "tier", rule.tierMask, kTierSections);
+			AppendNameMask(out, "gem", rule.gemMask, kGemClassNames);
+			out.append("->");
+			if ((rule.effects & GemRule::kCooldown) != 0) {
+				AppendEffect(out, "cooldown", rule.cooldown);
+			}
+			if ((rule.effects & GemRule::kUses) != 0) {
+				AppendEffect(out, "uses", rule.uses);
+			}
+			if ((rule.effects & GemRule::kEffectiveness) != 0) {
+				AppendEffect(out, "effectiveness", rule.effectiveness);
+			}
+			if ((rule.effects & GemRule::kMagnitude) != 0) {
+				AppendEffect(out, "magnitude", rule.magnitudeOverride);
+			}
+			if ((rule.effects & GemRule::kHealthCost) != 0) {
+				AppendEffect(out, "healthcost", rule.healthCostFraction);
+			}
+			out.append("\n");
+		}
+	}
+
+	void Write(const ConfigValues& values, std::string& out)
+	{
+		out.reserve(out.size() + 1024);
+
+		out.append("[Input]\n");
+		AppendNumberSetting(out, "StoreKey", values.storeKey);
+		out.append("\n[Settings]\n");
+		AppendBoolSetting(out, "FiniteUse", values.finiteUse);
+		AppendBoolSetting(out, "RequireFilledSoulGem", values.requireFilledSoulGem);
+		AppendBoolSetting(out, "AllowAnyGemTier", values.allowAnyGemTier);
+		AppendBoolSetting(out, "BlackSoulGemBoosts", values.blackSoulGemBoosts);
+		AppendBoolSetting(out, "NormalGemPenalty", values.normalGemPenalty);
+		AppendBoolSetting(out, "AzurasStarBoost", values.azurasStarBoost);
+		AppendNumberSetting(out, "FocusSpellDuration", values.focusSpellDuration);
+		AppendNumberSetting(out, "StarCooldown", values.starCooldown);
+
+		out.append("FragmentFormID=");
+		AppendFormId(out, values.fragmentFormId);
+		out.append("\n");
+
+		AppendBoolSetting(out, "CompressSaveData", values.compressSaveData);
+		AppendBoolSetting(out, "ShowUsesRemaining", values.showUsesRemaining);
+
+		out.append("\n[Activation]\n");
+		AppendNumberSetting(out, "MaxStoredGems", static_cast<std::uint32_t>(values.maxStoredGems));
+		for (std::size_t i = 0; i < kActivationSlotCount; ++i) {
+			AppendNumberSetting(out, kSlotKeys[i], values.activationKeys[i]);
+		}
+
+		for (std::size_t i = 0; i < kTierCount; ++i) {
+			out.append("\n[").append(kTierSections[i]).append("]\n");
+			AppendNumberSetting(out, "Cooldown", values.tiers[i].cooldown);
+			AppendNumberSetting(out, "Uses", values.tiers[i].uses);
+			AppendNumberSetting(out, "FragmentCount", values.fragmentCounts[i]);
+		}
+
+		out.append("\n[Rules]\n");
+		out.append("; Rule=[spell=0xFormID] [school=Destruction|...] [tier=Master|...] [gem=Normal|Black|AzurasStar|BlackStar] ->\n");
+		out.append(";      [cooldown=seconds] [uses=count] [effectiveness=x] [magnitude=x] [healthcost=fraction]\n");
+		out.append("; Matching rules apply in order; a later rule overrides what an earlier one set.\n");
+		for (const auto& rule : values.rules) {
+			AppendRule(out, rule);
+		}
+	}
+
+	std::size_t GetSettingCount()
+	{
+		return kSettings.size();
+	}
+}
@@ -0,0 +1,39 @@
+// INI reader for ConfigValues: string_view tokenizing and a compile-time perfect hash over (section, key).
+#pragma once
+
+#include "SpellGems/Core/ConfigValues.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SpellGems::ConfigIni
+{
+	struct Issue
+	{
+		std::size_t line;
+		std::string message;
+	};
+
+	struct Result
+	{
+		std::size_t applied{};
+		std::size_t unknown{};
+		// Settings Save always writes that the text lacked; a non-zero count means the file wants rewriting.
+		std::size_t missingRequired{};
+		std::vector<Issue> issues;
+	};
+
+	// Applies every recognized setting in text to values, in file order. Unknown keys are counted and skipped; a
+	// malformed line or value is reported with its line number and leaves the setting unchanged. The [Rules]
+	// Rule lines replace values.rules. Never throws.
+	Result Parse(std::string_view text, ConfigValues& values);
+
+	// Appends the whole file for values to out in the layout Config has always written. Floats use the shortest
+	// text that parses back to the same value.
+	void Write(const ConfigValues& values, std::string& out);
+
+	// Number of (section, key) pairs the parser recognizes.
+	std::size_t GetSettingCount();
+}
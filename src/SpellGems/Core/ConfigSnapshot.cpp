@@ -0,0 +1,45 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Config Snapshots                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/ConfigSnapshot.h"
+
+namespace SpellGems
+{
+	GemRules MakeGemRules(const ConfigValues& values)
+	{
+		return { values.fragmentCounts, values.fragmentFormId, GemRuleTable(values) };
+	}
+
+	ConfigPublisher::ConfigPublisher()
+	{
+		Publish(ConfigValues{});
+	}
+
+	ConfigSnapshotPtr ConfigPublisher::Get() const
+	{
+		return current_.load(std::memory_order_acquire);
+	}
+
+	ConfigSnapshotPtr ConfigPublisher::Publish(const ConfigValues& values)
+	{
+		std::lock_guard lock(writeMutex_);
+		return PublishLocked(values);
+	}
+
+	ConfigSnapshotPtr ConfigPublisher::PublishLocked(const ConfigValues& values)
+	{
+		const auto previous = current_.load(std::memory_order_relaxed);
+		auto snapshot = std::make_shared<ConfigSnapshot>();
+		snapshot->values = values;
+		snapshot->rules = MakeGemRules(values);
+		snapshot->generation = previous ? previous->generation + 1 : 1;
+		ConfigSnapshotPtr published = std::move(snapshot);
+		current_.store(published, std::memory_order_release);
+		return published;
+	}
+}
@@ -0,0 +1,66 @@
+// Immutable, fully derived views of the settings and the cell that publishes them to every thread.
+#pragma once
+
+#include "SpellGems/Core/ConfigValues.h"
+#include "SpellGems/Core/GemRuleTable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace SpellGems
+{
+	inline constexpr float kSecondsPerGameDay = 60.0f * 60.0f * 24.0f;
+
+	// Copies the settings the core consults and compiles the rule table.
+	GemRules MakeGemRules(const ConfigValues& values);
+
+	// Never modified once published; a holder sees one consistent set of settings for as long as it keeps it.
+	struct ConfigSnapshot
+	{
+		ConfigValues values{};
+		GemRules rules{};
+		// Distinct for every published snapshot, so a cached cast plan can tell it was built from another.
+		std::uint32_t generation{};
+	};
+
+	using ConfigSnapshotPtr = std::shared_ptr<const ConfigSnapshot>;
+
+	// Readers take the current snapshot with one atomic load from any thread. Writers are serialized, copy the
+	// current values, edit the copy and swap in a new snapshot; readers never see a half-applied edit.
+	class ConfigPublisher
+	{
+	public:
+		ConfigPublisher();
+
+		ConfigSnapshotPtr Get() const;
+
+		// Publishes values as they are. Returns the new snapshot.
+		ConfigSnapshotPtr Publish(const ConfigValues& values);
+
+		// Applies edit to a copy of the current values and publishes the result. An edit that returns bool can
+		// veto the change by returning false; nothing is published then and null is returned.
+		template <class Fn>
+		ConfigSnapshotPtr Update(Fn&& edit)
+		{
+			std::lock_guard lock(writeMutex_);
+			auto values = current_.load(std::memory_order_acquire)->values;
+			if constexpr (std::is_same_v<std::invoke_result_t<Fn&, ConfigValues&>, bool>) {
+				if (!edit(values)) {
+					return nullptr;
+				}
+			} else {
+				edit(values);
+			}
+			return PublishLocked(values);
+		}
+
+	private:
+		ConfigSnapshotPtr PublishLocked(const ConfigValues& values);
+
+		std::atomic<ConfigSnapshotPtr> current_;
+		std::mutex writeMutex_;
+	};
+}
@@ -0,0 +1,42 @@
+// Every user setting with its default, as the INI stores it; shared by Config and the INI parser.
+#pragma once
+
+#include "SpellGems/Core/GemTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SpellGems
+{
+	inline constexpr std::size_t kActivationSlotCount = 5;
+	inline constexpr std::uint8_t kMinStoredGems = 3;
+	inline constexpr std::uint8_t kMaxStoredGems = 5;
+	inline constexpr float kMaxFocusSpellDuration = 3.0f;
+	inline constexpr std::size_t kMaxGemRules = 64;
+
+	struct ConfigValues
+	{
+		std::array<TierSettings, kTierCount> tiers{ { { 3.0f, 10 }, { 6.0f, 8 }, { 12.0f, 6 }, { 20.0f, 4 }, { 30.0f, 3 } } };
+		std::array<std::uint32_t, kTierCount> fragmentCounts{ 1, 1, 1, 1, 1 };
+		std::array<std::uint32_t, kActivationSlotCount> activationKeys{ 2, 3, 4, 5, 6 };
+		std::uint32_t storeKey{ 0x4C };
+		std::uint32_t fragmentFormId{ 0x00067181 };
+		float focusSpellDuration{ 2.0f };
+		float starCooldown{ 3.0f };
+		std::uint8_t maxStoredGems{ kMaxStoredGems };
+		bool finiteUse{ true };
+		bool showUsesRemaining{ true };
+		bool compressSaveData{ false };
+		bool requireFilledSoulGem{ true };
+		bool allowAnyGemTier{ false };
+		bool blackSoulGemBoosts{ true };
+		bool normalGemPenalty{ true };
+		bool azurasStarBoost{ true };
+		// [Rules] in file order; later rules win.
+		std::vector<GemRule> rules;
+
+		friend bool operator==(const ConfigValues&, const ConfigValues&) = default;
+	};
+}
@@ -0,0 +1,191 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                Config Writer                                                //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/ConfigWriter.h"
+
+#include "SpellGems/Core/ConfigIni.h"
+
+#include <algorithm>
+#include <string>
+
+#if defined(_WIN32)
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <Windows.h>
+#else
+#	include <cerrno>
+#	include <cstdio>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+namespace SpellGems
+{
+	namespace
+	{
+#if defined(_WIN32)
+		bool WriteAndSync(const std::filesystem::path& path, std::string_view contents)
+		{
+			const HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				return false;
+			}
+			DWORD written = 0;
+			const bool ok = WriteFile(file, contents.data(), static_cast<DWORD>(contents.size()), &written, nullptr) &&
+				written == contents.size() && FlushFileBuffers(file);
+			CloseHandle(file);
+			return ok;
+		}
+
+		bool ReplaceWith(const std::filesystem::path& from, const std::filesystem::path& to)
+		{
+			return MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+		}
+#else
+		bool WriteAndSync(const std::filesystem::path& path, std::string_view contents)
+		{
+			const int file = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if (file < 0) {
+				return false;
+			}
+			bool ok = true;
+			while (ok && !contents.empty()) {
+				const auto written = write(file, contents.data(), contents.size());
+				if (written < 0 && errno == EINTR) {
+					continue;
+				}
+				ok = written > 0;
+				contents.remove_prefix(ok ? static_cast<std::size_t>(written) : 0);
+			}
+			ok = ok && fsync(file) == 0;
+			return close(file) == 0 && ok;
+		}
+
+		// The rename is only durable once the directory entry is: sync the parent too, and count a failure there as a
+		// failed write.
+		bool ReplaceWith(const std::filesystem::path& from, const std::filesystem::path& to)
+		{
+			if (std::rename(from.c_str(), to.c_str()) != 0) {
+				return false;
+			}
+			const auto parent = to.has_parent_path() ? to.parent_path() : std::filesystem::path{ "." };
+			const int directory = open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if (directory < 0) {
+				return false;
+			}
+			const bool synced = fsync(directory) == 0;
+			return close(directory) == 0 && synced;
+		}
+#endif
+	}
+
+	// The worker starts last, after every member it touches is constructed.
+	ConfigWriter::ConfigWriter(Clock::duration coalesceDelay, Callback onWritten) :
+		coalesceDelay_(coalesceDelay),
+		onWritten_(std::move(onWritten)),
+		worker_([this](std::stop_token stop) { Run(stop); })
+	{
+	}
+
+	ConfigWriter::~ConfigWriter()
+	{
+		worker_.request_stop();
+		if (worker_.joinable()) {
+			worker_.join();
+		}
+	}
+
+	// Replaces any snapshot still waiting; only the newest is worth writing.
+	void ConfigWriter::Submit(std::filesystem::path path, ConfigSnapshotPtr snapshot)
+	{
+		{
+			std::scoped_lock lock(mutex_);
+			if (pending_) {
+				++stats_.superseded;
+			}
+			pendingPath_ = std::move(path);
+			pending_ = std::move(snapshot);
+			++stats_.submitted;
+		}
+		wake_.notify_one();
+	}
+
+	bool ConfigWriter::WaitIdle(std::chrono::milliseconds timeout) const
+	{
+		std::unique_lock lock(mutex_);
+		return idle_.wait_for(lock, timeout, [this]() { return !pending_ && !busy_; });
+	}
+
+	ConfigWriter::Stats ConfigWriter::GetStats() const
+	{
+		std::scoped_lock lock(mutex_);
+		return stats_;
+	}
+
+	bool ConfigWriter::WriteFileAtomically(const std::filesystem::path& path, std::string_view contents)
+	{
+		std::error_code error;
+		if (path.has_parent_path()) {
+			std::filesystem::create_directories(path.parent_path(), error);
+		}
+
+		auto temporary = path;
+		temporary += ".tmp";
+		if (WriteAndSync(temporary, contents) && ReplaceWith(temporary, path)) {
+			return true;
+		}
+		std::filesystem::remove(temporary, error);
+		return false;
+	}
+
+	// A stop request still writes whatever is pending, so a save made just before shutdown is not lost.
+	void ConfigWriter::Run(std::stop_token stop)
+	{
+		std::unique_lock lock(mutex_);
+		for (;;) {
+			if (!wake_.wait(lock, stop, [this]() { return pending_ != nullptr; }) && !pending_) {
+				return;
+			}
+
+			// Let a burst of submissions settle; each one replaces pending_.
+			if (coalesceDelay_ > Clock::duration::zero()) {
+				const auto deadline = Clock::now() + coalesceDelay_;
+				wake_.wait_until(lock, stop, deadline, []() { return false; });
+			}
+
+			auto snapshot = std::move(pending_);
+			const auto path = std::move(pendingPath_);
+			busy_ = true;
+			lock.unlock();
+
+			const auto start = Clock::now();
+			std::string contents;
+			ConfigIni::Write(snapshot->values, contents);
+			const bool written = WriteFileAtomically(path, contents);
+			const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+			snapshot.reset();
+			if (onWritten_) {
+				onWritten_(path, written);
+			}
+
+			lock.lock();
+			busy_ = false;
+			++(written ? stats_.written : stats_.failed);
+			stats_.lastWriteUs = elapsedUs;
+			stats_.maxWriteUs = std::max(stats_.maxWriteUs, static_cast<std::int64_t>(elapsedUs));
+			idle_.notify_all();
+			if (stop.stop_requested() && !pending_) {
+				return;
+			}
+		}
+	}
+}
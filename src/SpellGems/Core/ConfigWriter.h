@@ -0,0 +1,69 @@
+// Worker thread that writes config snapshots to disk without ever leaving a partial file behind.
+#pragma once
+
+#include "SpellGems/Core/ConfigSnapshot.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+
+namespace SpellGems
+{
+	// Callers submit a snapshot and return at once. The worker waits out the coalescing delay, serializes only the
+	// newest snapshot into one buffer, writes it to a temporary file beside the target, flushes it to disk and
+	// renames it over the target. A crash at any point leaves either the old file or the new one.
+	class ConfigWriter
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		// Runs on the worker thread after each attempt.
+		using Callback = std::function<void(const std::filesystem::path& path, bool written)>;
+
+		struct Stats
+		{
+			std::uint64_t submitted;
+			std::uint64_t written;
+			std::uint64_t superseded;
+			std::uint64_t failed;
+			std::int64_t lastWriteUs;
+			std::int64_t maxWriteUs;
+		};
+
+		ConfigWriter(Clock::duration coalesceDelay, Callback onWritten);
+		~ConfigWriter();
+
+		ConfigWriter(const ConfigWriter&) = delete;
+		ConfigWriter& operator=(const ConfigWriter&) = delete;
+
+		void Submit(std::filesystem::path path, ConfigSnapshotPtr snapshot);
+
+		// Blocks until nothing is pending or being written. Returns false on timeout.
+		bool WaitIdle(std::chrono::milliseconds timeout) const;
+
+		Stats GetStats() const;
+
+		// Writes contents to path through a flushed temporary file and an atomic rename, creating the directory
+		// if needed. Returns false, leaving any existing file untouched, when a step fails.
+		static bool WriteFileAtomically(const std::filesystem::path& path, std::string_view contents);
+
+	private:
+		void Run(std::stop_token stop);
+
+		const Clock::duration coalesceDelay_;
+		const Callback onWritten_;
+		mutable std::mutex mutex_;
+		std::condition_variable_any wake_;
+		mutable std::condition_variable idle_;
+		std::filesystem::path pendingPath_;
+		ConfigSnapshotPtr pending_;
+		bool busy_{};
+		Stats stats_{};
+		std::jthread worker_;
+	};
+}
@@ -0,0 +1,186 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                   CRC32C                                                    //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/Crc32c.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#	define SPELLGEMS_CRC32C_X64 1
+#	include <nmmintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#	else
+#		include <cpuid.h>
+#	endif
+#endif
+
+namespace SpellGems::Crc32c
+{
+	namespace
+	{
+		constexpr std::uint32_t kPolynomial = 0x82F63B78;
+
+		// Table k advances a byte through k further zero bytes, so eight lookups consume eight bytes at once.
+		constexpr std::array<std::array<std::uint32_t, 256>, 8> MakeTables()
+		{
+			std::array<std::array<std::uint32_t, 256>, 8> tables{};
+			for (std::uint32_t i = 0; i < 256; ++i) {
+				auto crc = i;
+				for (int bit = 0; bit < 8; ++bit) {
+					crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+				}
+				tables[0][i] = crc;
+			}
+			for (std::size_t k = 1; k < 8; ++k) {
+				for (std::size_t i = 0; i < 256; ++i) {
+					tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+				}
+			}
+			return tables;
+		}
+
+		constexpr auto kTables = MakeTables();
+
+		// Raw register update without the pre- and post-inversion.
+		std::uint32_t UpdateSoftware(std::uint32_t crc, const std::uint8_t* data, std::size_t size)
+		{
+			while (size >= 8) {
+				const std::uint32_t low = crc ^ (static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8) |
+				                                 (static_cast<std::uint32_t>(data[2]) << 16) | (static_cast<std::uint32_t>(data[3]) << 24));
+				crc = kTables[7][low & 0xFF] ^ kTables[6][(low >> 8) & 0xFF] ^ kTables[5][(low >> 16) & 0xFF] ^
+				      kTables[4][low >> 24] ^ kTables[3][data[4]] ^ kTables[2][data[5]] ^ kTables[1][data[6]] ^
+				      kTables[0][data[7]];
+				data += 8;
+				size -= 8;
+			}
+			while (size-- > 0) {
+				crc = (crc >> 8) ^ kTables[0][(crc ^ *data++) & 0xFF];
+			}
+			return crc;
+		}
+
+#if SPELLGEMS_CRC32C_X64
+		// The crc32 instruction has a latency of three cycles but issues every cycle, so the hardware path runs three
+		// independent streams over consecutive lanes and folds them together. Folding advances a register over a
+		// lane's worth of zero bytes, which is linear in the register and so four table lookups.
+		constexpr std::size_t kLaneSize = 256;
+
+		using ShiftTables = std::array<std::array<std::uint32_t, 256>, 4>;
+
+		const ShiftTables& GetShiftTables()
+		{
+			static const ShiftTables tables = [] {
+				ShiftTables result{};
+				for (std::size_t k = 0; k < 4; ++k) {
+					for (std::uint32_t i = 0; i < 256; ++i) {
+						auto crc = i << (8 * k);
+						for (std::size_t zero = 0; zero < kLaneSize; ++zero) {
+							crc = (crc >> 8) ^ kTables[0][crc & 0xFF];
+						}
+						result[k][i] = crc;
+					}
+				}
+				return result;
+			}();
+			return tables;
+		}
+
+		std::uint32_t ShiftLane(const ShiftTables& tables, std::uint32_t crc)
+		{
+			return tables[0][crc & 0xFF] ^ tables[1][(crc >> 8) & 0xFF] ^ tables[2][(crc >> 16) & 0xFF] ^ tables[3][crc >> 24];
+		}
+
+		std::uint64_t Load64(const std::uint8_t* data)
+		{
+			std::uint64_t word;
+			std::memcpy(&word, data, sizeof(word));
+			return word;
+		}
+
+#	if defined(__GNUC__) || defined(__clang__)
+		__attribute__((target("sse4.2")))
+#	endif
+		std::uint32_t UpdateHardware(std::uint32_t crc, const std::uint8_t* data, std::size_t size)
+		{
+			if (size >= 3 * kLaneSize) {
+				const auto& tables = GetShiftTables();
+				do {
+					std::uint64_t first = crc;
+					std::uint64_t second = 0;
+					std::uint64_t third = 0;
+					for (std::size_t i = 0; i < kLaneSize; i += 8) {
+						first = _mm_crc32_u64(first, Load64(data + i));
+						second = _mm_crc32_u64(second, Load64(data + kLaneSize + i));
+						third = _mm_crc32_u64(third, Load64(data + 2 * kLaneSize + i));
+					}
+					crc = ShiftLane(tables, ShiftLane(tables, static_cast<std::uint32_t>(first)) ^ static_cast<std::uint32_t>(second)) ^
+					      static_cast<std::uint32_t>(third);
+					data += 3 * kLaneSize;
+					size -= 3 * kLaneSize;
+				} while (size >= 3 * kLaneSize);
+			}
+
+			std::uint64_t wide = crc;
+			while (size >= 8) {
+				wide = _mm_crc32_u64(wide, Load64(data));
+				data += 8;
+				size -= 8;
+			}
+			auto narrow = static_cast<std::uint32_t>(wide);
+			while (size-- > 0) {
+				narrow = _mm_crc32_u8(narrow, *data++);
+			}
+			return narrow;
+		}
+
+		bool DetectHardware()
+		{
+#	if defined(_MSC_VER)
+			int info[4]{};
+			__cpuid(info, 1);
+			return (info[2] & (1 << 20)) != 0;
+#	else
+			unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+			return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+#	endif
+		}
+#endif
+	}
+
+	std::uint32_t Compute(std::span<const std::uint8_t> data)
+	{
+		return Extend(0, data);
+	}
+
+	std::uint32_t Extend(std::uint32_t crc, std::span<const std::uint8_t> data)
+	{
+#if SPELLGEMS_CRC32C_X64
+		if (HasHardware()) {
+			return ~UpdateHardware(~crc, data.data(), data.size());
+		}
+#endif
+		return ~UpdateSoftware(~crc, data.data(), data.size());
+	}
+
+	std::uint32_t ExtendSoftware(std::uint32_t crc, std::span<const std::uint8_t> data)
+	{
+		return ~UpdateSoftware(~crc, data.data(), data.size());
+	}
+
+	bool HasHardware()
+	{
+#if SPELLGEMS_CRC32C_X64
+		static const bool hasHardware = DetectHardware();
+		return hasHardware;
+#else
+		return false;
+#endif
+	}
+}
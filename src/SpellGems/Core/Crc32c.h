@@ -0,0 +1,19 @@
+// CRC32C (Castagnoli) checksums for co-save records: SSE4.2 when the CPU has it, slicing-by-8 otherwise.
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace SpellGems::Crc32c
+{
+	// Standard CRC32C of data; Compute("123456789") is 0xE3069283.
+	std::uint32_t Compute(std::span<const std::uint8_t> data);
+
+	// Continues a CRC returned by Compute or Extend over more data.
+	std::uint32_t Extend(std::uint32_t crc, std::span<const std::uint8_t> data);
+
+	// The table-driven path on its own, for comparison and for hosts without the instruction.
+	std::uint32_t ExtendSoftware(std::uint32_t crc, std::span<const std::uint8_t> data);
+
+	bool HasHardware();
+}
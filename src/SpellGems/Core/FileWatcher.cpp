@@ -0,0 +1,269 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                 File Watcher                                                //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/FileWatcher.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <Windows.h>
+#elif defined(__linux__)
+#	include <poll.h>
+#	include <sys/eventfd.h>
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#endif
+
+namespace SpellGems
+{
+	namespace
+	{
+		[[maybe_unused]] int ToMilliseconds(FileWatcher::Clock::duration duration)
+		{
+			const auto ms = std::chrono::ceil<std::chrono::milliseconds>(duration).count();
+			return static_cast<int>(std::clamp<std::int64_t>(ms, 0, 60'000));
+		}
+	}
+
+#if defined(_WIN32)
+	// A change notification on the file's directory plus an event Stop sets.
+	struct FileWatcher::Native
+	{
+		HANDLE change{ INVALID_HANDLE_VALUE };
+		HANDLE stop{ nullptr };
+
+		bool Open(const std::filesystem::path& directory)
+		{
+			stop = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+			change = FindFirstChangeNotificationW(directory.c_str(), FALSE,
+				FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME);
+			return stop && change != INVALID_HANDLE_VALUE;
+		}
+
+		// Returns false when stop was signalled.
+		bool Wait(Clock::duration timeout)
+		{
+			const HANDLE handles[2]{ stop, change };
+			const auto result = WaitForMultipleObjects(2, handles, FALSE, static_cast<DWORD>(ToMilliseconds(timeout)));
+			if (result == WAIT_OBJECT_0 + 1) {
+				FindNextChangeNotification(change);
+			}
+			return result != WAIT_OBJECT_0;
+		}
+
+		void Signal() { SetEvent(stop); }
+
+		~Native()
+		{
+			if (change != INVALID_HANDLE_VALUE) {
+				FindCloseChangeNotification(change);
+			}
+			if (stop) {
+				CloseHandle(stop);
+			}
+		}
+	};
+#elif defined(__linux__)
+	// inotify on the file's directory plus an eventfd Stop writes.
+	struct FileWatcher::Native
+	{
+		int notify{ -1 };
+		int stop{ -1 };
+
+		bool Open(const std::filesystem::path& directory)
+		{
+			notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			stop = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			return notify >= 0 && stop >= 0 &&
+				inotify_add_watch(notify, directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE) >= 0;
+		}
+
+		bool Wait(Clock::duration timeout)
+		{
+			pollfd fds[2]{ { stop, POLLIN, 0 }, { notify, POLLIN, 0 } };
+			if (poll(fds, 2, ToMilliseconds(timeout)) > 0 && (fds[1].revents & POLLIN) != 0) {
+				alignas(inotify_event) char buffer[4096];
+				while (read(notify, buffer, sizeof(buffer)) > 0) {
+				}
+			}
+			return (fds[0].revents & POLLIN) == 0;
+		}
+
+		void Signal()
+		{
+			const std::uint64_t one = 1;
+			[[maybe_unused]] const auto written = write(stop, &one, sizeof(one));
+		}
+
+		~Native()
+		{
+			if (notify >= 0) {
+				close(notify);
+			}
+			if (stop >= 0) {
+				close(stop);
+			}
+		}
+	};
+#else
+	struct FileWatcher::Native
+	{
+		bool Open(const std::filesystem::path&) { return false; }
+		bool Wait(Clock::duration) { return true; }
+		void Signal() {}
+	};
+#endif
+
+	FileWatcher::FileWatcher() = default;
+
+	FileWatcher::~FileWatcher()
+	{
+		Stop();
+	}
+
+	bool FileWatcher::Start(std::filesystem::path file, Callback onChanged, Settings settings)
+	{
+		if (thread_.joinable()) {
+			return false;
+		}
+
+		file_ = std::move(file);
+		onChanged_ = std::move(onChanged);
+		settings_ = settings;
+		stopping_ = false;
+		baseline_ = ReadStamp(file_);
+
+		native_.reset();
+		if (settings_.allowNative) {
+			auto native = std::make_unique<Native>();
+			const auto directory = file_.has_parent_path() ? file_.parent_path() : std::filesystem::path(".");
+			if (native->Open(directory)) {
+				native_ = std::move(native);
+			}
+		}
+		backend_.store(native_ ? Backend::Native : Backend::Polling, std::memory_order_relaxed);
+		thread_ = std::thread([this]() { Run(); });
+		return true;
+	}
+
+	void FileWatcher::Stop()
+	{
+		if (!thread_.joinable()) {
+			return;
+		}
+
+		{
+			std::lock_guard lock(mutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+		if (native_) {
+			native_->Signal();
+		}
+		thread_.join();
+		native_.reset();
+		backend_.store(Backend::None, std::memory_order_relaxed);
+	}
+
+	void FileWatcher::Acknowledge()
+	{
+		const auto stamp = ReadStamp(file_);
+		std::lock_guard lock(mutex_);
+		baseline_ = stamp;
+	}
+
+	FileWatcher::Backend FileWatcher::GetBackend() const
+	{
+		return backend_.load(std::memory_order_relaxed);
+	}
+
+	FileWatcher::Stats FileWatcher::GetStats() const
+	{
+		return {
+			wakeups_.load(std::memory_order_relaxed),
+			changes_.load(std::memory_order_relaxed),
+			fired_.load(std::memory_order_relaxed),
+			suppressed_.load(std::memory_order_relaxed)
+		};
+	}
+
+	FileWatcher::Stamp FileWatcher::ReadStamp(const std::filesystem::path& file)
+	{
+		std::error_code error;
+		Stamp stamp{};
+		stamp.writeTime = std::filesystem::last_write_time(file, error);
+		if (error) {
+			return {};
+		}
+		stamp.size = std::filesystem::file_size(file, error);
+		stamp.exists = !error;
+		return stamp.exists ? stamp : Stamp{};
+	}
+
+	bool FileWatcher::Wait(Clock::duration timeout)
+	{
+		if (native_) {
+			return native_->Wait(timeout);
+		}
+		std::unique_lock lock(mutex_);
+		return !wake_.wait_for(lock, timeout, [this]() { return stopping_; });
+	}
+
+	// A change is reported once the stamp has held still for the debounce period, and only if it still differs
+	// from the last state reported or acknowledged.
+	void FileWatcher::Run()
+	{
+		Stamp seen = [this]() {
+			std::lock_guard lock(mutex_);
+			return baseline_;
+		}();
+		bool pending = false;
+		auto lastChange = Clock::now();
+
+		while (Wait(pending ? settings_.debounce : settings_.pollInterval)) {
+			{
+				std::lock_guard lock(mutex_);
+				if (stopping_) {
+					break;
+				}
+			}
+			wakeups_.fetch_add(1, std::memory_order_relaxed);
+
+			const auto stamp = ReadStamp(file_);
+			const auto now = Clock::now();
+			if (stamp != seen) {
+				seen = stamp;
+				lastChange = now;
+				pending = true;
+				changes_.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+			if (!pending || now - lastChange < settings_.debounce) {
+				continue;
+			}
+
+			pending = false;
+			{
+				std::lock_guard lock(mutex_);
+				if (stamp == baseline_) {
+					suppressed_.fetch_add(1, std::memory_order_relaxed);
+					continue;
+				}
+				baseline_ = stamp;
+			}
+			fired_.fetch_add(1, std::memory_order_relaxed);
+			onChanged_();
+		}
+	}
+}
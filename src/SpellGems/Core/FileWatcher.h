@@ -0,0 +1,97 @@
+// Background watcher that reports debounced changes to a single file.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace SpellGems
+{
+	// Watches one file from a worker thread. Changes are detected by comparing its write time and size; the
+	// native backend (directory change notifications on Windows, inotify on Linux) only wakes the worker early,
+	// the polling backend wakes it every pollInterval. A burst of writes is reported once, after the file has
+	// been quiet for the debounce period. The callback runs on the worker thread.
+	class FileWatcher
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		using Callback = std::function<void()>;
+
+		enum class Backend : std::uint8_t
+		{
+			None,
+			Polling,
+			Native
+		};
+
+		struct Settings
+		{
+			Clock::duration pollInterval{ std::chrono::seconds(1) };
+			Clock::duration debounce{ std::chrono::milliseconds(300) };
+			bool allowNative{ true };
+		};
+
+		struct Stats
+		{
+			std::uint64_t wakeups;
+			std::uint64_t changes;
+			std::uint64_t fired;
+			std::uint64_t suppressed;
+		};
+
+		FileWatcher();
+		~FileWatcher();
+
+		FileWatcher(const FileWatcher&) = delete;
+		FileWatcher& operator=(const FileWatcher&) = delete;
+
+		// Treats the file as it is now as seen. Returns false when already running.
+		bool Start(std::filesystem::path file, Callback onChanged, Settings settings);
+		void Stop();
+
+		// Adopts the file as it is now as seen, so a write the owner made itself is not reported back.
+		void Acknowledge();
+
+		Backend GetBackend() const;
+		Stats GetStats() const;
+
+	private:
+		struct Stamp
+		{
+			std::filesystem::file_time_type writeTime{};
+			std::uintmax_t size{};
+			bool exists{};
+
+			friend bool operator==(const Stamp&, const Stamp&) = default;
+		};
+
+		struct Native;
+
+		static Stamp ReadStamp(const std::filesystem::path& file);
+
+		void Run();
+		// Sleeps until the timeout, a native notification or Stop. Returns false once stopping.
+		bool Wait(Clock::duration timeout);
+
+		std::filesystem::path file_;
+		Callback onChanged_;
+		Settings settings_{};
+		std::unique_ptr<Native> native_;
+		std::thread thread_;
+		std::mutex mutex_;
+		std::condition_variable wake_;
+		bool stopping_{};
+		Stamp baseline_{};
+		std::atomic<Backend> backend_{ Backend::None };
+		std::atomic<std::uint64_t> wakeups_{ 0 };
+		std::atomic<std::uint64_t> changes_{ 0 };
+		std::atomic<std::uint64_t> fired_{ 0 };
+		std::atomic<std::uint64_t> suppressed_{ 0 };
+	};
+}
@@ -0,0 +1,85 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Gem Base Filter                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemBaseFilter.h"
+
+#include <algorithm>
+
+namespace SpellGems
+{
+	namespace
+	{
+		auto FindEntry(auto& entries, std::uint32_t baseId)
+		{
+			return std::lower_bound(entries.begin(), entries.end(), baseId, [](const auto& entry, std::uint32_t id) {
+				return entry.baseId < id;
+			});
+		}
+	}
+
+	// Counts another live gem for the base form.
+	void GemBaseFilter::Add(std::uint32_t baseId)
+	{
+		auto it = FindEntry(entries_, baseId);
+		if (it != entries_.end() && it->baseId == baseId) {
+			++it->count;
+			return;
+		}
+
+		entries_.insert(it, { baseId, 1 });
+		SetBits(baseId);
+	}
+
+	// Drops one live gem for the base form; the bloom bits are rebuilt when the form disappears entirely.
+	void GemBaseFilter::Remove(std::uint32_t baseId)
+	{
+		auto it = FindEntry(entries_, baseId);
+		if (it == entries_.end() || it->baseId != baseId) {
+			return;
+		}
+
+		if (--it->count == 0) {
+			entries_.erase(it);
+			RebuildBits();
+		}
+	}
+
+	void GemBaseFilter::Clear()
+	{
+		entries_.clear();
+		bits_.fill(0);
+	}
+
+	bool GemBaseFilter::Contains(std::uint32_t baseId) const
+	{
+		auto it = FindEntry(entries_, baseId);
+		return it != entries_.end() && it->baseId == baseId;
+	}
+
+	std::size_t GemBaseFilter::Size() const
+	{
+		return entries_.size();
+	}
+
+	void GemBaseFilter::SetBits(std::uint32_t baseId)
+	{
+		const auto hash = Hash(baseId);
+		const auto first = static_cast<std::uint32_t>(hash) & kBitMask;
+		const auto second = static_cast<std::uint32_t>(hash >> 32) & kBitMask;
+		bits_[first >> 6] |= std::uint64_t{ 1 } << (first & 63);
+		bits_[second >> 6] |= std::uint64_t{ 1 } << (second & 63);
+	}
+
+	void GemBaseFilter::RebuildBits()
+	{
+		bits_.fill(0);
+		for (const auto& entry : entries_) {
+			SetBits(entry.baseId);
+		}
+	}
+}
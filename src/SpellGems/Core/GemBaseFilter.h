@@ -0,0 +1,54 @@
+// Compact membership filter over the base form IDs of live stored gems.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace SpellGems
+{
+	// A 1024-bit bloom filter answers the hot "is this form a stored gem?" question in a few instructions;
+	// a counted flat set behind it keeps the answer exact and lets removals rebuild the bloom bits.
+	class GemBaseFilter
+	{
+	public:
+		void Add(std::uint32_t baseId);
+		void Remove(std::uint32_t baseId);
+		void Clear();
+
+		bool MayContain(std::uint32_t baseId) const
+		{
+			const auto hash = Hash(baseId);
+			const auto first = static_cast<std::uint32_t>(hash) & kBitMask;
+			const auto second = static_cast<std::uint32_t>(hash >> 32) & kBitMask;
+			return (bits_[first >> 6] & (std::uint64_t{ 1 } << (first & 63))) != 0 &&
+			       (bits_[second >> 6] & (std::uint64_t{ 1 } << (second & 63))) != 0;
+		}
+
+		bool Contains(std::uint32_t baseId) const;
+		std::size_t Size() const;
+
+	private:
+		static constexpr std::uint32_t kBits = 1024;
+		static constexpr std::uint32_t kBitMask = kBits - 1;
+
+		struct Entry
+		{
+			std::uint32_t baseId;
+			std::uint32_t count;
+		};
+
+		static std::uint64_t Hash(std::uint32_t baseId)
+		{
+			// Fibonacci multiply; the two 32-bit halves give independent bit positions.
+			const auto mixed = (static_cast<std::uint64_t>(baseId) ^ (static_cast<std::uint64_t>(baseId) << 29)) * 0x9E3779B97F4A7C15ull;
+			return mixed ^ (mixed >> 31);
+		}
+
+		void SetBits(std::uint32_t baseId);
+		void RebuildBits();
+
+		std::array<std::uint64_t, kBits / 64> bits_{};
+		std::vector<Entry> entries_;
+	};
+}
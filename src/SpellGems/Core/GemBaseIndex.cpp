@@ -0,0 +1,71 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                Gem Base Index                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemBaseIndex.h"
+
+#include <algorithm>
+
+namespace SpellGems
+{
+	void GemBaseIndex::Insert(const GemKey& key)
+	{
+		auto& ids = instances_[key.baseId];
+		auto it = std::lower_bound(ids.begin(), ids.end(), key.uniqueId);
+		if (it == ids.end() || *it != key.uniqueId) {
+			ids.insert(it, key.uniqueId);
+		}
+	}
+
+	// Drops the base entirely once its last instance goes, so lookups for spent gems miss in one probe.
+	void GemBaseIndex::Erase(const GemKey& key)
+	{
+		auto found = instances_.find(key.baseId);
+		if (found == instances_.end()) {
+			return;
+		}
+
+		auto& ids = found->second;
+		auto it = std::lower_bound(ids.begin(), ids.end(), key.uniqueId);
+		if (it != ids.end() && *it == key.uniqueId) {
+			ids.erase(it);
+		}
+		if (ids.empty()) {
+			instances_.erase(found);
+		}
+	}
+
+	void GemBaseIndex::Clear()
+	{
+		instances_.clear();
+	}
+
+	bool GemBaseIndex::TryGetFirst(FormID baseId, GemKey& key) const
+	{
+		auto found = instances_.find(baseId);
+		if (found == instances_.end() || found->second.empty()) {
+			return false;
+		}
+
+		key = { baseId, found->second.front() };
+		return true;
+	}
+
+	std::span<const std::uint16_t> GemBaseIndex::GetInstances(FormID baseId) const
+	{
+		auto found = instances_.find(baseId);
+		if (found == instances_.end()) {
+			return {};
+		}
+		return found->second;
+	}
+
+	std::size_t GemBaseIndex::GetBaseCount() const
+	{
+		return instances_.size();
+	}
+}
@@ -0,0 +1,28 @@
+// Secondary index from a stored gem's base form to its unique instances.
+#pragma once
+
+#include "SpellGems/Core/GemTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace SpellGems
+{
+	// Instances are kept sorted by uniqueId, so "first" is stable and matches slot order.
+	class GemBaseIndex
+	{
+	public:
+		void Insert(const GemKey& key);
+		void Erase(const GemKey& key);
+		void Clear();
+
+		bool TryGetFirst(FormID baseId, GemKey& key) const;
+		std::span<const std::uint16_t> GetInstances(FormID baseId) const;
+		std::size_t GetBaseCount() const;
+
+	private:
+		std::unordered_map<FormID, std::vector<std::uint16_t>> instances_;
+	};
+}
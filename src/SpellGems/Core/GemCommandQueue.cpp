@@ -0,0 +1,81 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Gem Command Queue                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemCommandQueue.h"
+
+namespace SpellGems
+{
+	// Returns the singleton command queue shared by input callbacks and the main thread.
+	GemCommandQueue& GemCommandQueue::GetSingleton()
+	{
+		static GemCommandQueue instance;
+		return instance;
+	}
+
+	// Posts a command from any thread. Returns false and counts a drop when the ring is full.
+	bool GemCommandQueue::Push(GemCommandType type, std::size_t slot)
+	{
+		GemCommand command{};
+		command.type = type;
+		command.slot = static_cast<std::uint8_t>(slot);
+		return Push(command);
+	}
+
+	// Posts a command aimed at one stored gem rather than an activation slot.
+	bool GemCommandQueue::Push(GemCommandType type, const GemKey& key)
+	{
+		GemCommand command{};
+		command.type = type;
+		command.key = key;
+		return Push(command);
+	}
+
+	bool GemCommandQueue::Push(GemCommand command)
+	{
+		command.enqueuedAt = Clock::now().time_since_epoch().count();
+		if (!queue_.TryPush(command)) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		pushed_.fetch_add(1, std::memory_order_relaxed);
+		const auto depth = queue_.SizeApprox();
+		auto maxDepth = maxDepth_.load(std::memory_order_relaxed);
+		while (depth > maxDepth && !maxDepth_.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed)) {
+		}
+		return true;
+	}
+
+	GemCommandQueue::Stats GemCommandQueue::GetStats() const
+	{
+		const auto drained = drained_.load(std::memory_order_relaxed);
+		const auto total = totalLatencyNs_.load(std::memory_order_relaxed);
+		return {
+			pushed_.load(std::memory_order_relaxed),
+			dropped_.load(std::memory_order_relaxed),
+			drained,
+			queue_.SizeApprox(),
+			maxDepth_.load(std::memory_order_relaxed),
+			lastLatencyNs_.load(std::memory_order_relaxed) / 1000,
+			maxLatencyNs_.load(std::memory_order_relaxed) / 1000,
+			drained > 0 ? total / static_cast<std::int64_t>(drained) / 1000 : 0
+		};
+	}
+
+	void GemCommandQueue::RecordLatency(const GemCommand& command)
+	{
+		const auto latency = Clock::now().time_since_epoch().count() - command.enqueuedAt;
+		const auto latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::duration(latency)).count();
+		lastLatencyNs_.store(latencyNs, std::memory_order_relaxed);
+		totalLatencyNs_.fetch_add(latencyNs, std::memory_order_relaxed);
+		if (latencyNs > maxLatencyNs_.load(std::memory_order_relaxed)) {
+			maxLatencyNs_.store(latencyNs, std::memory_order_relaxed);
+		}
+		drained_.fetch_add(1, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,90 @@
+// Commands posted from input callbacks and drained once per frame on the main thread.
+#pragma once
+
+#include "SpellGems/Core/GemTypes.h"
+#include "SpellGems/Core/MpscQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace SpellGems
+{
+	enum class GemCommandType : std::uint8_t
+	{
+		Store,
+		Activate,
+		Release,
+		Refresh,
+		// Drops the stored gem at key.
+		Remove,
+		// Brings every stored gem's uses in line with the current FiniteUse setting.
+		ReapplyUses,
+		// Rebuilds the menu's stored gem rows even though nothing they track changed.
+		RefreshRows
+	};
+
+	struct GemCommand
+	{
+		std::int64_t enqueuedAt{};
+		GemCommandType type{ GemCommandType::Refresh };
+		std::uint8_t slot{};
+		GemKey key{};
+	};
+
+	class GemCommandQueue
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t kCapacity = 256;
+
+		struct Stats
+		{
+			std::uint64_t pushed;
+			std::uint64_t dropped;
+			std::uint64_t drained;
+			std::size_t depth;
+			std::size_t maxDepth;
+			std::int64_t lastLatencyUs;
+			std::int64_t maxLatencyUs;
+			std::int64_t averageLatencyUs;
+		};
+
+		static GemCommandQueue& GetSingleton();
+
+		GemCommandQueue() = default;
+
+		bool Push(GemCommandType type, std::size_t slot = 0);
+		bool Push(GemCommandType type, const GemKey& key);
+
+		// Pops every queued command and hands it to the handler. Main thread only.
+		template <class Handler>
+		std::size_t Drain(Handler&& handler)
+		{
+			std::size_t count = 0;
+			GemCommand command{};
+			while (queue_.TryPop(command)) {
+				RecordLatency(command);
+				handler(command);
+				++count;
+			}
+			return count;
+		}
+
+		Stats GetStats() const;
+
+	private:
+		bool Push(GemCommand command);
+		void RecordLatency(const GemCommand& command);
+
+		MpscQueue<GemCommand, kCapacity> queue_;
+		std::atomic<std::uint64_t> pushed_{ 0 };
+		std::atomic<std::uint64_t> dropped_{ 0 };
+		std::atomic<std::uint64_t> drained_{ 0 };
+		std::atomic<std::size_t> maxDepth_{ 0 };
+		std::atomic<std::int64_t> lastLatencyNs_{ 0 };
+		std::atomic<std::int64_t> maxLatencyNs_{ 0 };
+		std::atomic<std::int64_t> totalLatencyNs_{ 0 };
+	};
+}
@@ -0,0 +1,128 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Spell Gem Core                                                //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemCore.h"
+
+#include "SpellGems/Core/ConfigSnapshot.h"
+
+namespace SpellGems
+{
+	GemCore::GemCore(GemStore& store, IFormLookup& forms, IInventory& inventory, ICaster& caster, ICalendar& calendar) :
+		store_(store),
+		forms_(forms),
+		inventory_(inventory),
+		caster_(caster),
+		calendar_(calendar)
+	{
+	}
+
+	// Records a stored spell. Existing keys are only replaced when overwriting is allowed (reusable stars).
+	bool GemCore::Store(const GemKey& key, const StoredSpellData& data, bool allowOverwrite)
+	{
+		if (!allowOverwrite && store_.Has(key)) {
+			return false;
+		}
+
+		store_.Store(key, data);
+		return true;
+	}
+
+	// Casts the gem in the given slot if it is off cooldown, then consumes one use.
+	ActivateResult GemCore::Activate(std::size_t slot, const GemRules& rules)
+	{
+		ActivateResult result{};
+		const auto* slotKey = store_.GetSlotIndex().At(slot);
+		if (!slotKey) {
+			return result;
+		}
+
+		result.key = *slotKey;
+		const auto& table = store_.GetEntries();
+		const auto index = table.FindIndex(result.key);
+		if (index == GemTable::kNotFound) {
+			result.status = ActivateStatus::MissingEntry;
+			return result;
+		}
+
+		const auto spellId = table.GetSpellId(index);
+		std::uint8_t schoolMask = 0;
+		if (!forms_.TryGetSpellSchools(spellId, schoolMask)) {
+			result.status = ActivateStatus::MissingSpell;
+			return result;
+		}
+
+		// The cooldown gate only touches the hot fields and one table cell; the full entry is assembled once the
+		// cast goes ahead.
+		const auto& hot = table.GetHot(index);
+		const auto gem = GetGemClass((hot.flags & GemTable::kReusableStar) != 0, (hot.flags & GemTable::kBlackSoulGem) != 0);
+		const auto& outcome = rules.outcomes.Find(spellId, hot.tier, schoolMask, gem);
+		const float timescale = calendar_.GetTimescale();
+		const float cooldownDays = outcome.cooldownDays * timescale;
+		const float now = calendar_.GetCurrentGameTime();
+		if (hot.lastUsedGameTime > 0.0f && now - hot.lastUsedGameTime < cooldownDays) {
+			const float remainingDays = cooldownDays - (now - hot.lastUsedGameTime);
+			result.status = ActivateStatus::OnCooldown;
+			result.cooldownRemaining = timescale > 0.0f ? remainingDays * kSecondsPerGameDay / timescale : 0.0f;
+			return result;
+		}
+
+		const auto stored = table.GetData(index);
+		if (!caster_.Cast(result.key, stored)) {
+			result.status = ActivateStatus::CastFailed;
+			return result;
+		}
+
+		StoredSpellData updated = stored;
+		updated.lastUsedGameTime = now;
+		result.status = ActivateStatus::Cast;
+		result.consumed = Consume(result.key, updated, rules);
+		result.usesRemaining = result.consumed == ConsumeStatus::Remaining ? updated.usesRemaining - 1 : updated.usesRemaining;
+		return result;
+	}
+
+	// Spends one use of a stored gem, removing it and granting fragments once it runs out.
+	ConsumeStatus GemCore::Consume(const GemKey& key, const StoredSpellData& data, const GemRules& rules)
+	{
+		if (data.usesRemaining < 0) {
+			store_.Store(key, data);
+			return ConsumeStatus::Unlimited;
+		}
+
+		const auto newUses = data.usesRemaining - 1;
+		if (newUses <= 0) {
+			store_.Remove(key);
+			inventory_.Remove(key.baseId, 1);
+			GrantFragments(key.baseId, rules);
+			return ConsumeStatus::Depleted;
+		}
+
+		StoredSpellData newData = data;
+		newData.usesRemaining = newUses;
+		store_.Store(key, newData);
+		return ConsumeStatus::Remaining;
+	}
+
+	GemStore& GemCore::GetStore()
+	{
+		return store_;
+	}
+
+	void GemCore::GrantFragments(FormID gemId, const GemRules& rules)
+	{
+		SpellTier tier{};
+		if (rules.fragmentFormId == 0 || !forms_.TryGetGemTier(gemId, tier)) {
+			return;
+		}
+
+		const auto tierIndex = static_cast<std::size_t>(tier);
+		const auto count = tierIndex < kTierCount ? rules.fragmentCounts[tierIndex] : 0;
+		if (count > 0) {
+			inventory_.Add(rules.fragmentFormId, static_cast<std::int32_t>(count));
+		}
+	}
+}
@@ -0,0 +1,59 @@
+// Game-independent store, activate and consume logic for stored spell gems.
+#pragma once
+
+#include "SpellGems/Core/GemRuleTable.h"
+#include "SpellGems/Core/GemStore.h"
+#include "SpellGems/Core/GemTypes.h"
+#include "SpellGems/Core/Interfaces.h"
+
+#include <cstdint>
+
+namespace SpellGems
+{
+	enum class ActivateStatus : std::uint8_t
+	{
+		NoGem,
+		MissingEntry,
+		MissingSpell,
+		OnCooldown,
+		CastFailed,
+		Cast
+	};
+
+	enum class ConsumeStatus : std::uint8_t
+	{
+		Unlimited,
+		Remaining,
+		Depleted
+	};
+
+	struct ActivateResult
+	{
+		ActivateStatus status{ ActivateStatus::NoGem };
+		ConsumeStatus consumed{ ConsumeStatus::Unlimited };
+		GemKey key{};
+		std::int32_t usesRemaining{};
+		float cooldownRemaining{};
+	};
+
+	class GemCore
+	{
+	public:
+		GemCore(GemStore& store, IFormLookup& forms, IInventory& inventory, ICaster& caster, ICalendar& calendar);
+
+		bool Store(const GemKey& key, const StoredSpellData& data, bool allowOverwrite);
+		ActivateResult Activate(std::size_t slot, const GemRules& rules);
+		ConsumeStatus Consume(const GemKey& key, const StoredSpellData& data, const GemRules& rules);
+
+		GemStore& GetStore();
+
+	private:
+		void GrantFragments(FormID gemId, const GemRules& rules);
+
+		GemStore& store_;
+		IFormLookup& forms_;
+		IInventory& inventory_;
+		ICaster& caster_;
+		ICalendar& calendar_;
+	};
+}
@@ -0,0 +1,192 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Gem ID Allocator                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemIdAllocator.h"
+
+#include <bit>
+
+namespace SpellGems
+{
+	namespace
+	{
+		constexpr std::uint64_t kAllBits = ~0ull;
+		constexpr std::size_t kEntrySize = 2 + 8;
+	}
+
+	GemIdAllocator::GemIdAllocator()
+	{
+		Reset();
+	}
+
+	std::uint16_t GemIdAllocator::Allocate()
+	{
+		if (used_ >= kIdCount) {
+			return 0;
+		}
+
+		// Free bits at or after the cursor in its own word first, then the next word with any free bit.
+		auto word = static_cast<std::size_t>(cursor_ >> 6);
+		auto free = ~words_[word] & (kAllBits << (cursor_ & 63));
+		if (free == 0) {
+			word = FindFreeWord((word + 1) % kWordCount);
+			free = ~words_[word];
+		}
+
+		const auto id = static_cast<std::uint16_t>(word * 64 + static_cast<std::size_t>(std::countr_zero(free)));
+		Reserve(id);
+		cursor_ = static_cast<std::uint16_t>(id + 1);
+		return id;
+	}
+
+	bool GemIdAllocator::Reserve(std::uint16_t id)
+	{
+		auto& word = words_[id >> 6];
+		const auto bit = 1ull << (id & 63);
+		if ((word & bit) != 0) {
+			return false;
+		}
+
+		word |= bit;
+		++used_;
+		if (word == kAllBits) {
+			SetFull(id >> 6, true);
+		}
+		return true;
+	}
+
+	void GemIdAllocator::Free(std::uint16_t id)
+	{
+		if (id == 0) {
+			return;
+		}
+
+		auto& word = words_[id >> 6];
+		const auto bit = 1ull << (id & 63);
+		if ((word & bit) == 0) {
+			return;
+		}
+
+		if (word == kAllBits) {
+			SetFull(id >> 6, false);
+		}
+		word &= ~bit;
+		--used_;
+	}
+
+	void GemIdAllocator::Reset()
+	{
+		words_.fill(0);
+		full_.fill(0);
+		used_ = 0;
+		cursor_ = 1;
+		Reserve(0);
+	}
+
+	bool GemIdAllocator::IsUsed(std::uint16_t id) const
+	{
+		return (words_[id >> 6] & (1ull << (id & 63))) != 0;
+	}
+
+	std::size_t GemIdAllocator::GetUsedCount() const
+	{
+		return used_;
+	}
+
+	std::uint16_t GemIdAllocator::GetCursor() const
+	{
+		return cursor_;
+	}
+
+	void GemIdAllocator::SetCursor(std::uint16_t cursor)
+	{
+		cursor_ = cursor;
+	}
+
+	void GemIdAllocator::EncodeState(std::vector<std::uint8_t>& out) const
+	{
+		out.clear();
+		out.reserve(4 + used_ / 8 * kEntrySize);
+		const auto put = [&out](std::uint64_t value, std::size_t bytes) {
+			for (std::size_t i = 0; i < bytes; ++i) {
+				out.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+			}
+		};
+
+		std::size_t nonEmpty = 0;
+		for (const auto word : words_) {
+			nonEmpty += word != 0 ? 1 : 0;
+		}
+		put(cursor_, 2);
+		put(nonEmpty, 2);
+		for (std::size_t i = 0; i < kWordCount; ++i) {
+			if (words_[i] != 0) {
+				put(i, 2);
+				put(words_[i], 8);
+			}
+		}
+	}
+
+	bool GemIdAllocator::DecodeState(std::span<const std::uint8_t> in)
+	{
+		Reset();
+		const auto get = [&in](std::size_t offset, std::size_t bytes) {
+			std::uint64_t value = 0;
+			for (std::size_t i = 0; i < bytes; ++i) {
+				value |= static_cast<std::uint64_t>(in[offset + i]) << (i * 8);
+			}
+			return value;
+		};
+
+		if (in.size() < 4) {
+			return false;
+		}
+		const auto cursor = static_cast<std::uint16_t>(get(0, 2));
+		const auto count = static_cast<std::size_t>(get(2, 2));
+		if (in.size() < 4 + count * kEntrySize) {
+			return false;
+		}
+
+		for (std::size_t i = 0; i < count; ++i) {
+			const auto offset = 4 + i * kEntrySize;
+			const auto index = static_cast<std::size_t>(get(offset, 2));
+			if (index >= kWordCount) {
+				Reset();
+				return false;
+			}
+			auto bits = get(offset + 2, 8);
+			while (bits != 0) {
+				Reserve(static_cast<std::uint16_t>(index * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+				bits &= bits - 1;
+			}
+		}
+		cursor_ = cursor;
+		return true;
+	}
+
+	void GemIdAllocator::SetFull(std::size_t word, bool full)
+	{
+		const auto bit = 1ull << (word & 63);
+		if (full) {
+			full_[word >> 6] |= bit;
+		} else {
+			full_[word >> 6] &= ~bit;
+		}
+	}
+
+	// First word at or after from (wrapping) with a free bit. Only called when one exists.
+	std::size_t GemIdAllocator::FindFreeWord(std::size_t from) const
+	{
+		auto summary = from >> 6;
+		auto open = ~full_[summary] & (kAllBits << (from & 63));
+		for (std::size_t scanned = 0; open == 0 && scanned < kSummaryCount; ++scanned) {
+			summary = (summary + 1) % kSummaryCount;
+			open = ~full_[summary];
+		}
+		return summary * 64 + static_cast<std::size_t>(std::countr_zero(open));
+	}
+}
@@ -0,0 +1,51 @@
+// Bitmap allocator for the 16-bit unique IDs attached to stored gems.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SpellGems
+{
+	// One bit per ID plus a summary bit per 64-ID word that is set when the word is full, so the next free ID is
+	// two count-trailing-zeros away. Allocation is next-fit from a cursor, which keeps a freed ID out of
+	// circulation for as long as possible. ID 0 is never handed out.
+	class GemIdAllocator
+	{
+	public:
+		static constexpr std::size_t kIdCount = 1 << 16;
+
+		GemIdAllocator();
+
+		// Returns 0 when every ID is in use.
+		std::uint16_t Allocate();
+		// Marks an ID used. Returns false when it already was.
+		bool Reserve(std::uint16_t id);
+		void Free(std::uint16_t id);
+		void Reset();
+
+		bool IsUsed(std::uint16_t id) const;
+		std::size_t GetUsedCount() const;
+		std::uint16_t GetCursor() const;
+		void SetCursor(std::uint16_t cursor);
+
+		// State for the STAT record: u16 cursor, u16 word count, then {u16 word index, u64 bits} for every
+		// non-empty word, little-endian. Decode replaces the current state; false leaves it reset.
+		void EncodeState(std::vector<std::uint8_t>& out) const;
+		bool DecodeState(std::span<const std::uint8_t> in);
+
+	private:
+		static constexpr std::size_t kWordCount = kIdCount / 64;
+		static constexpr std::size_t kSummaryCount = kWordCount / 64;
+
+		void SetFull(std::size_t word, bool full);
+		std::size_t FindFreeWord(std::size_t from) const;
+
+		std::array<std::uint64_t, kWordCount> words_{};
+		std::array<std::uint64_t, kSummaryCount> full_{};
+		std::size_t used_{};
+		std::uint16_t cursor_{ 1 };
+	};
+}
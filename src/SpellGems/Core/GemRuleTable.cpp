@@ -0,0 +1,148 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                Gem Rule Table                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemRuleTable.h"
+
+#include "SpellGems/Core/ConfigSnapshot.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace SpellGems
+{
+	namespace
+	{
+		bool HasSchool(std::uint8_t schoolMask, SchoolFlags school)
+		{
+			return (schoolMask & static_cast<std::uint8_t>(school)) != 0;
+		}
+
+		// The boosts and penalties cast plans have always applied, before any rule.
+		void ApplyGemBoosts(const ConfigValues& values, std::uint8_t schoolMask, GemClass gem, GemOutcome& outcome)
+		{
+			if (gem == GemClass::AzurasStar && values.azurasStarBoost) {
+				outcome.effectiveness = 1.05f;
+				outcome.magnitudeOverride = 1.05f;
+			} else if (gem == GemClass::Normal && values.normalGemPenalty) {
+				outcome.effectiveness = 0.9f;
+				outcome.magnitudeOverride = 0.9f;
+			} else if ((gem == GemClass::Black || gem == GemClass::BlackStar) && values.blackSoulGemBoosts) {
+				if (HasSchool(schoolMask, SchoolFlags::Destruction)) {
+					outcome.magnitudeOverride = 1.1f;
+				}
+				if (HasSchool(schoolMask, SchoolFlags::Conjuration) || HasSchool(schoolMask, SchoolFlags::Alteration)) {
+					outcome.effectiveness = 1.1f;
+				}
+				outcome.healthCostFraction = 0.05f;
+			}
+		}
+
+		void ApplyRule(const GemRule& rule, GemOutcome& outcome)
+		{
+			if ((rule.effects & GemRule::kCooldown) != 0) {
+				outcome.cooldownSeconds = rule.cooldown;
+			}
+			if ((rule.effects & GemRule::kUses) != 0) {
+				outcome.uses = rule.uses;
+			}
+			if ((rule.effects & GemRule::kEffectiveness) != 0) {
+				outcome.effectiveness = rule.effectiveness;
+			}
+			if ((rule.effects & GemRule::kMagnitude) != 0) {
+				outcome.magnitudeOverride = rule.magnitudeOverride;
+			}
+			if ((rule.effects & GemRule::kHealthCost) != 0) {
+				outcome.healthCostFraction = rule.healthCostFraction;
+			}
+		}
+
+		// Tier settings and gem boosts first, then every matching rule in order. Reusable stars stay unlimited and
+		// FiniteUse=false still turns every gem unlimited, whatever a rule says about uses.
+		template <class Rules>
+		GemOutcome Resolve(const ConfigValues& values, const Rules& rules, FormID spellId, SpellTier tier, std::uint8_t schoolMask, GemClass gem)
+		{
+			const bool isReusableStar = gem == GemClass::AzurasStar || gem == GemClass::BlackStar;
+			const auto& tierSettings = values.tiers[static_cast<std::size_t>(tier)];
+
+			GemOutcome outcome{};
+			outcome.cooldownSeconds = isReusableStar ? values.starCooldown : tierSettings.cooldown;
+			outcome.uses = tierSettings.uses;
+			ApplyGemBoosts(values, schoolMask, gem, outcome);
+			for (const auto& rule : rules) {
+				if (rule.Matches(spellId, tier, schoolMask, gem)) {
+					ApplyRule(rule, outcome);
+				}
+			}
+
+			outcome.cooldownDays = outcome.cooldownSeconds / kSecondsPerGameDay;
+			if (isReusableStar || !values.finiteUse || outcome.uses < 0) {
+				outcome.uses = -1;
+			}
+			return outcome;
+		}
+	}
+
+	GemRuleTable::GemRuleTable() :
+		GemRuleTable(ConfigValues{})
+	{
+	}
+
+	GemRuleTable::GemRuleTable(const ConfigValues& values)
+	{
+		for (const auto& rule : values.rules) {
+			if (rule.spellId != 0) {
+				namedSpells_.push_back(rule.spellId);
+			}
+		}
+		std::sort(namedSpells_.begin(), namedSpells_.end());
+		namedSpells_.erase(std::unique(namedSpells_.begin(), namedSpells_.end()), namedSpells_.end());
+
+		// Each block only walks the rules that can match it: the generic ones and those naming its spell.
+		outcomes_.resize((namedSpells_.size() + 1) * kGenericClasses * kGemClassCount);
+		auto cell = outcomes_.begin();
+		std::vector<GemRule> rules;
+		rules.reserve(values.rules.size());
+		for (std::size_t block = 0; block <= namedSpells_.size(); ++block) {
+			const FormID spellId = block == 0 ? 0 : namedSpells_[block - 1];
+			rules.clear();
+			std::copy_if(values.rules.begin(), values.rules.end(), std::back_inserter(rules), [&](const GemRule& rule) {
+				return rule.spellId == 0 || rule.spellId == spellId;
+			});
+			for (std::size_t tier = 0; tier < kTierCount; ++tier) {
+				for (std::size_t schoolMask = 0; schoolMask < kSchoolMaskCount; ++schoolMask) {
+					for (std::size_t gem = 0; gem < kGemClassCount; ++gem) {
+						*cell++ = Resolve(values, rules, spellId, static_cast<SpellTier>(tier), static_cast<std::uint8_t>(schoolMask),
+							static_cast<GemClass>(gem));
+					}
+				}
+			}
+		}
+	}
+
+	std::size_t GemRuleTable::GetSpellClass(FormID spellId, SpellTier tier, std::uint8_t schoolMask) const
+	{
+		std::size_t block = 0;
+		if (!namedSpells_.empty()) {
+			const auto it = std::lower_bound(namedSpells_.begin(), namedSpells_.end(), spellId);
+			if (it != namedSpells_.end() && *it == spellId) {
+				block = static_cast<std::size_t>(it - namedSpells_.begin()) + 1;
+			}
+		}
+		return block * kGenericClasses + static_cast<std::size_t>(tier) * kSchoolMaskCount + (schoolMask & (kSchoolMaskCount - 1));
+	}
+
+	std::size_t GemRuleTable::GetNamedSpellCount() const
+	{
+		return namedSpells_.size();
+	}
+
+	GemOutcome GemRuleTable::Evaluate(const ConfigValues& values, FormID spellId, SpellTier tier, std::uint8_t schoolMask, GemClass gem)
+	{
+		return Resolve(values, values.rules, spellId, tier, schoolMask, gem);
+	}
+}
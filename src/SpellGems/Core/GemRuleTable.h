@@ -0,0 +1,73 @@
+// Tier settings, gem boosts and [Rules] overrides compiled into one dense table of per-cast outcomes.
+#pragma once
+
+#include "SpellGems/Core/ConfigValues.h"
+#include "SpellGems/Core/GemTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SpellGems
+{
+	// Everything an activation or a store needs for one spell in one kind of gem.
+	struct GemOutcome
+	{
+		float cooldownSeconds{};
+		// At timescale 1.
+		float cooldownDays{};
+		// What a newly stored gem starts with; -1 for unlimited.
+		std::int32_t uses{};
+		float effectiveness{ 1.0f };
+		float magnitudeOverride{};
+		float healthCostFraction{};
+
+		friend bool operator==(const GemOutcome&, const GemOutcome&) = default;
+	};
+
+	// Rows are spell classes: one per (tier, school mask), repeated in a block of its own for every spell a rule
+	// names. Columns are gem classes. Compiling walks the rules once per cell, so a lookup never does.
+	class GemRuleTable
+	{
+	public:
+		static constexpr std::size_t kGenericClasses = kTierCount * kSchoolMaskCount;
+
+		// Compiles ConfigValues{}.
+		GemRuleTable();
+		explicit GemRuleTable(const ConfigValues& values);
+
+		// tier must be a valid SpellTier; the store rejects entries that are not on load. schoolMask is the
+		// spell's SchoolFlags.
+		std::size_t GetSpellClass(FormID spellId, SpellTier tier, std::uint8_t schoolMask) const;
+
+		const GemOutcome& Get(std::size_t spellClass, GemClass gem) const
+		{
+			return outcomes_[spellClass * kGemClassCount + static_cast<std::size_t>(gem)];
+		}
+
+		const GemOutcome& Find(FormID spellId, SpellTier tier, std::uint8_t schoolMask, GemClass gem) const
+		{
+			return Get(GetSpellClass(spellId, tier, schoolMask), gem);
+		}
+
+		// Spells some rule names, each with a block of its own.
+		std::size_t GetNamedSpellCount() const;
+
+		// The same outcome worked out from the settings directly by walking every rule; what each table cell holds.
+		static GemOutcome Evaluate(const ConfigValues& values, FormID spellId, SpellTier tier, std::uint8_t schoolMask, GemClass gem);
+
+	private:
+		// Sorted.
+		std::vector<FormID> namedSpells_;
+		std::vector<GemOutcome> outcomes_;
+	};
+
+	// The slice of the user configuration the core consults, copied out so the core never sees the INI.
+	struct GemRules
+	{
+		std::array<std::uint32_t, kTierCount> fragmentCounts{};
+		FormID fragmentFormId{};
+		GemRuleTable outcomes;
+	};
+}
@@ -0,0 +1,87 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                Gem Slot Index                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemSlotIndex.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace SpellGems
+{
+	// Inserts a key at its ordered position; no-op if already present.
+	void GemSlotIndex::Insert(const GemKey& key)
+	{
+		auto it = std::lower_bound(keys_.begin(), keys_.end(), key, &GemSlotIndex::Less);
+		if (it != keys_.end() && *it == key) {
+			return;
+		}
+
+		keys_.insert(it, key);
+		++generation_;
+	}
+
+	// Bulk insert for loads: one sort and merge instead of shifting the array once per key.
+	void GemSlotIndex::InsertMany(std::span<const GemKey> keys)
+	{
+		if (keys.empty()) {
+			return;
+		}
+
+		const auto oldSize = static_cast<std::ptrdiff_t>(keys_.size());
+		keys_.insert(keys_.end(), keys.begin(), keys.end());
+		std::sort(keys_.begin() + oldSize, keys_.end(), &GemSlotIndex::Less);
+		std::inplace_merge(keys_.begin(), keys_.begin() + oldSize, keys_.end(), &GemSlotIndex::Less);
+		keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+		++generation_;
+	}
+
+	void GemSlotIndex::Erase(const GemKey& key)
+	{
+		auto it = std::lower_bound(keys_.begin(), keys_.end(), key, &GemSlotIndex::Less);
+		if (it == keys_.end() || !(*it == key)) {
+			return;
+		}
+
+		keys_.erase(it);
+		++generation_;
+	}
+
+	void GemSlotIndex::Clear()
+	{
+		keys_.clear();
+		++generation_;
+	}
+
+	const GemKey* GemSlotIndex::At(std::size_t index) const
+	{
+		return index < keys_.size() ? std::addressof(keys_[index]) : nullptr;
+	}
+
+	std::span<const GemKey> GemSlotIndex::GetKeys() const
+	{
+		return keys_;
+	}
+
+	std::size_t GemSlotIndex::Size() const
+	{
+		return keys_.size();
+	}
+
+	std::uint64_t GemSlotIndex::GetGeneration() const
+	{
+		return generation_;
+	}
+
+	bool GemSlotIndex::Less(const GemKey& lhs, const GemKey& rhs)
+	{
+		if (lhs.baseId != rhs.baseId) {
+			return lhs.baseId < rhs.baseId;
+		}
+		return lhs.uniqueId < rhs.uniqueId;
+	}
+}
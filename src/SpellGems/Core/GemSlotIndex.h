@@ -0,0 +1,32 @@
+// Ordered index of stored gem keys used for hotkey slot lookups.
+#pragma once
+
+#include "SpellGems/Core/GemTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SpellGems
+{
+	// Stored gem keys kept in activation order (baseId, then uniqueId) so slot lookups are a single index.
+	class GemSlotIndex
+	{
+	public:
+		void Insert(const GemKey& key);
+		void InsertMany(std::span<const GemKey> keys);
+		void Erase(const GemKey& key);
+		void Clear();
+
+		const GemKey* At(std::size_t index) const;
+		std::span<const GemKey> GetKeys() const;
+		std::size_t Size() const;
+		std::uint64_t GetGeneration() const;
+
+	private:
+		static bool Less(const GemKey& lhs, const GemKey& rhs);
+
+		std::vector<GemKey> keys_;
+		std::uint64_t generation_{};
+	};
+}
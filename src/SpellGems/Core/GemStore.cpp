@@ -0,0 +1,415 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Stored Gem Table                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemStore.h"
+
+#include "SpellGems/Core/Crc32c.h"
+
+#include <cmath>
+#include <vector>
+
+namespace SpellGems
+{
+	void GemStore::SetObserver(Observer* observer)
+	{
+		observer_ = observer;
+	}
+
+	// Applies from the next Save; loads accept every encoding regardless.
+	void GemStore::SetRecordEncoding(SpellRecordCodec::Encoding encoding)
+	{
+		encoding_ = encoding;
+	}
+
+	// Inserts or overwrites an entry. Returns true when the key is new.
+	bool GemStore::Store(const GemKey& key, const StoredSpellData& data)
+	{
+		++generation_;
+		if (!entries_.InsertOrAssign(key, data)) {
+			return false;
+		}
+
+		slotIndex_.Insert(key);
+		baseFilter_.Add(key.baseId);
+		baseIndex_.Insert(key);
+		AddHolder(key.uniqueId);
+		if (observer_) {
+			observer_->OnInserted(key);
+		}
+		return true;
+	}
+
+	bool GemStore::Remove(const GemKey& keyRef)
+	{
+		// Copy first: callers often pass a reference into the slot index, which Erase shifts.
+		const GemKey key = keyRef;
+		if (!entries_.Erase(key)) {
+			return false;
+		}
+
+		++generation_;
+		slotIndex_.Erase(key);
+		baseFilter_.Remove(key.baseId);
+		baseIndex_.Erase(key);
+		RemoveHolder(key.uniqueId);
+		if (observer_) {
+			observer_->OnErased(key);
+		}
+		return true;
+	}
+
+	// Drops every entry, as a load does before reading records. The allocator keeps only its cursor: the state
+	// and spell records rebuild its bitmap.
+	void GemStore::ClearEntries()
+	{
+		entries_.Clear();
+		slotIndex_.Clear();
+		baseFilter_.Clear();
+		baseIndex_.Clear();
+		const auto cursor = ids_.GetCursor();
+		ids_.Reset();
+		ids_.SetCursor(cursor);
+		liveIds_.reset();
+		extraHolders_.clear();
+		loadStats_ = {};
+		++generation_;
+	}
+
+	// Returns the store to its new-game state.
+	void GemStore::Clear()
+	{
+		ClearEntries();
+		ids_.Reset();
+		++generation_;
+	}
+
+	bool GemStore::Has(const GemKey& key) const
+	{
+		return entries_.Contains(key);
+	}
+
+	std::optional<StoredSpellData> GemStore::Get(const GemKey& key) const
+	{
+		return entries_.Find(key);
+	}
+
+	// Returns the lowest-uniqueId instance stored under the base form.
+	bool GemStore::TryGetByBaseId(FormID baseId, GemKey& key, StoredSpellData& data) const
+	{
+		GemKey first{};
+		if (!baseIndex_.TryGetFirst(baseId, first)) {
+			return false;
+		}
+
+		const auto index = entries_.FindIndex(first);
+		if (index == GemTable::kNotFound) {
+			return false;
+		}
+
+		key = first;
+		data = entries_.GetData(index);
+		return true;
+	}
+
+	// Unique IDs of every instance stored under the base form, in ascending order.
+	std::span<const std::uint16_t> GemStore::GetInstances(FormID baseId) const
+	{
+		return baseIndex_.GetInstances(baseId);
+	}
+
+	const GemStore::Table& GemStore::GetEntries() const
+	{
+		return entries_;
+	}
+
+	const GemSlotIndex& GemStore::GetSlotIndex() const
+	{
+		return slotIndex_;
+	}
+
+	const GemBaseFilter& GemStore::GetBaseFilter() const
+	{
+		return baseFilter_;
+	}
+
+	const GemBaseIndex& GemStore::GetBaseIndex() const
+	{
+		return baseIndex_;
+	}
+
+	std::size_t GemStore::Size() const
+	{
+		return entries_.Size();
+	}
+
+	std::uint16_t GemStore::AllocateUniqueId()
+	{
+		++generation_;
+		return ids_.Allocate();
+	}
+
+	const GemIdAllocator& GemStore::GetIdAllocator() const
+	{
+		return ids_;
+	}
+
+	std::uint64_t GemStore::GetGeneration() const
+	{
+		return generation_;
+	}
+
+	std::shared_ptr<const GemStore::Snapshot> GemStore::CaptureSnapshot() const
+	{
+		auto snapshot = std::make_shared<Snapshot>();
+		snapshot->generation = generation_;
+		snapshot->ids = ids_;
+		snapshot->entries = entries_;
+		const auto order = slotIndex_.GetKeys();
+		snapshot->order.assign(order.begin(), order.end());
+		return snapshot;
+	}
+
+	// Pure function of the snapshot, so it may run on any thread.
+	GemStore::Image GemStore::EncodeSnapshot(const Snapshot& snapshot, SpellRecordCodec::Encoding encoding)
+	{
+		Image image{};
+		image.generation = snapshot.generation;
+		image.encoding = encoding;
+		snapshot.ids.EncodeState(image.state);
+		AppendTrailer(image.state);
+		SpellRecordCodec::Encode(snapshot.entries, snapshot.order, encoding, image.spells);
+		AppendTrailer(image.spells);
+		return image;
+	}
+
+	// True when the image holds exactly what Save would write now.
+	bool GemStore::IsCurrent(const Image& image) const
+	{
+		return image.generation == generation_ && image.encoding == encoding_;
+	}
+
+	// Writes the state and spell records.
+	void GemStore::Save(ICoSaveWriter& writer) const
+	{
+		std::vector<std::uint8_t> body;
+		if (writer.OpenRecord(kRecordState, kRecordVersion)) {
+			ids_.EncodeState(body);
+			AppendTrailer(body);
+			writer.WriteRaw(body.data(), static_cast<std::uint32_t>(body.size()));
+		}
+
+		// One contiguous write instead of eight per entry.
+		if (writer.OpenRecord(kRecordSpells, kRecordVersion)) {
+			SpellRecordCodec::Encode(entries_, slotIndex_.GetKeys(), encoding_, body);
+			AppendTrailer(body);
+			writer.WriteRaw(body.data(), static_cast<std::uint32_t>(body.size()));
+		}
+	}
+
+	// Writes the same records as Save from an image that IsCurrent accepted; no encoding happens here.
+	void GemStore::SaveImage(ICoSaveWriter& writer, const Image& image) const
+	{
+		if (writer.OpenRecord(kRecordState, kRecordVersion)) {
+			writer.WriteRaw(image.state.data(), static_cast<std::uint32_t>(image.state.size()));
+		}
+
+		if (writer.OpenRecord(kRecordSpells, kRecordVersion)) {
+			writer.WriteRaw(image.spells.data(), static_cast<std::uint32_t>(image.spells.size()));
+		}
+	}
+
+	// Reads one record owned by the store. Returns false for record types it does not own.
+	// The whole record is read in one call and its trailer checked in one pass before anything is decoded.
+	bool GemStore::LoadRecord(ICoSaveReader& reader, std::uint32_t type, std::uint32_t version, std::uint32_t length)
+	{
+		if (type != kRecordState && type != kRecordSpells) {
+			return false;
+		}
+
+		++generation_;
+		std::vector<std::uint8_t> record(length);
+		record.resize(reader.ReadRaw(record.data(), length));
+		std::span<const std::uint8_t> body;
+		const bool intact = CheckRecord(record, version, body);
+		++loadStats_.records;
+		loadStats_.corrupt += intact ? 0 : 1;
+		if (type == kRecordState) {
+			LoadState(body, version, intact);
+		} else {
+			LoadSpells(reader, body, version, intact);
+		}
+		return true;
+	}
+
+	GemStore::LoadStats GemStore::GetLoadStats() const
+	{
+		return loadStats_;
+	}
+
+	bool GemStore::CheckRecord(std::span<const std::uint8_t> record, std::uint32_t version, std::span<const std::uint8_t>& body)
+	{
+		body = record;
+		if (version < 7) {
+			return true;
+		}
+		if (record.size() < kTrailerSize) {
+			return false;
+		}
+
+		body = record.first(record.size() - kTrailerSize);
+		const auto* trailer = record.data() + body.size();
+		const auto get = [trailer](std::size_t offset) {
+			return static_cast<std::uint32_t>(trailer[offset]) | (static_cast<std::uint32_t>(trailer[offset + 1]) << 8) |
+			       (static_cast<std::uint32_t>(trailer[offset + 2]) << 16) | (static_cast<std::uint32_t>(trailer[offset + 3]) << 24);
+		};
+		return get(0) == body.size() && get(4) == Crc32c::Compute(body);
+	}
+
+	void GemStore::AppendTrailer(std::vector<std::uint8_t>& body)
+	{
+		const auto put = [&body](std::uint32_t value) {
+			for (int shift = 0; shift < 32; shift += 8) {
+				body.push_back(static_cast<std::uint8_t>(value >> shift));
+			}
+		};
+		const auto crc = Crc32c::Compute(body);
+		put(static_cast<std::uint32_t>(body.size()));
+		put(crc);
+	}
+
+	// Values Store can never produce: an unknown tier, uses below the unlimited marker, a negative or non-finite
+	// last use time, or a null form ID.
+	std::size_t GemStore::SalvageEntries(std::vector<SpellRecordCodec::Entry>& entries)
+	{
+		return std::erase_if(entries, [](const SpellRecordCodec::Entry& entry) {
+			const auto& [key, data] = entry;
+			return key.baseId == 0 || data.spellId == 0 || static_cast<std::size_t>(data.tier) >= kTierCount ||
+			       data.usesRemaining < -1 || !std::isfinite(data.lastUsedGameTime) || data.lastUsedGameTime < 0.0f;
+		});
+	}
+
+	// v1-v4 are fixed-width layouts generated by SpellRecordSchema; v5 on adds the encoding header.
+	std::size_t GemStore::DecodeSpells(std::span<const std::uint8_t> body, std::uint32_t version,
+		std::vector<SpellRecordCodec::Entry>& out)
+	{
+		if (version > SpellRecordSchema::kPackedVersion) {
+			return SpellRecordCodec::Decode(body, out);
+		}
+		return SpellRecordSchema::Decode(body, version, out);
+	}
+
+	// Before v6 the record is only the next unique ID, which becomes the cursor over an untouched bitmap. A v6 body
+	// that fails to decode leaves the allocator reset with its cursor kept.
+	bool GemStore::DecodeState(std::span<const std::uint8_t> body, std::uint32_t version, GemIdAllocator& ids)
+	{
+		if (version < 6) {
+			if (body.size() < sizeof(std::uint16_t)) {
+				return false;
+			}
+			ids.SetCursor(static_cast<std::uint16_t>(body[0] | (body[1] << 8)));
+			return true;
+		}
+
+		const auto cursor = ids.GetCursor();
+		if (!ids.DecodeState(body)) {
+			ids.SetCursor(cursor);
+			return false;
+		}
+		return true;
+	}
+
+	// Decodes the body in a single pass. A body that failed its check still decodes up to the first malformed
+	// entry, and only plausible entries are kept.
+	void GemStore::LoadSpells(const ICoSaveReader& reader, std::span<const std::uint8_t> body, std::uint32_t version, bool intact)
+	{
+		std::vector<SpellRecordCodec::Entry> decoded;
+		DecodeSpells(body, version, decoded);
+		if (!intact) {
+			loadStats_.dropped += SalvageEntries(decoded);
+			loadStats_.salvaged += decoded.size();
+		}
+		entries_.Reserve(entries_.Size() + decoded.size());
+		std::vector<GemKey> inserted;
+		inserted.reserve(decoded.size());
+		for (auto& [key, data] : decoded) {
+			if (InsertLoaded(reader, key, data)) {
+				inserted.push_back(key);
+			}
+		}
+		slotIndex_.InsertMany(inserted);
+	}
+
+	// Remaps both form IDs to the current load order and adds the entry to the table, filter and base index; the
+	// caller batches the slot index. Entries whose plugin is gone, and keys already present, are dropped.
+	bool GemStore::InsertLoaded(const ICoSaveReader& reader, GemKey& key, StoredSpellData data)
+	{
+		FormID resolvedSpell = 0;
+		if (!reader.ResolveFormID(data.spellId, resolvedSpell)) {
+			return false;
+		}
+		data.spellId = resolvedSpell;
+
+		FormID resolvedGem = 0;
+		if (!reader.ResolveFormID(key.baseId, resolvedGem)) {
+			return false;
+		}
+		key.baseId = resolvedGem;
+		if (entries_.Contains(key) || !entries_.InsertOrAssign(key, data)) {
+			return false;
+		}
+
+		baseFilter_.Add(key.baseId);
+		baseIndex_.Insert(key);
+		AddHolder(key.uniqueId);
+		return true;
+	}
+
+	// The saved bitmap also covers IDs handed out to gems whose store never completed, so the allocator becomes its
+	// union with the live keys whichever record comes first. Older records carry only the next ID, which becomes
+	// the cursor, and the live keys alone fill the bitmap. A damaged record is ignored for the same result.
+	void GemStore::LoadState(std::span<const std::uint8_t> body, std::uint32_t version, bool intact)
+	{
+		if (intact) {
+			DecodeState(body, version, ids_);
+		}
+		for (const auto& [key, _] : entries_) {
+			if (key.uniqueId != 0) {
+				ids_.Reserve(key.uniqueId);
+			}
+		}
+	}
+
+	// ID 0 means "no ExtraUniqueID" and never enters the allocator.
+	void GemStore::AddHolder(std::uint16_t uniqueId)
+	{
+		if (uniqueId == 0) {
+			return;
+		}
+		if (liveIds_.test(uniqueId)) {
+			++extraHolders_[uniqueId];
+			return;
+		}
+		liveIds_.set(uniqueId);
+		ids_.Reserve(uniqueId);
+	}
+
+	void GemStore::RemoveHolder(std::uint16_t uniqueId)
+	{
+		if (uniqueId == 0) {
+			return;
+		}
+		if (const auto it = extraHolders_.find(uniqueId); it != extraHolders_.end()) {
+			if (--it->second == 0) {
+				extraHolders_.erase(it);
+			}
+			return;
+		}
+		liveIds_.reset(uniqueId);
+		ids_.Free(uniqueId);
+	}
+}
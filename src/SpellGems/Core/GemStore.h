@@ -0,0 +1,140 @@
+// Stored spell table with its slot index, base filter and co-save records.
+#pragma once
+
+#include "SpellGems/Core/GemBaseFilter.h"
+#include "SpellGems/Core/GemBaseIndex.h"
+#include "SpellGems/Core/GemIdAllocator.h"
+#include "SpellGems/Core/GemSlotIndex.h"
+#include "SpellGems/Core/GemTable.h"
+#include "SpellGems/Core/GemTypes.h"
+#include "SpellGems/Core/Interfaces.h"
+#include "SpellGems/Core/SpellRecordCodec.h"
+
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace SpellGems
+{
+	class GemStore
+	{
+	public:
+		using Table = GemTable;
+
+		// Notified when a key enters or leaves the table through Store/Remove; loads and clears are silent.
+		class Observer
+		{
+		public:
+			virtual ~Observer() = default;
+
+			virtual void OnInserted(const GemKey& key) = 0;
+			virtual void OnErased(const GemKey& key) = 0;
+		};
+
+		// v1-v3 write the spell record field by field, v4 as one packed SpellRecordCodec body and v5 as a headered
+		// body in the encoding chosen by SetRecordEncoding. Before v6 the state record held only the next unique ID;
+		// from v6 it holds the GemIdAllocator state. From v7 both records end in a trailer: u32 body length and the
+		// u32 CRC32C of the body.
+		static constexpr std::uint32_t kRecordVersion = 7;
+		static constexpr std::size_t kTrailerSize = 8;
+		static constexpr std::uint32_t kRecordSpells = 'SPEL';
+		static constexpr std::uint32_t kRecordState = 'STAT';
+
+		// Immutable copy of everything Save writes. The table is flat, so a copy is a few vector memcpys.
+		struct Snapshot
+		{
+			std::uint64_t generation{};
+			GemIdAllocator ids;
+			Table entries;
+			std::vector<GemKey> order;
+		};
+
+		// What the last load found. Records that fail their trailer check are salvaged instead of trusted.
+		struct LoadStats
+		{
+			std::uint32_t records{};
+			std::uint32_t corrupt{};
+			std::size_t salvaged{};
+			std::size_t dropped{};
+		};
+
+		// Pre-encoded record bodies, trailers included, for one generation, ready for SaveImage.
+		struct Image
+		{
+			std::uint64_t generation{};
+			SpellRecordCodec::Encoding encoding{};
+			std::vector<std::uint8_t> state;
+			std::vector<std::uint8_t> spells;
+		};
+
+		void SetObserver(Observer* observer);
+		void SetRecordEncoding(SpellRecordCodec::Encoding encoding);
+
+		bool Store(const GemKey& key, const StoredSpellData& data);
+		bool Remove(const GemKey& key);
+		void ClearEntries();
+		void Clear();
+
+		bool Has(const GemKey& key) const;
+		std::optional<StoredSpellData> Get(const GemKey& key) const;
+		bool TryGetByBaseId(FormID baseId, GemKey& key, StoredSpellData& data) const;
+		std::span<const std::uint16_t> GetInstances(FormID baseId) const;
+		const Table& GetEntries() const;
+		const GemSlotIndex& GetSlotIndex() const;
+		const GemBaseFilter& GetBaseFilter() const;
+		const GemBaseIndex& GetBaseIndex() const;
+		std::size_t Size() const;
+
+		// Returns 0 when all 65535 IDs are taken.
+		std::uint16_t AllocateUniqueId();
+		const GemIdAllocator& GetIdAllocator() const;
+
+		// Bumped by every change that alters what Save would write.
+		std::uint64_t GetGeneration() const;
+		std::shared_ptr<const Snapshot> CaptureSnapshot() const;
+		static Image EncodeSnapshot(const Snapshot& snapshot, SpellRecordCodec::Encoding encoding);
+		bool IsCurrent(const Image& image) const;
+
+		void Save(ICoSaveWriter& writer) const;
+		void SaveImage(ICoSaveWriter& writer, const Image& image) const;
+		bool LoadRecord(ICoSaveReader& reader, std::uint32_t type, std::uint32_t version, std::uint32_t length);
+
+		LoadStats GetLoadStats() const;
+
+		// Record decoding without form ID resolution or indexing, shared by LoadRecord and offline tools.
+		// CheckRecord strips the trailer of a v7+ record into body and returns false when it does not match; older
+		// records have none and always pass.
+		static bool CheckRecord(std::span<const std::uint8_t> record, std::uint32_t version, std::span<const std::uint8_t>& body);
+		static void AppendTrailer(std::vector<std::uint8_t>& body);
+		// Drops decoded entries no save could have written. Returns how many went.
+		static std::size_t SalvageEntries(std::vector<SpellRecordCodec::Entry>& entries);
+		static std::size_t DecodeSpells(std::span<const std::uint8_t> body, std::uint32_t version,
+			std::vector<SpellRecordCodec::Entry>& out);
+		static bool DecodeState(std::span<const std::uint8_t> body, std::uint32_t version, GemIdAllocator& ids);
+
+	private:
+		void LoadSpells(const ICoSaveReader& reader, std::span<const std::uint8_t> body, std::uint32_t version, bool intact);
+		bool InsertLoaded(const ICoSaveReader& reader, GemKey& key, StoredSpellData data);
+		void LoadState(std::span<const std::uint8_t> body, std::uint32_t version, bool intact);
+		void AddHolder(std::uint16_t uniqueId);
+		void RemoveHolder(std::uint16_t uniqueId);
+
+		Table entries_;
+		GemSlotIndex slotIndex_;
+		GemBaseFilter baseFilter_;
+		GemBaseIndex baseIndex_;
+		Observer* observer_{};
+		SpellRecordCodec::Encoding encoding_{ SpellRecordCodec::Encoding::Packed };
+		GemIdAllocator ids_;
+		// Game-assigned unique IDs repeat across base forms, so an ID is freed only when its last key goes.
+		// extraHolders_ counts keys beyond the first for the rare shared ID.
+		std::bitset<GemIdAllocator::kIdCount> liveIds_;
+		std::unordered_map<std::uint16_t, std::uint32_t> extraHolders_;
+		std::uint64_t generation_{};
+		LoadStats loadStats_{};
+	};
+}
@@ -0,0 +1,227 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Flat Gem Table                                                //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/GemTable.h"
+
+#include <algorithm>
+
+namespace SpellGems
+{
+	// Inserts or overwrites an entry. Returns true when the key is new.
+	bool GemTable::InsertOrAssign(const GemKey& key, const StoredSpellData& data)
+	{
+		const auto hash = static_cast<std::uint32_t>(Hash(key));
+		const auto slot = FindSlot(key, hash);
+		if (slot != kNotFound) {
+			const auto index = slots_[slot].index;
+			hot_[index] = MakeHot(data);
+			spells_[index] = data.spellId;
+			return false;
+		}
+
+		// Keep the load factor at or below 3/4 so probe runs stay short.
+		if ((keys_.size() + 1) * 4 > slots_.size() * 3) {
+			Rehash(std::max(kMinSlots, slots_.size() * 2));
+		}
+
+		const auto index = static_cast<std::uint32_t>(keys_.size());
+		keys_.push_back(key);
+		hot_.push_back(MakeHot(data));
+		spells_.push_back(data.spellId);
+		PlaceSlot(hash, index);
+		return true;
+	}
+
+	bool GemTable::Erase(const GemKey& key)
+	{
+		const auto slot = FindSlot(key, static_cast<std::uint32_t>(Hash(key)));
+		if (slot == kNotFound) {
+			return false;
+		}
+
+		const auto index = slots_[slot].index;
+		const auto mask = slots_.size() - 1;
+
+		// Backward-shift deletion: pull later members of the probe run into the hole unless that would move
+		// them in front of their home slot.
+		auto hole = slot;
+		auto next = slot;
+		for (;;) {
+			next = (next + 1) & mask;
+			if (slots_[next].index == kEmpty) {
+				break;
+			}
+
+			const auto home = slots_[next].hash & mask;
+			const bool homeBetween = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+			if (homeBetween) {
+				continue;
+			}
+
+			slots_[hole] = slots_[next];
+			hole = next;
+		}
+		slots_[hole] = Slot{};
+
+		// Swap the last dense entry into the freed position and repoint its slot.
+		const auto last = static_cast<std::uint32_t>(keys_.size() - 1);
+		if (index != last) {
+			const auto lastHash = static_cast<std::uint32_t>(Hash(keys_[last]));
+			for (auto probe = lastHash & mask;; probe = (probe + 1) & mask) {
+				if (slots_[probe].index == last) {
+					slots_[probe].index = index;
+					break;
+				}
+			}
+			keys_[index] = keys_[last];
+			hot_[index] = hot_[last];
+			spells_[index] = spells_[last];
+		}
+		keys_.pop_back();
+		hot_.pop_back();
+		spells_.pop_back();
+		return true;
+	}
+
+	void GemTable::Clear()
+	{
+		std::fill(slots_.begin(), slots_.end(), Slot{});
+		keys_.clear();
+		hot_.clear();
+		spells_.clear();
+	}
+
+	void GemTable::Reserve(std::size_t count)
+	{
+		auto slotCount = std::max(kMinSlots, slots_.size());
+		while (slotCount * 3 < count * 4) {
+			slotCount *= 2;
+		}
+		if (slotCount > slots_.size()) {
+			Rehash(slotCount);
+		}
+		keys_.reserve(count);
+		hot_.reserve(count);
+		spells_.reserve(count);
+	}
+
+	bool GemTable::Contains(const GemKey& key) const
+	{
+		return FindIndex(key) != kNotFound;
+	}
+
+	std::optional<StoredSpellData> GemTable::Find(const GemKey& key) const
+	{
+		const auto index = FindIndex(key);
+		if (index == kNotFound) {
+			return std::nullopt;
+		}
+		return GetData(index);
+	}
+
+	// Returns the dense position of a key, or kNotFound. Positions change when other entries are erased.
+	std::size_t GemTable::FindIndex(const GemKey& key) const
+	{
+		const auto slot = FindSlot(key, static_cast<std::uint32_t>(Hash(key)));
+		return slot != kNotFound ? slots_[slot].index : kNotFound;
+	}
+
+	const GemKey& GemTable::GetKey(std::size_t index) const
+	{
+		return keys_[index];
+	}
+
+	const GemTable::HotFields& GemTable::GetHot(std::size_t index) const
+	{
+		return hot_[index];
+	}
+
+	FormID GemTable::GetSpellId(std::size_t index) const
+	{
+		return spells_[index];
+	}
+
+	StoredSpellData GemTable::GetData(std::size_t index) const
+	{
+		const auto& hot = hot_[index];
+		StoredSpellData data{};
+		data.spellId = spells_[index];
+		data.tier = hot.tier;
+		data.usesRemaining = hot.usesRemaining;
+		data.lastUsedGameTime = hot.lastUsedGameTime;
+		data.isReusableStar = (hot.flags & kReusableStar) != 0;
+		data.isBlackSoulGem = (hot.flags & kBlackSoulGem) != 0;
+		return data;
+	}
+
+	std::size_t GemTable::Size() const
+	{
+		return keys_.size();
+	}
+
+	bool GemTable::Empty() const
+	{
+		return keys_.empty();
+	}
+
+	GemTable::Iterator GemTable::begin() const
+	{
+		return { this, 0 };
+	}
+
+	GemTable::Iterator GemTable::end() const
+	{
+		return { this, keys_.size() };
+	}
+
+	GemTable::HotFields GemTable::MakeHot(const StoredSpellData& data)
+	{
+		HotFields hot{};
+		hot.usesRemaining = data.usesRemaining;
+		hot.lastUsedGameTime = data.lastUsedGameTime;
+		hot.tier = data.tier;
+		hot.flags = static_cast<std::uint8_t>((data.isReusableStar ? kReusableStar : 0) | (data.isBlackSoulGem ? kBlackSoulGem : 0));
+		return hot;
+	}
+
+	std::size_t GemTable::FindSlot(const GemKey& key, std::uint32_t hash) const
+	{
+		if (slots_.empty()) {
+			return kNotFound;
+		}
+
+		const auto mask = slots_.size() - 1;
+		for (auto probe = hash & mask;; probe = (probe + 1) & mask) {
+			const auto& slot = slots_[probe];
+			if (slot.index == kEmpty) {
+				return kNotFound;
+			}
+			if (slot.hash == hash && keys_[slot.index] == key) {
+				return probe;
+			}
+		}
+	}
+
+	void GemTable::Rehash(std::size_t slotCount)
+	{
+		slots_.assign(slotCount, Slot{});
+		for (std::uint32_t index = 0; index < keys_.size(); ++index) {
+			PlaceSlot(static_cast<std::uint32_t>(Hash(keys_[index])), index);
+		}
+	}
+
+	void GemTable::PlaceSlot(std::uint32_t hash, std::uint32_t index)
+	{
+		const auto mask = slots_.size() - 1;
+		auto probe = hash & mask;
+		while (slots_[probe].index != kEmpty) {
+			probe = (probe + 1) & mask;
+		}
+		slots_[probe] = { hash, index };
+	}
+}
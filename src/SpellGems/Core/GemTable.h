@@ -0,0 +1,130 @@
+// Flat open-addressing table of stored spell data keyed by GemKey.
+#pragma once
+
+#include "SpellGems/Core/GemTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace SpellGems
+{
+	// Entries live in dense parallel arrays: keys, hot per-use fields (uses, last use time, tier, flags) and the
+	// cold spell form. A power-of-two slot array with linear probing maps keys to dense positions; erases
+	// swap the last entry into the hole and backward-shift the probe run, so there are no tombstones.
+	class GemTable
+	{
+	public:
+		struct HotFields
+		{
+			std::int32_t usesRemaining{};
+			float lastUsedGameTime{};
+			SpellTier tier{};
+			std::uint8_t flags{};
+		};
+
+		enum Flag : std::uint8_t
+		{
+			kReusableStar = 1 << 0,
+			kBlackSoulGem = 1 << 1
+		};
+
+		static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+		// Yields (key, data) pairs by value, so `for (const auto& [key, data] : table)` reads as it did for a map.
+		class Iterator
+		{
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = std::pair<GemKey, StoredSpellData>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+			Iterator() = default;
+			Iterator(const GemTable* table, std::size_t index) : table_(table), index_(index) {}
+
+			value_type operator*() const
+			{
+				return { table_->keys_[index_], table_->GetData(index_) };
+			}
+
+			Iterator& operator++()
+			{
+				++index_;
+				return *this;
+			}
+
+			Iterator operator++(int)
+			{
+				auto copy = *this;
+				++index_;
+				return copy;
+			}
+
+			friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+			{
+				return lhs.index_ == rhs.index_;
+			}
+
+		private:
+			const GemTable* table_{};
+			std::size_t index_{};
+		};
+
+		bool InsertOrAssign(const GemKey& key, const StoredSpellData& data);
+		bool Erase(const GemKey& key);
+		void Clear();
+		void Reserve(std::size_t count);
+
+		bool Contains(const GemKey& key) const;
+		std::optional<StoredSpellData> Find(const GemKey& key) const;
+		std::size_t FindIndex(const GemKey& key) const;
+
+		const GemKey& GetKey(std::size_t index) const;
+		const HotFields& GetHot(std::size_t index) const;
+		FormID GetSpellId(std::size_t index) const;
+		StoredSpellData GetData(std::size_t index) const;
+
+		std::size_t Size() const;
+		bool Empty() const;
+		Iterator begin() const;
+		Iterator end() const;
+
+		static std::uint64_t Hash(const GemKey& key)
+		{
+			// murmur3 fmix64 over the packed 48-bit key; plain shifts cluster the 0xFExxxxxx light-plugin range.
+			auto h = (static_cast<std::uint64_t>(key.baseId) << 16) | key.uniqueId;
+			h ^= h >> 33;
+			h *= 0xFF51AFD7ED558CCDull;
+			h ^= h >> 33;
+			h *= 0xC4CEB9FE1A85EC53ull;
+			h ^= h >> 33;
+			return h;
+		}
+
+	private:
+		struct Slot
+		{
+			std::uint32_t hash{};
+			std::uint32_t index{ kEmpty };
+		};
+
+		static constexpr std::uint32_t kEmpty = 0xFFFFFFFF;
+		static constexpr std::size_t kMinSlots = 16;
+
+		static HotFields MakeHot(const StoredSpellData& data);
+
+		std::size_t FindSlot(const GemKey& key, std::uint32_t hash) const;
+		void Rehash(std::size_t slotCount);
+		void PlaceSlot(std::uint32_t hash, std::uint32_t index);
+
+		std::vector<Slot> slots_;
+		std::vector<GemKey> keys_;
+		std::vector<HotFields> hot_;
+		std::vector<FormID> spells_;
+	};
+}
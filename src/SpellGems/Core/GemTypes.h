@@ -0,0 +1,129 @@
+// Game-independent value types shared by the spell gem core and the plugin.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace SpellGems
+{
+	// Same width as RE::FormID so keys and records cross the plugin boundary unchanged.
+	using FormID = std::uint32_t;
+
+	enum class SpellTier : std::uint8_t
+	{
+		Novice = 0,
+		Apprentice,
+		Adept,
+		Expert,
+		Master,
+		Total
+	};
+
+	inline constexpr std::size_t kTierCount = static_cast<std::size_t>(SpellTier::Total);
+
+	struct TierSettings
+	{
+		float cooldown;
+		std::int32_t uses;
+
+		friend bool operator==(const TierSettings&, const TierSettings&) = default;
+	};
+
+	enum class SchoolFlags : std::uint8_t
+	{
+		None = 0,
+		Alteration = 1 << 0,
+		Conjuration = 1 << 1,
+		Destruction = 1 << 2,
+		Illusion = 1 << 3,
+		Restoration = 1 << 4
+	};
+
+	inline constexpr std::size_t kSchoolCount = 5;
+	// Every combination of SchoolFlags a spell can carry.
+	inline constexpr std::size_t kSchoolMaskCount = std::size_t{ 1 } << kSchoolCount;
+
+	// The soul gem kinds rules can single out; stored entries carry them as the reusable star and black soul gem
+	// flags, and the enum order follows those two bits.
+	enum class GemClass : std::uint8_t
+	{
+		Normal = 0,
+		Black,
+		AzurasStar,
+		BlackStar,
+		Total
+	};
+
+	inline constexpr std::size_t kGemClassCount = static_cast<std::size_t>(GemClass::Total);
+
+	constexpr GemClass GetGemClass(bool isReusableStar, bool isBlackSoulGem)
+	{
+		return static_cast<GemClass>((isReusableStar ? 2 : 0) | (isBlackSoulGem ? 1 : 0));
+	}
+
+	// One user override from the [Rules] section. Conditions left at zero match anything; a rule applies the
+	// effects flagged in effects and leaves the others to earlier rules or the tier settings.
+	struct GemRule
+	{
+		enum Effect : std::uint8_t
+		{
+			kCooldown = 1 << 0,
+			kUses = 1 << 1,
+			kEffectiveness = 1 << 2,
+			kMagnitude = 1 << 3,
+			kHealthCost = 1 << 4
+		};
+
+		FormID spellId{};
+		// Matches a spell in any of these schools.
+		std::uint8_t schoolMask{};
+		// One bit per SpellTier and per GemClass.
+		std::uint8_t tierMask{};
+		std::uint8_t gemMask{};
+		std::uint8_t effects{};
+		float cooldown{};
+		std::int32_t uses{};
+		float effectiveness{ 1.0f };
+		float magnitudeOverride{};
+		float healthCostFraction{};
+
+		bool Matches(FormID spell, SpellTier tier, std::uint8_t schools, GemClass gem) const
+		{
+			return (spellId == 0 || spellId == spell) && (schoolMask == 0 || (schoolMask & schools) != 0) &&
+				(tierMask == 0 || (tierMask >> static_cast<std::uint8_t>(tier) & 1) != 0) &&
+				(gemMask == 0 || (gemMask >> static_cast<std::uint8_t>(gem) & 1) != 0);
+		}
+
+		friend bool operator==(const GemRule&, const GemRule&) = default;
+	};
+
+	struct GemKey
+	{
+		FormID baseId{};
+		std::uint16_t uniqueId{};
+
+		friend bool operator==(const GemKey& lhs, const GemKey& rhs)
+		{
+			return lhs.baseId == rhs.baseId && lhs.uniqueId == rhs.uniqueId;
+		}
+	};
+
+	struct GemKeyHash
+	{
+		std::size_t operator()(const GemKey& key) const noexcept
+		{
+			return (static_cast<std::size_t>(key.baseId) << 16) ^ key.uniqueId;
+		}
+	};
+
+	struct StoredSpellData
+	{
+		FormID spellId{};
+		SpellTier tier{};
+		std::int32_t usesRemaining{};
+		float lastUsedGameTime{};
+		bool isReusableStar{};
+		bool isBlackSoulGem{};
+	};
+}
@@ -0,0 +1,77 @@
+// Thin interfaces the spell gem core uses to reach the game: forms, inventory, casting, time and co-save I/O.
+#pragma once
+
+#include "SpellGems/Core/GemTypes.h"
+
+#include <cstdint>
+
+namespace SpellGems
+{
+	class IFormLookup
+	{
+	public:
+		virtual ~IFormLookup() = default;
+
+		// False when the spell is gone; otherwise schoolMask receives its SchoolFlags.
+		virtual bool TryGetSpellSchools(FormID spellId, std::uint8_t& schoolMask) const = 0;
+		virtual bool TryGetGemTier(FormID gemId, SpellTier& tier) const = 0;
+	};
+
+	class IInventory
+	{
+	public:
+		virtual ~IInventory() = default;
+
+		virtual void Add(FormID formId, std::int32_t count) = 0;
+		virtual void Remove(FormID formId, std::int32_t count) = 0;
+	};
+
+	class ICaster
+	{
+	public:
+		virtual ~ICaster() = default;
+
+		// Returns false when the cast could not be started; the gem is then left untouched.
+		virtual bool Cast(const GemKey& key, const StoredSpellData& data) = 0;
+	};
+
+	class ICalendar
+	{
+	public:
+		virtual ~ICalendar() = default;
+
+		virtual float GetCurrentGameTime() const = 0;
+		virtual float GetTimescale() const = 0;
+	};
+
+	class ICoSaveWriter
+	{
+	public:
+		virtual ~ICoSaveWriter() = default;
+
+		virtual bool OpenRecord(std::uint32_t type, std::uint32_t version) = 0;
+		virtual bool WriteRaw(const void* data, std::uint32_t length) = 0;
+
+		template <class T>
+		bool Write(const T& value)
+		{
+			return WriteRaw(&value, sizeof(T));
+		}
+	};
+
+	class ICoSaveReader
+	{
+	public:
+		virtual ~ICoSaveReader() = default;
+
+		virtual bool GetNextRecordInfo(std::uint32_t& type, std::uint32_t& version, std::uint32_t& length) = 0;
+		virtual std::uint32_t ReadRaw(void* data, std::uint32_t length) = 0;
+		virtual bool ResolveFormID(FormID oldId, FormID& newId) const = 0;
+
+		template <class T>
+		bool Read(T& value)
+		{
+			return ReadRaw(&value, sizeof(T)) == sizeof(T);
+		}
+	};
+}
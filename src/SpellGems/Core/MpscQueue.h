@@ -0,0 +1,93 @@
+// Bounded lock-free multi-producer single-consumer ring.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SpellGems
+{
+	// Each cell carries a sequence number: producers claim a position with one CAS and publish by bumping the
+	// cell's sequence, the single consumer reads cells in order without any read-modify-write.
+	template <class T, std::size_t Capacity>
+	class MpscQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+	public:
+		MpscQueue()
+		{
+			for (std::size_t i = 0; i < Capacity; ++i) {
+				cells_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		// Safe from any thread. Returns false when the ring is full.
+		bool TryPush(const T& value)
+		{
+			auto pos = enqueuePos_.load(std::memory_order_relaxed);
+			for (;;) {
+				auto& cell = cells_[pos & kMask];
+				const auto sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+				if (diff == 0) {
+					if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						cell.value = value;
+						cell.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				} else if (diff < 0) {
+					return false;
+				} else {
+					pos = enqueuePos_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Consumer thread only.
+		bool TryPop(T& value)
+		{
+			const auto pos = dequeuePos_.load(std::memory_order_relaxed);
+			auto& cell = cells_[pos & kMask];
+			const auto sequence = cell.sequence.load(std::memory_order_acquire);
+			if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1) < 0) {
+				return false;
+			}
+
+			value = cell.value;
+			cell.sequence.store(pos + Capacity, std::memory_order_release);
+			dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// Approximate under concurrent pushes; exact when producers are quiet.
+		std::size_t SizeApprox() const
+		{
+			const auto enqueued = enqueuePos_.load(std::memory_order_relaxed);
+			const auto dequeued = dequeuePos_.load(std::memory_order_relaxed);
+			return enqueued > dequeued ? enqueued - dequeued : 0;
+		}
+
+		static constexpr std::size_t GetCapacity()
+		{
+			return Capacity;
+		}
+
+	private:
+		static constexpr std::size_t kMask = Capacity - 1;
+
+		struct Cell
+		{
+			std::atomic<std::size_t> sequence;
+			T value;
+		};
+
+		std::array<Cell, Capacity> cells_;
+		alignas(64) std::atomic<std::size_t> enqueuePos_{ 0 };
+		alignas(64) std::atomic<std::size_t> dequeuePos_{ 0 };
+	};
+}
@@ -0,0 +1,89 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Snapshot Encoder                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/SnapshotEncoder.h"
+
+#include <algorithm>
+
+namespace SpellGems
+{
+	// The worker starts last, after every member it touches is constructed.
+	SnapshotEncoder::SnapshotEncoder() :
+		worker_([this](std::stop_token stop) { Run(stop); })
+	{
+	}
+
+	SnapshotEncoder::~SnapshotEncoder()
+	{
+		worker_.request_stop();
+		if (worker_.joinable()) {
+			worker_.join();
+		}
+	}
+
+	// Replaces any snapshot still waiting; only the newest is worth encoding.
+	void SnapshotEncoder::Submit(std::shared_ptr<const GemStore::Snapshot> snapshot, SpellRecordCodec::Encoding encoding)
+	{
+		{
+			std::scoped_lock lock(mutex_);
+			if (pending_) {
+				++stats_.superseded;
+			}
+			pending_ = std::move(snapshot);
+			pendingEncoding_ = encoding;
+			++stats_.submitted;
+		}
+		wake_.notify_one();
+	}
+
+	std::shared_ptr<const GemStore::Image> SnapshotEncoder::GetLatest() const
+	{
+		std::scoped_lock lock(mutex_);
+		return latest_;
+	}
+
+	bool SnapshotEncoder::WaitIdle(std::chrono::milliseconds timeout) const
+	{
+		std::unique_lock lock(mutex_);
+		return idle_.wait_for(lock, timeout, [this]() { return !pending_ && !busy_; });
+	}
+
+	SnapshotEncoder::Stats SnapshotEncoder::GetStats() const
+	{
+		std::scoped_lock lock(mutex_);
+		return stats_;
+	}
+
+	void SnapshotEncoder::Run(std::stop_token stop)
+	{
+		std::unique_lock lock(mutex_);
+		for (;;) {
+			if (!wake_.wait(lock, stop, [this]() { return pending_ != nullptr; })) {
+				return;
+			}
+
+			auto snapshot = std::move(pending_);
+			const auto encoding = pendingEncoding_;
+			busy_ = true;
+			lock.unlock();
+
+			const auto start = Clock::now();
+			auto image = std::make_shared<const GemStore::Image>(GemStore::EncodeSnapshot(*snapshot, encoding));
+			const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+			snapshot.reset();
+
+			lock.lock();
+			latest_ = std::move(image);
+			busy_ = false;
+			++stats_.encoded;
+			stats_.lastEncodeUs = elapsedUs;
+			stats_.maxEncodeUs = std::max(stats_.maxEncodeUs, static_cast<std::int64_t>(elapsedUs));
+			idle_.notify_all();
+		}
+	}
+}
@@ -0,0 +1,60 @@
+// Worker thread that keeps a pre-encoded co-save image of the latest stored-spell snapshot.
+#pragma once
+
+#include "SpellGems/Core/GemStore.h"
+#include "SpellGems/Core/SpellRecordCodec.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+namespace SpellGems
+{
+	// The game thread captures snapshots and submits them; the worker encodes only the newest one, so a burst of
+	// changes costs one encode. The save callback takes the published image if it still matches the store.
+	class SnapshotEncoder
+	{
+	public:
+		struct Stats
+		{
+			std::uint64_t submitted;
+			std::uint64_t encoded;
+			std::uint64_t superseded;
+			std::int64_t lastEncodeUs;
+			std::int64_t maxEncodeUs;
+		};
+
+		SnapshotEncoder();
+		~SnapshotEncoder();
+
+		SnapshotEncoder(const SnapshotEncoder&) = delete;
+		SnapshotEncoder& operator=(const SnapshotEncoder&) = delete;
+
+		void Submit(std::shared_ptr<const GemStore::Snapshot> snapshot, SpellRecordCodec::Encoding encoding);
+		std::shared_ptr<const GemStore::Image> GetLatest() const;
+
+		// Blocks until nothing is pending or being encoded. Returns false on timeout.
+		bool WaitIdle(std::chrono::milliseconds timeout) const;
+
+		Stats GetStats() const;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		void Run(std::stop_token stop);
+
+		mutable std::mutex mutex_;
+		std::condition_variable_any wake_;
+		mutable std::condition_variable idle_;
+		std::shared_ptr<const GemStore::Snapshot> pending_;
+		SpellRecordCodec::Encoding pendingEncoding_{};
+		std::shared_ptr<const GemStore::Image> latest_;
+		bool busy_{};
+		Stats stats_{};
+		std::jthread worker_;
+	};
+}
@@ -0,0 +1,228 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                             Spell Record Codec                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/SpellRecordCodec.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace SpellGems::SpellRecordCodec
+{
+	namespace
+	{
+		constexpr std::uint8_t kControlTierMask = 0x07;
+		constexpr std::uint8_t kControlReusableStar = 1 << 3;
+		constexpr std::uint8_t kControlBlackSoulGem = 1 << 4;
+		constexpr std::uint8_t kControlUnlimited = 1 << 5;
+		constexpr std::uint8_t kControlHasTime = 1 << 6;
+		constexpr std::uint8_t kControlSameBase = 1 << 7;
+
+		// Control byte, four 5-byte varints and the raw time.
+		constexpr std::size_t kMaxCompressedEntrySize = 1 + 5 * 4 + 4;
+
+		// Byte-wise stores and loads keep the layout little-endian on any host; compilers fold them into plain moves.
+		void PutU32(std::uint8_t* out, std::uint32_t value)
+		{
+			out[0] = static_cast<std::uint8_t>(value);
+			out[1] = static_cast<std::uint8_t>(value >> 8);
+			out[2] = static_cast<std::uint8_t>(value >> 16);
+			out[3] = static_cast<std::uint8_t>(value >> 24);
+		}
+
+		std::uint32_t GetU32(const std::uint8_t* in)
+		{
+			return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 8) |
+			       (static_cast<std::uint32_t>(in[2]) << 16) | (static_cast<std::uint32_t>(in[3]) << 24);
+		}
+
+		std::uint8_t* PutVarint(std::uint8_t* out, std::uint32_t value)
+		{
+			while (value >= 0x80) {
+				*out++ = static_cast<std::uint8_t>(value | 0x80);
+				value >>= 7;
+			}
+			*out++ = static_cast<std::uint8_t>(value);
+			return out;
+		}
+
+		// Rejects varints that run past the end or past five bytes.
+		bool GetVarint(const std::uint8_t*& in, const std::uint8_t* end, std::uint32_t& value)
+		{
+			value = 0;
+			for (std::uint32_t shift = 0; shift < 35 && in < end; shift += 7) {
+				const auto byte = *in++;
+				value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		std::uint32_t ZigZag(std::int32_t value)
+		{
+			return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+		}
+
+		std::int32_t UnZigZag(std::uint32_t value)
+		{
+			return static_cast<std::int32_t>((value >> 1) ^ (~(value & 1) + 1));
+		}
+
+		// Appends the compressed stream for order to out, which already holds the header.
+		void EncodeCompressed(const GemTable& table, std::span<const GemKey> order, std::vector<std::uint8_t>& out)
+		{
+			const auto start = out.size();
+			out.resize(start + order.size() * kMaxCompressedEntrySize);
+			auto* cursor = out.data() + start;
+
+			GemKey previous{};
+			FormID previousSpell = 0;
+			for (const auto& key : order) {
+				const auto index = table.FindIndex(key);
+				if (index == GemTable::kNotFound) {
+					continue;
+				}
+
+				const auto& hot = table.GetHot(index);
+				const auto spellId = table.GetSpellId(index);
+				const bool sameBase = key.baseId == previous.baseId;
+				const bool unlimited = hot.usesRemaining == -1;
+				const bool hasTime = hot.lastUsedGameTime != 0.0f;
+
+				*cursor++ = static_cast<std::uint8_t>((static_cast<std::uint8_t>(hot.tier) & kControlTierMask) |
+				                                      ((hot.flags & GemTable::kReusableStar) ? kControlReusableStar : 0) |
+				                                      ((hot.flags & GemTable::kBlackSoulGem) ? kControlBlackSoulGem : 0) |
+				                                      (unlimited ? kControlUnlimited : 0) | (hasTime ? kControlHasTime : 0) |
+				                                      (sameBase ? kControlSameBase : 0));
+				if (!sameBase) {
+					cursor = PutVarint(cursor, key.baseId - previous.baseId);
+				}
+				cursor = PutVarint(cursor, sameBase ? static_cast<std::uint32_t>(key.uniqueId - previous.uniqueId) : key.uniqueId);
+				cursor = PutVarint(cursor, ZigZag(static_cast<std::int32_t>(spellId - previousSpell)));
+				if (!unlimited) {
+					cursor = PutVarint(cursor, ZigZag(hot.usesRemaining));
+				}
+				if (hasTime) {
+					PutU32(cursor, std::bit_cast<std::uint32_t>(hot.lastUsedGameTime));
+					cursor += 4;
+				}
+
+				previous = key;
+				previousSpell = spellId;
+			}
+			out.resize(static_cast<std::size_t>(cursor - out.data()));
+		}
+
+		std::size_t DecodeCompressed(std::span<const std::uint8_t> payload, std::uint32_t declared, std::vector<Entry>& out)
+		{
+			// Every entry is at least three bytes, which bounds the allocation for a corrupt count.
+			out.reserve(std::min<std::size_t>(declared, payload.size() / 3));
+			const auto* cursor = payload.data();
+			const auto* end = cursor + payload.size();
+
+			GemKey previous{};
+			FormID previousSpell = 0;
+			for (std::uint32_t i = 0; i < declared && cursor < end; ++i) {
+				const auto control = *cursor++;
+				const bool sameBase = (control & kControlSameBase) != 0;
+				Entry entry{};
+				auto& [key, data] = entry;
+
+				std::uint32_t value = 0;
+				if (sameBase) {
+					key.baseId = previous.baseId;
+				} else {
+					if (!GetVarint(cursor, end, value)) {
+						break;
+					}
+					key.baseId = previous.baseId + value;
+				}
+				if (!GetVarint(cursor, end, value)) {
+					break;
+				}
+				key.uniqueId = static_cast<std::uint16_t>(sameBase ? previous.uniqueId + value : value);
+				if (!GetVarint(cursor, end, value)) {
+					break;
+				}
+				data.spellId = previousSpell + static_cast<std::uint32_t>(UnZigZag(value));
+
+				data.tier = static_cast<SpellTier>(control & kControlTierMask);
+				data.isReusableStar = (control & kControlReusableStar) != 0;
+				data.isBlackSoulGem = (control & kControlBlackSoulGem) != 0;
+				if ((control & kControlUnlimited) != 0) {
+					data.usesRemaining = -1;
+				} else {
+					if (!GetVarint(cursor, end, value)) {
+						break;
+					}
+					data.usesRemaining = UnZigZag(value);
+				}
+				if ((control & kControlHasTime) != 0) {
+					if (end - cursor < 4) {
+						break;
+					}
+					data.lastUsedGameTime = std::bit_cast<float>(GetU32(cursor));
+					cursor += 4;
+				}
+
+				previous = key;
+				previousSpell = data.spellId;
+				out.push_back(entry);
+			}
+			return out.size();
+		}
+	}
+
+	// Replaces the contents of out with the v4 count prefix and every entry in table iteration order.
+	void EncodePacked(const GemTable& table, std::vector<std::uint8_t>& out)
+	{
+		SpellRecordSchema::Encode(table, SpellRecordSchema::kPackedVersion, out);
+	}
+
+	std::size_t DecodePacked(std::span<const std::uint8_t> body, std::vector<Entry>& out)
+	{
+		return SpellRecordSchema::Decode(body, SpellRecordSchema::kPackedVersion, out);
+	}
+
+	// Replaces the contents of out with the v5 header and the entries in the requested encoding.
+	void Encode(const GemTable& table, std::span<const GemKey> order, Encoding encoding, std::vector<std::uint8_t>& out)
+	{
+		const auto count = table.Size();
+		out.assign(kHeaderSize, 0);
+		PutU32(out.data(), static_cast<std::uint32_t>(count));
+		out[4] = static_cast<std::uint8_t>(encoding);
+
+		if (encoding == Encoding::Compressed) {
+			EncodeCompressed(table, order, out);
+			return;
+		}
+
+		out.resize(kHeaderSize + count * kPackedEntrySize);
+		SpellRecordSchema::WriteEntries(table, SpellRecordSchema::kPackedVersion, out.data() + kHeaderSize);
+	}
+
+	std::size_t Decode(std::span<const std::uint8_t> body, std::vector<Entry>& out)
+	{
+		out.clear();
+		if (body.size() < kHeaderSize) {
+			return 0;
+		}
+
+		const auto declared = GetU32(body.data());
+		const auto payload = body.subspan(kHeaderSize);
+		switch (static_cast<Encoding>(body[4])) {
+		case Encoding::Packed:
+			return SpellRecordSchema::ReadEntries(payload, SpellRecordSchema::kPackedVersion, declared, out);
+		case Encoding::Compressed:
+			return DecodeCompressed(payload, declared, out);
+		default:
+			return 0;
+		}
+	}
+}
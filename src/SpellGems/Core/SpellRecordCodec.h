@@ -0,0 +1,46 @@
+// Bulk encodings of the stored spell table for the v4+ co-save record: fixed-width packed and delta/varint compressed.
+#pragma once
+
+#include "SpellGems/Core/GemTable.h"
+#include "SpellGems/Core/GemTypes.h"
+#include "SpellGems/Core/SpellRecordSchema.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SpellGems::SpellRecordCodec
+{
+	enum class Encoding : std::uint8_t
+	{
+		Packed = 0,
+		Compressed = 1
+	};
+
+	// v4 body: u32 entry count, then per entry baseId u32, uniqueId u16, spellId u32, tier u8, usesRemaining i32,
+	// lastUsedGameTime f32 and a flags byte (bit 0 reusable star, bit 1 black soul gem), little-endian, no padding.
+	// SpellRecordSchema generates this layout and checks it against these numbers.
+	inline constexpr std::size_t kCountSize = SpellRecordSchema::kCountSize;
+	inline constexpr std::size_t kPackedEntrySize = SpellRecordSchema::kLayout<SpellRecordSchema::kPackedVersion>.entrySize;
+
+	// v5 body: an 8-byte header (u32 entry count, u8 encoding, three reserved zero bytes) followed by either the
+	// packed entries above or the compressed stream. Compressed entries are in (baseId, uniqueId) order, each a
+	// control byte (bits 0-2 tier, 3 reusable star, 4 black soul gem, 5 unlimited uses, 6 has last use time,
+	// 7 same baseId as the previous entry) followed by LEB128 varints: the baseId delta unless bit 7 is set, the
+	// uniqueId (delta when bit 7 is set), the zigzag spellId delta, zigzag usesRemaining unless bit 5 is set, then
+	// the raw f32 last use time when bit 6 is set.
+	inline constexpr std::size_t kHeaderSize = 8;
+
+	using Entry = SpellRecordSchema::Entry;
+
+	void EncodePacked(const GemTable& table, std::vector<std::uint8_t>& out);
+	std::size_t DecodePacked(std::span<const std::uint8_t> body, std::vector<Entry>& out);
+
+	// order must hold every key in the table, sorted by (baseId, uniqueId); the slot index already is.
+	void Encode(const GemTable& table, std::span<const GemKey> order, Encoding encoding, std::vector<std::uint8_t>& out);
+
+	// Decodes up to the declared count, stopping early at a truncated or malformed body. Returns the number of
+	// entries decoded.
+	std::size_t Decode(std::span<const std::uint8_t> body, std::vector<Entry>& out);
+}
@@ -0,0 +1,75 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                             Spell Record Schema                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/SpellRecordSchema.h"
+
+#include <algorithm>
+
+namespace SpellGems::SpellRecordSchema
+{
+	namespace
+	{
+		// Calls fn with the version as a compile-time constant. Returns false for versions without a fixed layout.
+		template <class Fn>
+		bool Dispatch(std::uint32_t version, Fn&& fn)
+		{
+			return [&]<std::uint32_t... V>(std::integer_sequence<std::uint32_t, V...>) {
+				return ((version == V + kFirstVersion ? (fn(std::integral_constant<std::uint32_t, V + kFirstVersion>{}), true) : false) || ...);
+			}(std::make_integer_sequence<std::uint32_t, kPackedVersion - kFirstVersion + 1>{});
+		}
+	}
+
+	std::size_t GetEntrySize(std::uint32_t version)
+	{
+		std::size_t size = 0;
+		Dispatch(version, [&](auto v) { size = kLayout<v()>.entrySize; });
+		return size;
+	}
+
+	void WriteEntries(const GemTable& table, std::uint32_t version, std::uint8_t* out)
+	{
+		Dispatch(version, [&](auto v) {
+			constexpr auto kSize = kLayout<v()>.entrySize;
+			for (std::size_t i = 0; i < table.Size(); ++i, out += kSize) {
+				WriteEntry<v()>(out, table.GetKey(i), table.GetData(i));
+			}
+		});
+	}
+
+	std::size_t ReadEntries(std::span<const std::uint8_t> payload, std::uint32_t version, std::size_t declared,
+		std::vector<Entry>& out)
+	{
+		out.clear();
+		Dispatch(version, [&](auto v) {
+			constexpr auto kSize = kLayout<v()>.entrySize;
+			out.resize(std::min(declared, payload.size() / kSize));
+			const auto* in = payload.data();
+			for (auto& entry : out) {
+				ReadEntry<v()>(in, entry);
+				in += kSize;
+			}
+		});
+		return out.size();
+	}
+
+	void Encode(const GemTable& table, std::uint32_t version, std::vector<std::uint8_t>& out)
+	{
+		out.resize(kCountSize + table.Size() * GetEntrySize(version));
+		Detail::Put(out.data(), static_cast<std::uint32_t>(table.Size()));
+		WriteEntries(table, version, out.data() + kCountSize);
+	}
+
+	std::size_t Decode(std::span<const std::uint8_t> body, std::uint32_t version, std::vector<Entry>& out)
+	{
+		out.clear();
+		if (body.size() < kCountSize) {
+			return 0;
+		}
+		return ReadEntries(body.subspan(kCountSize), version, Detail::Take<std::uint32_t>(body.data()), out);
+	}
+}
@@ -0,0 +1,252 @@
+// Compile-time field list of the stored spell record and the fixed-width entry layouts it generates for v1-v4.
+#pragma once
+
+#include "SpellGems/Core/GemTable.h"
+#include "SpellGems/Core/GemTypes.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SpellGems::SpellRecordSchema
+{
+	struct Entry
+	{
+		GemKey key;
+		StoredSpellData data;
+	};
+
+	// One record field: the member it maps to, the record version that introduced it and, for bools, its bit in
+	// the flags byte that packed layouts fold them into. Older layouts store every field as its own bytes.
+	template <auto Member, std::uint32_t Since, std::uint8_t FlagBit = 0>
+	struct Field;
+
+	template <class Owner, class T, T Owner::*Member, std::uint32_t Since, std::uint8_t FlagBit>
+	struct Field<Member, Since, FlagBit>
+	{
+		using Type = T;
+		static constexpr std::uint32_t kSince = Since;
+		static constexpr std::uint8_t kFlagBit = FlagBit;
+
+		static_assert(std::is_trivially_copyable_v<T>, "record fields are copied as raw bytes");
+		static_assert(FlagBit == 0 || std::is_same_v<T, bool>, "only bools fold into the flags byte");
+		static_assert(std::has_single_bit(static_cast<unsigned>(FlagBit)) || FlagBit == 0, "one bit per flag");
+
+		static const T& Get(const GemKey& key, const StoredSpellData& data)
+		{
+			if constexpr (std::is_same_v<Owner, GemKey>) {
+				return key.*Member;
+			} else {
+				return data.*Member;
+			}
+		}
+
+		static T& Get(Entry& entry)
+		{
+			if constexpr (std::is_same_v<Owner, GemKey>) {
+				return entry.key.*Member;
+			} else {
+				return entry.data.*Member;
+			}
+		}
+	};
+
+	// Record order. A new field goes at the end with the next version, so every older layout is a prefix.
+	using Fields = std::tuple<
+		Field<&GemKey::baseId, 1>,
+		Field<&GemKey::uniqueId, 1>,
+		Field<&StoredSpellData::spellId, 1>,
+		Field<&StoredSpellData::tier, 1>,
+		Field<&StoredSpellData::usesRemaining, 1>,
+		Field<&StoredSpellData::lastUsedGameTime, 1>,
+		Field<&StoredSpellData::isReusableStar, 2, 1 << 0>,
+		Field<&StoredSpellData::isBlackSoulGem, 3, 1 << 1>>;
+
+	inline constexpr std::size_t kFieldCount = std::tuple_size_v<Fields>;
+	inline constexpr std::uint32_t kFirstVersion = 1;
+	// From this version on, bools share one flags byte. Later versions keep this entry layout inside their header.
+	inline constexpr std::uint32_t kPackedVersion = 4;
+	inline constexpr std::size_t kCountSize = 4;
+	inline constexpr std::size_t kAbsent = ~std::size_t{ 0 };
+
+	struct Layout
+	{
+		std::array<std::size_t, kFieldCount> offsets{};
+		std::size_t flagsOffset{ kAbsent };
+		std::size_t entrySize{};
+	};
+
+	namespace Detail
+	{
+		struct FieldInfo
+		{
+			std::uint32_t since;
+			std::size_t size;
+			std::uint8_t flagBit;
+		};
+
+		template <std::size_t... I>
+		constexpr std::array<FieldInfo, kFieldCount> MakeInfo(std::index_sequence<I...>)
+		{
+			using std::tuple_element_t;
+			return { FieldInfo{ tuple_element_t<I, Fields>::kSince, sizeof(typename tuple_element_t<I, Fields>::Type),
+				tuple_element_t<I, Fields>::kFlagBit }... };
+		}
+
+		inline constexpr auto kInfo = MakeInfo(std::make_index_sequence<kFieldCount>{});
+
+		template <std::size_t Size>
+		using Bits = std::conditional_t<Size == 1, std::uint8_t,
+			std::conditional_t<Size == 2, std::uint16_t, std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+	}
+
+	constexpr Layout MakeLayout(std::uint32_t version)
+	{
+		Layout layout{};
+		std::size_t offset = 0;
+		for (std::size_t i = 0; i < kFieldCount; ++i) {
+			const auto& info = Detail::kInfo[i];
+			if (info.since > version) {
+				layout.offsets[i] = kAbsent;
+			} else if (version >= kPackedVersion && info.flagBit != 0) {
+				if (layout.flagsOffset == kAbsent) {
+					layout.flagsOffset = offset++;
+				}
+				layout.offsets[i] = layout.flagsOffset;
+			} else {
+				layout.offsets[i] = offset;
+				offset += info.size;
+			}
+		}
+		layout.entrySize = offset;
+		return layout;
+	}
+
+	template <std::uint32_t Version>
+	inline constexpr Layout kLayout = MakeLayout(Version);
+
+	constexpr bool FieldsInVersionOrder()
+	{
+		for (std::size_t i = 1; i < kFieldCount; ++i) {
+			if (Detail::kInfo[i].since < Detail::kInfo[i - 1].since ||
+				(Detail::kInfo[i - 1].flagBit != 0 && Detail::kInfo[i].flagBit == 0)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static_assert(FieldsInVersionOrder(), "fields must be appended in version order, flags last");
+	static_assert(kLayout<1>.entrySize == 19 && kLayout<2>.entrySize == 20 && kLayout<3>.entrySize == 21,
+		"legacy entry sizes changed");
+	static_assert(kLayout<kPackedVersion>.entrySize == 20, "packed entry size changed");
+	static_assert(kLayout<kPackedVersion>.offsets == std::array<std::size_t, kFieldCount>{ 0, 4, 6, 10, 11, 15, 19, 19 },
+		"packed field offsets changed");
+
+	namespace Detail
+	{
+		// Raw little-endian bytes; on little-endian hosts this is one unaligned copy per field.
+		template <class T>
+		void Put(std::uint8_t* out, const T& value)
+		{
+			const auto bits = std::bit_cast<Bits<sizeof(T)>>(value);
+			if constexpr (std::endian::native == std::endian::little) {
+				std::memcpy(out, &bits, sizeof(bits));
+			} else {
+				for (std::size_t i = 0; i < sizeof(bits); ++i) {
+					out[i] = static_cast<std::uint8_t>(bits >> (i * 8));
+				}
+			}
+		}
+
+		template <class T>
+		T Take(const std::uint8_t* in)
+		{
+			Bits<sizeof(T)> bits{};
+			if constexpr (std::endian::native == std::endian::little) {
+				std::memcpy(&bits, in, sizeof(bits));
+			} else {
+				for (std::size_t i = 0; i < sizeof(bits); ++i) {
+					bits |= static_cast<Bits<sizeof(T)>>(static_cast<Bits<sizeof(T)>>(in[i]) << (i * 8));
+				}
+			}
+			return std::bit_cast<T>(bits);
+		}
+
+		template <class F, std::size_t Offset, bool Packed>
+		void WriteField(std::uint8_t* out, const GemKey& key, const StoredSpellData& data)
+		{
+			using T = typename F::Type;
+			[[maybe_unused]] const auto& value = F::Get(key, data);
+			if constexpr (Offset == kAbsent) {
+				return;
+			} else if constexpr (std::is_same_v<T, bool>) {
+				if constexpr (Packed && F::kFlagBit != 0) {
+					out[Offset] |= value ? F::kFlagBit : 0;
+				} else {
+					out[Offset] = value ? 1 : 0;
+				}
+			} else {
+				Put(out + Offset, value);
+			}
+		}
+
+		template <class F, std::size_t Offset, bool Packed>
+		void ReadField(const std::uint8_t* in, Entry& entry)
+		{
+			using T = typename F::Type;
+			auto& value = F::Get(entry);
+			if constexpr (Offset == kAbsent) {
+				value = T{};
+			} else if constexpr (std::is_same_v<T, bool>) {
+				// Any nonzero byte is true; copying it into a bool directly would not be.
+				value = Packed && F::kFlagBit != 0 ? (in[Offset] & F::kFlagBit) != 0 : in[Offset] != 0;
+			} else {
+				value = Take<T>(in + Offset);
+			}
+		}
+	}
+
+	template <std::uint32_t Version>
+	void WriteEntry(std::uint8_t* out, const GemKey& key, const StoredSpellData& data)
+	{
+		if constexpr (kLayout<Version>.flagsOffset != kAbsent) {
+			out[kLayout<Version>.flagsOffset] = 0;
+		}
+		[&]<std::size_t... I>(std::index_sequence<I...>) {
+			(Detail::WriteField<std::tuple_element_t<I, Fields>, kLayout<Version>.offsets[I], (Version >= kPackedVersion)>(out,
+				 key, data),
+				...);
+		}(std::make_index_sequence<kFieldCount>{});
+	}
+
+	template <std::uint32_t Version>
+	void ReadEntry(const std::uint8_t* in, Entry& entry)
+	{
+		[&]<std::size_t... I>(std::index_sequence<I...>) {
+			(Detail::ReadField<std::tuple_element_t<I, Fields>, kLayout<Version>.offsets[I], (Version >= kPackedVersion)>(in,
+				 entry),
+				...);
+		}(std::make_index_sequence<kFieldCount>{});
+	}
+
+	// Entry size of a fixed-width version, or 0 for one without a fixed layout.
+	std::size_t GetEntrySize(std::uint32_t version);
+
+	// Entries at out + i * entry size, for the co-save record bodies that share these layouts.
+	void WriteEntries(const GemTable& table, std::uint32_t version, std::uint8_t* out);
+	std::size_t ReadEntries(std::span<const std::uint8_t> payload, std::uint32_t version, std::size_t declared,
+		std::vector<Entry>& out);
+
+	// Whole v1-v4 bodies: u32 entry count, then the entries. Decoding stops at the last whole entry; an unknown
+	// version decodes nothing.
+	void Encode(const GemTable& table, std::uint32_t version, std::vector<std::uint8_t>& out);
+	std::size_t Decode(std::span<const std::uint8_t> body, std::uint32_t version, std::vector<Entry>& out);
+}
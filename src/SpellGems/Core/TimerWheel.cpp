@@ -0,0 +1,242 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                 Timer Wheel                                                 //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Core/TimerWheel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace SpellGems
+{
+	// Arms a timer that fires after the given number of ticks, optionally repeating every period ticks.
+	TimerHandle TimerWheel::Arm(std::uint64_t delayTicks, Callback callback, std::uint64_t periodTicks)
+	{
+		if (!callback) {
+			return {};
+		}
+
+		const auto index = AllocateNode();
+		auto& node = nodes_[index];
+		node.callback = std::move(callback);
+		node.expiry = now_ + std::clamp<std::uint64_t>(delayTicks, 1, kMaxDelay);
+		node.period = std::min(periodTicks, kMaxDelay);
+		node.state = State::Linked;
+		node.cancelled = false;
+		Link(index);
+		++armedCount_;
+		return { index, node.generation };
+	}
+
+	// Cancels an armed timer; returns false when the handle is stale or already fired.
+	bool TimerWheel::Cancel(TimerHandle handle)
+	{
+		if (!IsArmed(handle)) {
+			return false;
+		}
+
+		auto& node = nodes_[handle.index];
+		if (node.state == State::Running) {
+			node.cancelled = true;
+			return true;
+		}
+
+		Unlink(handle.index);
+		ReleaseNode(handle.index);
+		return true;
+	}
+
+	bool TimerWheel::IsArmed(TimerHandle handle) const
+	{
+		if (handle.index >= nodes_.size()) {
+			return false;
+		}
+
+		const auto& node = nodes_[handle.index];
+		return node.generation == handle.generation && node.state != State::Free && !node.cancelled;
+	}
+
+	// Advances the wheel and appends every timer that expires along the way to expired, without running anything,
+	// so the caller can fire them after releasing whatever lock guards the wheel. Returns the number appended.
+	std::size_t TimerWheel::Advance(std::uint64_t ticks, std::vector<Expired>& expired)
+	{
+		std::size_t taken = 0;
+		for (std::uint64_t i = 0; i < ticks; ++i) {
+			++now_;
+			const auto slot = static_cast<std::uint32_t>(now_ & (kSlots - 1));
+			if (slot == 0) {
+				for (std::size_t level = 1; level < kLevels; ++level) {
+					Cascade(level);
+					if (((now_ >> (kSlotBits * level)) & (kSlots - 1)) != 0) {
+						break;
+					}
+				}
+			}
+
+			while (heads_[slot] != kNone) {
+				const auto index = heads_[slot];
+				Unlink(index);
+				LinkToList(index, kDueList);
+			}
+			taken += TakeDue(expired);
+
+			if (armedCount_ <= taken) {
+				// Nothing left linked, so the remaining ticks can be skipped wholesale.
+				now_ += ticks - i - 1;
+				break;
+			}
+		}
+		return taken;
+	}
+
+	// Returns an expired timer after its callback ran or was skipped. A repeating timer is re-armed one period from
+	// now unless it was cancelled meanwhile; anything else is released.
+	void TimerWheel::Finish(TimerHandle handle, Callback callback)
+	{
+		if (handle.index >= nodes_.size()) {
+			return;
+		}
+
+		auto& node = nodes_[handle.index];
+		if (node.generation != handle.generation || node.state != State::Running) {
+			return;
+		}
+
+		if (node.period == 0 || node.cancelled || !callback) {
+			ReleaseNode(handle.index);
+			return;
+		}
+
+		node.callback = std::move(callback);
+		node.state = State::Linked;
+		node.expiry = now_ + node.period;
+		Link(handle.index);
+	}
+
+	// Drops every armed timer. Generations are kept so outstanding handles stay stale.
+	void TimerWheel::Clear()
+	{
+		for (std::uint32_t index = 0; index < nodes_.size(); ++index) {
+			auto& node = nodes_[index];
+			if (node.state == State::Linked) {
+				Unlink(index);
+				ReleaseNode(index);
+			} else if (node.state == State::Running) {
+				node.cancelled = true;
+			}
+		}
+	}
+
+	std::uint64_t TimerWheel::GetCurrentTick() const
+	{
+		return now_;
+	}
+
+	std::size_t TimerWheel::GetArmedCount() const
+	{
+		return armedCount_;
+	}
+
+	std::uint32_t TimerWheel::AllocateNode()
+	{
+		if (!freeNodes_.empty()) {
+			const auto index = freeNodes_.back();
+			freeNodes_.pop_back();
+			return index;
+		}
+
+		nodes_.emplace_back();
+		return static_cast<std::uint32_t>(nodes_.size() - 1);
+	}
+
+	void TimerWheel::ReleaseNode(std::uint32_t index)
+	{
+		auto& node = nodes_[index];
+		node.callback = nullptr;
+		node.state = State::Free;
+		node.cancelled = false;
+		++node.generation;
+		freeNodes_.push_back(index);
+		--armedCount_;
+	}
+
+	// Places a node in the level whose span covers its remaining delay.
+	void TimerWheel::Link(std::uint32_t index)
+	{
+		const auto expiry = nodes_[index].expiry;
+		const auto delta = expiry > now_ ? expiry - now_ : 0;
+		std::size_t level = 0;
+		while (level + 1 < kLevels && delta >= (std::uint64_t{ 1 } << (kSlotBits * (level + 1)))) {
+			++level;
+		}
+
+		if (delta == 0) {
+			LinkToList(index, kDueList);
+			return;
+		}
+
+		const auto slot = (expiry >> (kSlotBits * level)) & (kSlots - 1);
+		LinkToList(index, static_cast<std::uint32_t>(level * kSlots + slot));
+	}
+
+	void TimerWheel::LinkToList(std::uint32_t index, std::uint32_t list)
+	{
+		auto& node = nodes_[index];
+		node.list = list;
+		node.prev = kNone;
+		node.next = heads_[list];
+		if (node.next != kNone) {
+			nodes_[node.next].prev = index;
+		}
+		heads_[list] = index;
+	}
+
+	void TimerWheel::Unlink(std::uint32_t index)
+	{
+		auto& node = nodes_[index];
+		if (node.prev != kNone) {
+			nodes_[node.prev].next = node.next;
+		} else {
+			heads_[node.list] = node.next;
+		}
+		if (node.next != kNone) {
+			nodes_[node.next].prev = node.prev;
+		}
+		node.prev = kNone;
+		node.next = kNone;
+		node.list = kNone;
+	}
+
+	// Redistributes the current slot of a higher level into the levels below it.
+	void TimerWheel::Cascade(std::size_t level)
+	{
+		const auto slot = static_cast<std::uint32_t>(level * kSlots + ((now_ >> (kSlotBits * level)) & (kSlots - 1)));
+		auto index = heads_[slot];
+		heads_[slot] = kNone;
+		while (index != kNone) {
+			const auto next = nodes_[index].next;
+			Link(index);
+			index = next;
+		}
+	}
+
+	// Moves everything on the due list out to expired. The nodes stay Running, and so stay cancellable, until Finish.
+	std::size_t TimerWheel::TakeDue(std::vector<Expired>& expired)
+	{
+		std::size_t taken = 0;
+		while (heads_[kDueList] != kNone) {
+			const auto index = heads_[kDueList];
+			Unlink(index);
+
+			auto& node = nodes_[index];
+			node.state = State::Running;
+			expired.push_back({ { index, node.generation }, std::move(node.callback) });
+			++taken;
+		}
+		return taken;
+	}
+}
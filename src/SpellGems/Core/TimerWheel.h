@@ -0,0 +1,104 @@
+// Hierarchical timer wheel used by the main-thread scheduler.
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace SpellGems
+{
+	struct TimerHandle
+	{
+		std::uint32_t index{ kInvalidIndex };
+		std::uint32_t generation{};
+
+		static constexpr std::uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+		bool IsValid() const
+		{
+			return index != kInvalidIndex;
+		}
+
+		friend bool operator==(const TimerHandle& lhs, const TimerHandle& rhs)
+		{
+			return lhs.index == rhs.index && lhs.generation == rhs.generation;
+		}
+	};
+
+	// Four levels of 64 slots each; arm and cancel are O(1), advancing is O(1) amortized per tick.
+	class TimerWheel
+	{
+	public:
+		using Callback = std::function<void()>;
+
+		// A timer that came due during Advance. Its callback is run by the caller, which then hands it back to Finish.
+		struct Expired
+		{
+			TimerHandle handle;
+			Callback callback;
+		};
+
+		static constexpr std::size_t kSlotBits = 6;
+		static constexpr std::size_t kSlots = std::size_t{ 1 } << kSlotBits;
+		static constexpr std::size_t kLevels = 4;
+		static constexpr std::uint64_t kMaxDelay = (std::uint64_t{ 1 } << (kSlotBits * kLevels)) - 1;
+
+		TimerHandle Arm(std::uint64_t delayTicks, Callback callback, std::uint64_t periodTicks = 0);
+		bool Cancel(TimerHandle handle);
+		bool IsArmed(TimerHandle handle) const;
+		std::size_t Advance(std::uint64_t ticks, std::vector<Expired>& expired);
+		void Finish(TimerHandle handle, Callback callback);
+		void Clear();
+
+		std::uint64_t GetCurrentTick() const;
+		std::size_t GetArmedCount() const;
+
+	private:
+		static constexpr std::uint32_t kNone = TimerHandle::kInvalidIndex;
+		static constexpr std::uint32_t kDueList = kLevels * kSlots;
+		static constexpr std::uint32_t kListCount = kDueList + 1;
+
+		enum class State : std::uint8_t
+		{
+			Free,
+			Linked,
+			Running
+		};
+
+		struct Node
+		{
+			Callback callback;
+			std::uint64_t expiry{};
+			std::uint64_t period{};
+			std::uint32_t prev{ kNone };
+			std::uint32_t next{ kNone };
+			std::uint32_t list{ kNone };
+			std::uint32_t generation{};
+			State state{ State::Free };
+			bool cancelled{};
+		};
+
+		std::uint32_t AllocateNode();
+		void ReleaseNode(std::uint32_t index);
+		void Link(std::uint32_t index);
+		void LinkToList(std::uint32_t index, std::uint32_t list);
+		void Unlink(std::uint32_t index);
+		void Cascade(std::size_t level);
+		std::size_t TakeDue(std::vector<Expired>& expired);
+
+		std::vector<Node> nodes_;
+		std::vector<std::uint32_t> freeNodes_;
+		std::array<std::uint32_t, kListCount> heads_{ MakeEmptyHeads() };
+		std::uint64_t now_{};
+		std::size_t armedCount_{};
+
+		static constexpr std::array<std::uint32_t, kListCount> MakeEmptyHeads()
+		{
+			std::array<std::uint32_t, kListCount> heads{};
+			heads.fill(kNone);
+			return heads;
+		}
+	};
+}
@@ -0,0 +1,134 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Free Cast Sessions                                             //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/FreeCastSession.h"
+
+#include <cassert>
+
+#include "RE/A/Actor.h"
+#include "REL/Relocation.h"
+
+namespace SpellGems
+{
+	namespace
+	{
+		// ActorMagicCaster::Update charges the running concentration cost every frame.
+		struct ActorMagicCasterUpdateHook
+		{
+			static void thunk(RE::ActorMagicCaster* a_this, float a_delta)
+			{
+				FreeCastSessions::GetSingleton().OnCasterUpdate(*a_this);
+				func(a_this, a_delta);
+			}
+
+			static inline REL::Relocation<decltype(thunk)> func;
+			static constexpr std::size_t idx = 0x1D;
+		};
+	}
+
+	// Returns the singleton free cast session table.
+	FreeCastSessions& FreeCastSessions::GetSingleton()
+	{
+		static FreeCastSessions instance;
+		return instance;
+	}
+
+	// Hooks the actor caster update so session costs can be zeroed before they are charged.
+	void FreeCastSessions::InstallHook()
+	{
+		REL::Relocation<std::uintptr_t> vtbl{ RE::VTABLE_ActorMagicCaster[0] };
+		ActorMagicCasterUpdateHook::func = vtbl.write_vfunc(ActorMagicCasterUpdateHook::idx, ActorMagicCasterUpdateHook::thunk);
+		logger::info("Free cast session caster hook installed.");
+	}
+
+	// Opens a session for the caster's source, remembering the cost it had before the gem cast.
+	void FreeCastSessions::Begin(RE::Actor& actor, RE::MagicCaster& caster)
+	{
+		AssertOwningThread();
+		const auto source = caster.GetCastingSource();
+		const auto index = ToIndex(source);
+		auto& session = sessions_[index];
+		if (!session.active || session.actor != &actor) {
+			session.previousCost = caster.currentSpellCost;
+		}
+
+		session.actor = &actor;
+		session.active = true;
+		sessionActors_[index].store(&actor, std::memory_order_relaxed);
+		activeMask_.fetch_or(1u << index, std::memory_order_release);
+		caster.currentSpellCost = 0.0f;
+	}
+
+	// Closes the session for a source and restores the caster's previous cost.
+	void FreeCastSessions::End(RE::Actor& actor, RE::MagicSystem::CastingSource source)
+	{
+		AssertOwningThread();
+		const auto index = ToIndex(source);
+		auto& session = sessions_[index];
+		if (!session.active || session.actor != &actor) {
+			return;
+		}
+
+		// Unpublish first so the hook cannot zero the cost again after it is restored.
+		activeMask_.fetch_and(~(1u << index), std::memory_order_release);
+		sessionActors_[index].store(nullptr, std::memory_order_relaxed);
+		if (auto* caster = actor.GetMagicCaster(source)) {
+			caster->currentSpellCost = session.previousCost;
+		}
+
+		session = {};
+	}
+
+	void FreeCastSessions::EndAll(RE::Actor& actor)
+	{
+		for (std::size_t i = 0; i < kSourceCount; ++i) {
+			End(actor, static_cast<RE::MagicSystem::CastingSource>(i));
+		}
+	}
+
+	bool FreeCastSessions::IsActive(RE::MagicSystem::CastingSource source) const
+	{
+		return sessions_[ToIndex(source)].active;
+	}
+
+	// Zeroes the pending charge for casters that belong to an open session. May run on any thread that updates actors.
+	void FreeCastSessions::OnCasterUpdate(RE::ActorMagicCaster& caster) const
+	{
+		const auto mask = activeMask_.load(std::memory_order_acquire);
+		if (mask == 0) {
+			return;
+		}
+
+		const auto index = ToIndex(caster.castingSource);
+		if ((mask & (1u << index)) == 0) {
+			return;
+		}
+
+		if (sessionActors_[index].load(std::memory_order_relaxed) != caster.actor) {
+			return;
+		}
+
+		caster.currentSpellCost = 0.0f;
+	}
+
+	// Sessions belong to the thread that opened the first one, which is the main thread.
+	void FreeCastSessions::AssertOwningThread()
+	{
+		const auto current = std::this_thread::get_id();
+		if (owningThread_ == std::thread::id{}) {
+			owningThread_ = current;
+		}
+		assert(owningThread_ == current && "free cast sessions are main-thread only");
+	}
+
+	std::size_t FreeCastSessions::ToIndex(RE::MagicSystem::CastingSource source)
+	{
+		const auto index = static_cast<std::size_t>(source);
+		return index < kSourceCount ? index : kSourceCount - 1;
+	}
+}
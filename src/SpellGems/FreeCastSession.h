@@ -0,0 +1,50 @@
+// Free cast sessions that zero the per-frame magicka charge of gem-fired casts.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "RE/A/ActorMagicCaster.h"
+#include "RE/M/MagicSystem.h"
+
+namespace SpellGems
+{
+	class FreeCastSessions
+	{
+	public:
+		static FreeCastSessions& GetSingleton();
+
+		void InstallHook();
+
+		void Begin(RE::Actor& actor, RE::MagicCaster& caster);
+		void End(RE::Actor& actor, RE::MagicSystem::CastingSource source);
+		void EndAll(RE::Actor& actor);
+		bool IsActive(RE::MagicSystem::CastingSource source) const;
+		void OnCasterUpdate(RE::ActorMagicCaster& caster) const;
+
+	private:
+		FreeCastSessions() = default;
+
+		struct Session
+		{
+			RE::Actor* actor{};
+			float previousCost{};
+			bool active{};
+		};
+
+		static constexpr std::size_t kSourceCount = 4;
+
+		static std::size_t ToIndex(RE::MagicSystem::CastingSource source);
+
+		void AssertOwningThread();
+
+		// Begin/End/IsActive run on the main thread only; sessions_ is never touched anywhere else.
+		std::array<Session, kSourceCount> sessions_{};
+		std::thread::id owningThread_{};
+		// What the caster hook reads. Actor updates can run on worker threads, so these are published atomically.
+		std::array<std::atomic<RE::Actor*>, kSourceCount> sessionActors_{};
+		std::atomic<std::uint32_t> activeMask_{ 0 };
+	};
+}
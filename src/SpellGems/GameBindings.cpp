@@ -0,0 +1,124 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                                Game Bindings                                                //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/GameBindings.h"
+
+#include "SpellGems/InventoryQueue.h"
+#include "SpellGems/SpellProfileCache.h"
+#include "SpellGems/StoredFormCache.h"
+
+#include "RE/C/Calendar.h"
+#include "RE/S/SpellItem.h"
+#include "RE/T/TESBoundObject.h"
+
+namespace SpellGems
+{
+	bool GameFormLookup::TryGetSpellSchools(FormID spellId, std::uint8_t& schoolMask) const
+	{
+		const auto* spell = StoredFormCache::GetSingleton().GetSpell(spellId);
+		if (!spell) {
+			return false;
+		}
+
+		schoolMask = SpellProfileCache::GetSingleton().Get(*spell).schoolMask;
+		return true;
+	}
+
+	bool GameFormLookup::TryGetGemTier(FormID gemId, SpellTier& tier) const
+	{
+		const auto* gem = StoredFormCache::GetSingleton().GetSoulGem(gemId);
+		if (!gem) {
+			return false;
+		}
+
+		tier = GetGemTier(*gem);
+		return true;
+	}
+
+	// Maps a soul gem's capacity to the spell tier it can hold; black gems count as grand.
+	SpellTier GameFormLookup::GetGemTier(const RE::TESSoulGem& gem)
+	{
+		if (gem.CanHoldNPCSoul()) {
+			return SpellTier::Master;
+		}
+
+		switch (gem.GetMaximumCapacity()) {
+		case RE::SOUL_LEVEL::kGrand:
+			return SpellTier::Master;
+		case RE::SOUL_LEVEL::kGreater:
+			return SpellTier::Expert;
+		case RE::SOUL_LEVEL::kCommon:
+			return SpellTier::Adept;
+		case RE::SOUL_LEVEL::kLesser:
+			return SpellTier::Apprentice;
+		case RE::SOUL_LEVEL::kPetty:
+			return SpellTier::Novice;
+		default:
+			return SpellTier::Novice;
+		}
+	}
+
+	void PlayerInventory::Add(FormID formId, std::int32_t count)
+	{
+		auto* form = StoredFormCache::GetSingleton().GetBoundObject(formId);
+		if (!form) {
+			logger::info("Inventory form {:08X} not found; skipping add.", formId);
+			return;
+		}
+
+		InventoryQueue::GetSingleton().QueueAdd(form, count);
+	}
+
+	void PlayerInventory::Remove(FormID formId, std::int32_t count)
+	{
+		auto* form = StoredFormCache::GetSingleton().GetBoundObject(formId);
+		if (!form) {
+			logger::info("Inventory form {:08X} not found; skipping remove.", formId);
+			return;
+		}
+
+		InventoryQueue::GetSingleton().QueueRemove(form, count);
+	}
+
+	float GameCalendar::GetCurrentGameTime() const
+	{
+		auto* calendar = RE::Calendar::GetSingleton();
+		return calendar ? calendar->GetCurrentGameTime() : 0.0f;
+	}
+
+	float GameCalendar::GetTimescale() const
+	{
+		auto* calendar = RE::Calendar::GetSingleton();
+		return calendar ? calendar->GetTimescale() : 1.0f;
+	}
+
+	bool SkseCoSaveWriter::OpenRecord(std::uint32_t type, std::uint32_t version)
+	{
+		return serialization_.OpenRecord(type, version);
+	}
+
+	bool SkseCoSaveWriter::WriteRaw(const void* data, std::uint32_t length)
+	{
+		return serialization_.WriteRecordData(data, length);
+	}
+
+	bool SkseCoSaveReader::GetNextRecordInfo(std::uint32_t& type, std::uint32_t& version, std::uint32_t& length)
+	{
+		return serialization_.GetNextRecordInfo(type, version, length);
+	}
+
+	std::uint32_t SkseCoSaveReader::ReadRaw(void* data, std::uint32_t length)
+	{
+		return serialization_.ReadRecordData(data, length);
+	}
+
+	bool SkseCoSaveReader::ResolveFormID(FormID oldId, FormID& newId) const
+	{
+		return serialization_.ResolveFormID(oldId, newId);
+	}
+}
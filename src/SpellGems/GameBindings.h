@@ -0,0 +1,62 @@
+// Game-backed implementations of the spell gem core interfaces.
+#pragma once
+
+#include "SpellGems/Core/Interfaces.h"
+
+#include <cstdint>
+
+#include "RE/T/TESSoulGem.h"
+#include "SKSE/Interfaces.h"
+
+namespace SpellGems
+{
+	class GameFormLookup : public IFormLookup
+	{
+	public:
+		bool TryGetSpellSchools(FormID spellId, std::uint8_t& schoolMask) const override;
+		bool TryGetGemTier(FormID gemId, SpellTier& tier) const override;
+
+		static SpellTier GetGemTier(const RE::TESSoulGem& gem);
+	};
+
+	// Routes core inventory changes for the player through the per-frame InventoryQueue, resolving forms through
+	// StoredFormCache rather than the global form map.
+	class PlayerInventory : public IInventory
+	{
+	public:
+		void Add(FormID formId, std::int32_t count) override;
+		void Remove(FormID formId, std::int32_t count) override;
+	};
+
+	class GameCalendar : public ICalendar
+	{
+	public:
+		float GetCurrentGameTime() const override;
+		float GetTimescale() const override;
+	};
+
+	class SkseCoSaveWriter : public ICoSaveWriter
+	{
+	public:
+		explicit SkseCoSaveWriter(SKSE::SerializationInterface& serialization) : serialization_(serialization) {}
+
+		bool OpenRecord(std::uint32_t type, std::uint32_t version) override;
+		bool WriteRaw(const void* data, std::uint32_t length) override;
+
+	private:
+		SKSE::SerializationInterface& serialization_;
+	};
+
+	class SkseCoSaveReader : public ICoSaveReader
+	{
+	public:
+		explicit SkseCoSaveReader(SKSE::SerializationInterface& serialization) : serialization_(serialization) {}
+
+		bool GetNextRecordInfo(std::uint32_t& type, std::uint32_t& version, std::uint32_t& length) override;
+		std::uint32_t ReadRaw(void* data, std::uint32_t length) override;
+		bool ResolveFormID(FormID oldId, FormID& newId) const override;
+
+	private:
+		SKSE::SerializationInterface& serialization_;
+	};
+}
@@ -0,0 +1,90 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                               Inventory Queue                                               //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/InventoryQueue.h"
+
+#include "SpellGems/Scheduler.h"
+
+#include "RE/I/ItemRemoveReason.h"
+#include "RE/P/PlayerCharacter.h"
+
+namespace SpellGems
+{
+	// Returns the singleton inventory queue.
+	InventoryQueue& InventoryQueue::GetSingleton()
+	{
+		static InventoryQueue instance;
+		return instance;
+	}
+
+	void InventoryQueue::QueueAdd(RE::TESBoundObject* form, std::int32_t count)
+	{
+		Queue(form, count);
+	}
+
+	void InventoryQueue::QueueRemove(RE::TESBoundObject* form, std::int32_t count)
+	{
+		Queue(form, -count);
+	}
+
+	// Applies the net change for every queued form to the player's inventory.
+	void InventoryQueue::Flush()
+	{
+		flushTimer_ = {};
+		applying_.swap(pending_);
+		pending_.clear();
+		if (applying_.empty()) {
+			return;
+		}
+
+		auto* player = RE::PlayerCharacter::GetSingleton();
+		if (!player) {
+			applying_.clear();
+			return;
+		}
+
+		for (const auto& entry : applying_) {
+			if (entry.delta < 0) {
+				player->RemoveItem(entry.form, -entry.delta, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
+			}
+		}
+		for (const auto& entry : applying_) {
+			if (entry.delta > 0) {
+				player->AddObjectToContainer(entry.form, nullptr, entry.delta, player);
+			}
+		}
+
+		logger::info("Applied {} batched inventory changes.", applying_.size());
+		applying_.clear();
+	}
+
+	void InventoryQueue::Queue(RE::TESBoundObject* form, std::int32_t delta)
+	{
+		if (!form || delta == 0) {
+			return;
+		}
+
+		bool merged = false;
+		for (auto& entry : pending_) {
+			if (entry.form == form) {
+				entry.delta += delta;
+				merged = true;
+				break;
+			}
+		}
+		if (!merged) {
+			pending_.push_back({ form, delta });
+		}
+
+		if (!flushTimer_.IsValid()) {
+			flushTimer_ = Scheduler::GetSingleton().ScheduleNextFrame([]() {
+				InventoryQueue::GetSingleton().Flush();
+			});
+		}
+	}
+}
@@ -0,0 +1,40 @@
+// Per-frame batching of player inventory adds and removes.
+#pragma once
+
+#include "SpellGems/Core/TimerWheel.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "RE/T/TESBoundObject.h"
+
+namespace SpellGems
+{
+	// Plain count changes queued during a frame are coalesced per form and applied once on the main thread,
+	// removals first, so the inventory menu refreshes once instead of once per call. Changes that carry an
+	// ExtraDataList are applied by the caller immediately; the game may free the list before the flush.
+	class InventoryQueue
+	{
+	public:
+		static InventoryQueue& GetSingleton();
+
+		void QueueAdd(RE::TESBoundObject* form, std::int32_t count);
+		void QueueRemove(RE::TESBoundObject* form, std::int32_t count);
+		void Flush();
+
+	private:
+		InventoryQueue() = default;
+
+		struct Pending
+		{
+			RE::TESBoundObject* form;
+			std::int32_t delta;
+		};
+
+		void Queue(RE::TESBoundObject* form, std::int32_t delta);
+
+		std::vector<Pending> pending_;
+		std::vector<Pending> applying_;
+		TimerHandle flushTimer_{};
+	};
+}
@@ -10,14 +10,14 @@
 #include "SpellGems/MenuUI.h"
 
 #include "SpellGems/Config.h"
+#include "SpellGems/Core/GemCommandQueue.h"
 #include "SpellGems/Serialization.h"
 #include "SpellGems/SpellGemManager.h"
+#include "SpellGems/StoredFormCache.h"
+#include "SpellGems/StoredGemFormPool.h"
 #include "include/SKSEMenuFramework.h"
 
 #include <string>
-#include <vector>
-
-#include "RE/T/TESForm.h"
 
 namespace SpellGems
 {
@@ -46,19 +46,7 @@ namespace SpellGems
 		if (ImGuiMCP::Checkbox("Finite Uses", &finiteUse)) {
 			config.SetFiniteUse(finiteUse);
 			logger::info("Finite Uses toggled: {}", finiteUse);
-			auto& serialization = Serialization::GetSingleton();
-			const auto& storedSpells = serialization.GetStoredSpells();
-			std::vector<std::pair<GemKey, StoredSpellData>> entries{ storedSpells.begin(), storedSpells.end() };
-			for (auto& [key, data] : entries) {
-				if (data.isReusableStar) {
-					data.usesRemaining = -1;
-				} else if (!finiteUse) {
-					data.usesRemaining = -1;
-				} else if (data.usesRemaining < 0) {
-					data.usesRemaining = config.GetTierSettings(data.tier).uses;
-				}
-				serialization.StoreSpell(key, data);
-			}
+			GemCommandQueue::GetSingleton().Push(GemCommandType::ReapplyUses);
 		}
 
 		bool requireFilled = config.RequireFilledSoulGem();
@@ -109,6 +97,12 @@ namespace SpellGems
 			logger::info("Show Uses Remaining toggled: {}", showUses);
 		}
 
+		bool compressSaveData = config.CompressSaveData();
+		if (ImGuiMCP::Checkbox("Compress Save Data", &compressSaveData)) {
+			config.SetCompressSaveData(compressSaveData);
+			logger::info("Compress Save Data toggled: {}", compressSaveData);
+		}
+
 		int storeKey = static_cast<int>(config.GetStoreKey());
 		if (ImGuiMCP::InputInt("Store Spell Key (DIK)", &storeKey, 1, 10)) {
 			if (storeKey > 0) {
@@ -121,7 +115,7 @@ namespace SpellGems
 		if (ImGuiMCP::SliderInt("Max Stored Gems", &maxStored, 1, 5)) {
 			config.SetMaxStoredGems(static_cast<std::uint8_t>(maxStored));
 			logger::info("Max stored gems updated: {}", maxStored);
-			SpellGemManager::GetSingleton().RegisterActivationKeys();
+			GemCommandQueue::GetSingleton().Push(GemCommandType::Refresh);
 		}
 
 		for (std::size_t i = 0; i < 5; ++i) {
@@ -141,20 +135,20 @@ namespace SpellGems
 
 		for (std::uint8_t i = 0; i < static_cast<std::uint8_t>(SpellTier::Total); ++i) {
 			auto tier = static_cast<SpellTier>(i);
-			auto& tierSettings = config.GetTierSettings(tier);
+			const auto tierSettings = config.GetTierSettings(tier);
 			const auto label = Config::GetTierName(tier);
 
 			ImGuiMCP::SeparatorText(label.data());
 
 			float cooldown = tierSettings.cooldown;
 			if (ImGuiMCP::SliderFloat(std::string(label).append(" Cooldown").c_str(), &cooldown, 1.0f, 30.0f, "%.1f s")) {
-				tierSettings.cooldown = cooldown;
+				config.SetTierCooldown(tier, cooldown);
 				logger::info("{} cooldown updated: {}", label, cooldown);
 			}
 
 			int uses = tierSettings.uses;
 			if (ImGuiMCP::SliderInt(std::string(label).append(" Uses").c_str(), &uses, 1, 20, "%d")) {
-				tierSettings.uses = uses;
+				config.SetTierUses(tier, uses);
 				logger::info("{} uses updated: {}", label, uses);
 			}
 
@@ -169,23 +163,54 @@ namespace SpellGems
 		ImGuiMCP::Spacing();
 		if (ImGuiMCP::Button("Save Settings")) {
 			config.Save();
-			logger::info("Settings saved from UI.");
+			logger::info("Settings save queued from UI.");
 		}
 
 		ImGuiMCP::Spacing();
 		ImGuiMCP::Separator();
-		auto& serialization = Serialization::GetSingleton();
-		const auto& storedSpells = serialization.GetStoredSpells();
-		static std::vector<std::pair<GemKey, StoredSpellData>> cachedSpells;
-		static bool needsRefresh = true;
-		if (needsRefresh || cachedSpells.size() != storedSpells.size()) {
-			cachedSpells.assign(storedSpells.begin(), storedSpells.end());
-			needsRefresh = false;
+		const auto storedGems = SpellGemManager::GetSingleton().GetStoredGemRows();
+		ImGuiMCP::Text("Stored Spell Gems (%zu)", storedGems->storedCount);
+		const auto poolStats = StoredGemFormPool::GetSingleton().GetStats();
+		ImGuiMCP::Text("Gem forms: %zu live, %zu free / %zu max (%llu created, %llu reused)",
+			poolStats.live, poolStats.free, StoredGemFormPool::kMaxForms,
+			static_cast<unsigned long long>(poolStats.created), static_cast<unsigned long long>(poolStats.reused));
+		const auto eventStats = SpellGemManager::GetSingleton().GetUseEventStats();
+		ImGuiMCP::Text("Container events: %llu seen, %llu prefiltered, %llu handled",
+			static_cast<unsigned long long>(eventStats.seen), static_cast<unsigned long long>(eventStats.prefiltered),
+			static_cast<unsigned long long>(eventStats.handled));
+		const auto commandStats = GemCommandQueue::GetSingleton().GetStats();
+		ImGuiMCP::Text("Commands: %llu queued, %llu dropped, depth %zu (max %zu), latency avg %lld us / max %lld us",
+			static_cast<unsigned long long>(commandStats.pushed), static_cast<unsigned long long>(commandStats.dropped),
+			commandStats.depth, commandStats.maxDepth,
+			static_cast<long long>(commandStats.averageLatencyUs), static_cast<long long>(commandStats.maxLatencyUs));
+		const auto saveStats = Serialization::GetSingleton().GetSaveStats();
+		const auto encoderStats = Serialization::GetSingleton().GetEncoderStats();
+		ImGuiMCP::Text("Saves: %llu (%llu pre-encoded), callback last %lld us / max %lld us, background encode last %lld us / max %lld us",
+			static_cast<unsigned long long>(saveStats.saves), static_cast<unsigned long long>(saveStats.preEncoded),
+			static_cast<long long>(saveStats.lastUs), static_cast<long long>(saveStats.maxUs),
+			static_cast<long long>(encoderStats.lastEncodeUs), static_cast<long long>(encoderStats.maxEncodeUs));
+		const auto formStats = StoredFormCache::GetSingleton().GetStats();
+		ImGuiMCP::Text("Form cache: %llu hits, %llu misses, %llu unresolved, %llu evicted, %zu spells / %zu gems / %zu items cached",
+			static_cast<unsigned long long>(formStats.hits), static_cast<unsigned long long>(formStats.misses),
+			static_cast<unsigned long long>(formStats.unresolved), static_cast<unsigned long long>(formStats.evicted),
+			formStats.spells, formStats.gems, formStats.objects);
+		const auto reloadStats = config.GetReloadStats();
+		const char* watcher = "no";
+		if (reloadStats.backend == FileWatcher::Backend::Native) {
+			watcher = "native";
+		} else if (reloadStats.backend == FileWatcher::Backend::Polling) {
+			watcher = "polling";
 		}
-
-		ImGuiMCP::Text("Stored Spell Gems (%zu)", cachedSpells.size());
+		ImGuiMCP::Text("Config: generation %u, reloads %llu applied, %llu rejected, %llu unchanged (%s watcher)",
+			config.GetGeneration(), static_cast<unsigned long long>(reloadStats.applied),
+			static_cast<unsigned long long>(reloadStats.rejected), static_cast<unsigned long long>(reloadStats.unchanged), watcher);
+		const auto writerStats = config.GetWriterStats();
+		ImGuiMCP::Text("Config writes: %llu written (%llu coalesced, %llu failed), last %lld us / max %lld us",
+			static_cast<unsigned long long>(writerStats.written), static_cast<unsigned long long>(writerStats.superseded),
+			static_cast<unsigned long long>(writerStats.failed), static_cast<long long>(writerStats.lastWriteUs),
+			static_cast<long long>(writerStats.maxWriteUs));
 		if (ImGuiMCP::Button("Refresh List")) {
-			needsRefresh = true;
+			GemCommandQueue::GetSingleton().Push(GemCommandType::RefreshRows);
 		}
 
 		if (ImGuiMCP::BeginTable("StoredSpellGems", 7)) {
@@ -199,33 +224,25 @@ namespace SpellGems
 			ImGuiMCP::TableHeadersRow();
 
 			std::size_t slotIndex = 0;
-			for (const auto& [key, data] : cachedSpells) {
-				const auto* gemForm = RE::TESForm::LookupByID(key.baseId);
-				const auto* spellForm = RE::TESForm::LookupByID(data.spellId);
-				const char* gemName = gemForm ? gemForm->GetName() : "Unknown Gem";
-				const char* spellName = spellForm ? spellForm->GetName() : "Unknown Spell";
-				const auto tierName = Config::GetTierName(data.tier);
-				bool removed = false;
-
+			for (const auto& row : storedGems->rows) {
 				ImGuiMCP::TableNextRow();
 				ImGuiMCP::TableNextColumn();
 				ImGuiMCP::Text("%zu", slotIndex + 1);
 				ImGuiMCP::TableNextColumn();
-				ImGuiMCP::Text("%s", gemName);
+				ImGuiMCP::Text("%s", row.gemName.c_str());
 				ImGuiMCP::TableNextColumn();
-				ImGuiMCP::Text("%s (%s)", spellName, tierName.data());
+				ImGuiMCP::Text("%s", row.spellName.c_str());
 				ImGuiMCP::TableNextColumn();
-				if (data.usesRemaining < 0) {
+				if (row.usesRemaining < 0) {
 					ImGuiMCP::Text("Infinite");
 				} else {
-					ImGuiMCP::Text("%d", data.usesRemaining);
+					ImGuiMCP::Text("%d", row.usesRemaining);
 				}
 				ImGuiMCP::TableNextColumn();
-				const auto& tierSettings = config.GetTierSettings(data.tier);
-				ImGuiMCP::Text("%.1f s", tierSettings.cooldown);
+				ImGuiMCP::Text("%.1f s", row.cooldownSeconds);
 				ImGuiMCP::TableNextColumn();
 				int activationKey = static_cast<int>(config.GetActivationKey(slotIndex));
-				ImGuiMCP::PushID(static_cast<int>(key.baseId ^ (key.uniqueId << 1)));
+				ImGuiMCP::PushID(static_cast<int>(row.key.baseId ^ (row.key.uniqueId << 1)));
 				if (ImGuiMCP::InputInt("##key", &activationKey, 1, 10)) {
 					if (activationKey > 0) {
 						config.SetActivationKey(slotIndex, static_cast<std::uint32_t>(activationKey));
@@ -233,20 +250,15 @@ namespace SpellGems
 					}
 				}
 				ImGuiMCP::TableNextColumn();
-				if (ImGuiMCP::Button("Remove")) {
-					serialization.RemoveStoredSpell(key);
-					removed = true;
+				const bool removed = ImGuiMCP::Button("Remove");
+				if (removed) {
+					GemCommandQueue::GetSingleton().Push(GemCommandType::Remove, row.key);
 				}
 				ImGuiMCP::PopID();
 				if (removed) {
-					needsRefresh = true;
 					break;
 				}
-
 				++slotIndex;
-				if (slotIndex >= config.GetMaxStoredGems()) {
-					break;
-				}
 			}
 
 			ImGuiMCP::EndTable();
@@ -0,0 +1,155 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                             Main Thread Scheduler                                           //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/Scheduler.h"
+
+#include <cmath>
+
+#include "REL/Relocation.h"
+#include "SKSE/Trampoline.h"
+
+namespace SpellGems
+{
+	namespace
+	{
+		// One wheel tick per millisecond.
+		constexpr float kTicksPerSecond = 1000.0f;
+
+		// Call into Main::Update's per-frame work, used to pump the scheduler once per frame.
+		struct MainUpdateHook
+		{
+			static void thunk(RE::Main* a_this, float a_delta)
+			{
+				func(a_this, a_delta);
+				Scheduler::GetSingleton().Update();
+			}
+
+			static inline REL::Relocation<decltype(thunk)> func;
+		};
+	}
+
+	// Returns the singleton scheduler instance.
+	Scheduler& Scheduler::GetSingleton()
+	{
+		static Scheduler instance;
+		return instance;
+	}
+
+	// Installs the per-frame hook using the plugin trampoline.
+	void Scheduler::InstallHook()
+	{
+		REL::Relocation<std::uintptr_t> target{ RELOCATION_ID(35565, 36564), REL::VariantOffset(0x748, 0xC26, 0x7EE) };
+		auto& trampoline = SKSE::GetTrampoline();
+		MainUpdateHook::func = trampoline.write_call<5>(target.address(), MainUpdateHook::thunk);
+		logger::info("Scheduler main update hook installed.");
+	}
+
+	// Schedules a one-shot callback on the main thread.
+	TimerHandle Scheduler::Schedule(float delaySeconds, Callback callback)
+	{
+		std::scoped_lock lock(mutex_);
+		return wheel_.Arm(ToTicks(delaySeconds), std::move(callback));
+	}
+
+	// Schedules a callback that fires on the main thread every interval until cancelled.
+	TimerHandle Scheduler::ScheduleRepeating(float intervalSeconds, Callback callback)
+	{
+		std::scoped_lock lock(mutex_);
+		const auto interval = ToTicks(intervalSeconds);
+		return wheel_.Arm(interval, std::move(callback), interval);
+	}
+
+	// Schedules a callback for the next scheduler update.
+	TimerHandle Scheduler::ScheduleNextFrame(Callback callback)
+	{
+		std::scoped_lock lock(mutex_);
+		return wheel_.Arm(1, std::move(callback));
+	}
+
+	// Cancels a scheduled callback and resets the handle.
+	void Scheduler::Cancel(TimerHandle& handle)
+	{
+		if (!handle.IsValid()) {
+			return;
+		}
+
+		std::scoped_lock lock(mutex_);
+		wheel_.Cancel(handle);
+		handle = {};
+	}
+
+	// Registers a callback that runs on the main thread at the start of every scheduler update.
+	void Scheduler::AddFrameCallback(Callback callback)
+	{
+		if (!callback) {
+			return;
+		}
+
+		std::scoped_lock lock(mutex_);
+		auto callbacks = std::make_shared<std::vector<Callback>>(*frameCallbacks_);
+		callbacks->push_back(std::move(callback));
+		frameCallbacks_ = std::move(callbacks);
+	}
+
+	// Runs frame callbacks, then advances the timer wheel by the real time elapsed since the last frame. Callbacks
+	// run outside the lock so producers on other threads never wait behind a frame's work, and anything they
+	// schedule or cancel goes through the public calls like any other caller.
+	void Scheduler::Update()
+	{
+		std::shared_ptr<const std::vector<Callback>> callbacks;
+		{
+			std::scoped_lock lock(mutex_);
+			callbacks = frameCallbacks_;
+		}
+		for (const auto& callback : *callbacks) {
+			callback();
+		}
+
+		{
+			std::scoped_lock lock(mutex_);
+			const auto now = Clock::now();
+			if (!hasLastUpdate_) {
+				lastUpdate_ = now;
+				hasLastUpdate_ = true;
+				return;
+			}
+
+			const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUpdate_);
+			if (elapsed.count() <= 0) {
+				return;
+			}
+
+			lastUpdate_ += elapsed;
+			wheel_.Advance(static_cast<std::uint64_t>(elapsed.count()), expired_);
+		}
+
+		// A timer cancelled by an earlier callback in this batch is skipped.
+		for (auto& timer : expired_) {
+			bool armed = false;
+			{
+				std::scoped_lock lock(mutex_);
+				armed = wheel_.IsArmed(timer.handle);
+			}
+			if (armed) {
+				timer.callback();
+			}
+
+			std::scoped_lock lock(mutex_);
+			wheel_.Finish(timer.handle, std::move(timer.callback));
+		}
+		expired_.clear();
+	}
+
+	std::uint64_t Scheduler::ToTicks(float seconds)
+	{
+		if (!(seconds > 0.0f)) {
+			return 1;
+		}
+		return static_cast<std::uint64_t>(std::ceil(seconds * kTicksPerSecond));
+	}
+}
@@ -0,0 +1,46 @@
+// Main-thread scheduler driven by a per-frame update hook.
+#pragma once
+
+#include "SpellGems/Core/TimerWheel.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SpellGems
+{
+	class Scheduler
+	{
+	public:
+		using Callback = TimerWheel::Callback;
+		using Clock = std::chrono::steady_clock;
+
+		static Scheduler& GetSingleton();
+
+		void InstallHook();
+
+		TimerHandle Schedule(float delaySeconds, Callback callback);
+		TimerHandle ScheduleRepeating(float intervalSeconds, Callback callback);
+		TimerHandle ScheduleNextFrame(Callback callback);
+		void Cancel(TimerHandle& handle);
+		void AddFrameCallback(Callback callback);
+
+		void Update();
+
+	private:
+		Scheduler() = default;
+
+		static std::uint64_t ToTicks(float seconds);
+
+		TimerWheel wheel_;
+		// Update's scratch list of expired timers; only the main thread touches it.
+		std::vector<TimerWheel::Expired> expired_;
+		// Replaced, never modified, so Update can run the callbacks after releasing the lock.
+		std::shared_ptr<const std::vector<Callback>> frameCallbacks_{ std::make_shared<const std::vector<Callback>>() };
+		// Guards the wheel and the frame callback list. Never held while a callback runs.
+		std::mutex mutex_;
+		Clock::time_point lastUpdate_{};
+		bool hasLastUpdate_{ false };
+	};
+}
@@ -8,7 +8,13 @@
 
 #include "SpellGems/Serialization.h"
 
-#include <algorithm>
+#include "SpellGems/Config.h"
+#include "SpellGems/GameBindings.h"
+#include "SpellGems/SpellGemManager.h"
+#include "SpellGems/StoredFormCache.h"
+#include "SpellGems/StoredGemFormPool.h"
+
+#include <chrono>
 #include <vector>
 
 #include "SKSE/API.h"
@@ -17,10 +23,8 @@ namespace SpellGems
 {
 	namespace
 	{
-		constexpr std::uint32_t kSerializationVersion = 3;
 		constexpr std::uint32_t kPluginId = 'SGEM';
-		constexpr std::uint32_t kRecordSpells = 'SPEL';
-		constexpr std::uint32_t kRecordState = 'STAT';
+		constexpr std::uint32_t kRecordFormPool = 'POOL';
 	}
 
 	// Returns the singleton serialization manager.
@@ -30,6 +34,11 @@ namespace SpellGems
 		return instance;
 	}
 
+	Serialization::Serialization()
+	{
+		store_.SetObserver(&storeObserver_);
+	}
+
 	// Registers serialization callbacks with SKSE.
 	void Serialization::Initialize(const SKSE::SerializationInterface* serialization)
 	{
@@ -53,27 +62,34 @@ namespace SpellGems
 			return;
 		}
 
-		logger::info("Saving {} stored spell entries.", storedSpells_.size());
+		const auto start = std::chrono::steady_clock::now();
+		store_.SetRecordEncoding(GetConfiguredEncoding());
 
-		if (serialization->OpenRecord(kRecordState, kSerializationVersion)) {
-			serialization->WriteRecordData(nextUniqueId_);
+		// Hand over the worker's image when it matches the store; otherwise encode here as before.
+		SkseCoSaveWriter writer{ *serialization };
+		const auto image = encoder_.GetLatest();
+		const bool preEncoded = image && store_.IsCurrent(*image);
+		if (preEncoded) {
+			store_.SaveImage(writer, *image);
+		} else {
+			store_.Save(writer);
 		}
 
-		if (serialization->OpenRecord(kRecordSpells, kSerializationVersion)) {
-			const std::uint32_t count = static_cast<std::uint32_t>(storedSpells_.size());
-			serialization->WriteRecordData(count);
-
-			for (const auto& [key, data] : storedSpells_) {
-				serialization->WriteRecordData(key.baseId);
-				serialization->WriteRecordData(key.uniqueId);
-				serialization->WriteRecordData(data.spellId);
-				serialization->WriteRecordData(data.tier);
-				serialization->WriteRecordData(data.usesRemaining);
-				serialization->WriteRecordData(data.lastUsedGameTime);
-				serialization->WriteRecordData(data.isReusableStar);
-				serialization->WriteRecordData(data.isBlackSoulGem);
-			}
+		if (serialization->OpenRecord(kRecordFormPool, StoredGemFormPool::kRecordVersion)) {
+			StoredGemFormPool::GetSingleton().Save(serialization);
+		}
+
+		const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		saveCount_.fetch_add(1, std::memory_order_relaxed);
+		if (preEncoded) {
+			preEncodedCount_.fetch_add(1, std::memory_order_relaxed);
 		}
+		lastSaveUs_.store(elapsedUs, std::memory_order_relaxed);
+		if (elapsedUs > maxSaveUs_.load(std::memory_order_relaxed)) {
+			maxSaveUs_.store(elapsedUs, std::memory_order_relaxed);
+		}
+		logger::info("Saved {} stored spell entries in {} us ({}).", store_.Size(), elapsedUs,
+			preEncoded ? "pre-encoded" : "encoded inline");
 	}
 
 	// Restores stored spell data from the save file.
@@ -84,55 +100,24 @@ namespace SpellGems
 			return;
 		}
 
-		storedSpells_.clear();
+		store_.ClearEntries();
+		StoredGemFormPool::GetSingleton().Clear();
+		SpellGemManager::GetSingleton().ClearCastPlans();
 		logger::info("Loading stored spell data.");
 
+		SkseCoSaveReader reader{ *serialization };
 		std::uint32_t type = 0;
 		std::uint32_t version = 0;
 		std::uint32_t length = 0;
-		while (serialization->GetNextRecordInfo(type, version, length)) {
+		while (reader.GetNextRecordInfo(type, version, length)) {
+			if (store_.LoadRecord(reader, type, version, length)) {
+				continue;
+			}
+
 			switch (type) {
-			case kRecordState:
-				serialization->ReadRecordData(nextUniqueId_);
-				break;
-			case kRecordSpells: {
-				std::uint32_t count = 0;
-				serialization->ReadRecordData(count);
-				for (std::uint32_t i = 0; i < count; ++i) {
-					GemKey key{};
-					StoredSpellData data{};
-					serialization->ReadRecordData(key.baseId);
-					serialization->ReadRecordData(key.uniqueId);
-					serialization->ReadRecordData(data.spellId);
-					serialization->ReadRecordData(data.tier);
-					serialization->ReadRecordData(data.usesRemaining);
-					serialization->ReadRecordData(data.lastUsedGameTime);
-					if (version >= 2) {
-						serialization->ReadRecordData(data.isReusableStar);
-					} else {
-						data.isReusableStar = false;
-					}
-					if (version >= 3) {
-						serialization->ReadRecordData(data.isBlackSoulGem);
-					} else {
-						data.isBlackSoulGem = false;
-					}
-
-					RE::FormID resolvedSpell = 0;
-					if (!serialization->ResolveFormID(data.spellId, resolvedSpell)) {
-						continue;
-					}
-					data.spellId = resolvedSpell;
-
-					RE::FormID resolvedGem = 0;
-					if (!serialization->ResolveFormID(key.baseId, resolvedGem)) {
-						continue;
-					}
-					key.baseId = resolvedGem;
-					storedSpells_.emplace(key, data);
-				}
+			case kRecordFormPool:
+				StoredGemFormPool::GetSingleton().Load(serialization, version);
 				break;
-			}
 			default: {
 				std::vector<std::uint8_t> buffer(length);
 				serialization->ReadRecordData(buffer.data(), length);
@@ -140,64 +125,143 @@ namespace SpellGems
 			}
 			}
 		}
+
+		const auto loadStats = store_.GetLoadStats();
+		if (loadStats.corrupt > 0) {
+			logger::info("{} of {} stored spell records failed their checksum; salvaged {} entries, dropped {}.",
+				loadStats.corrupt, loadStats.records, loadStats.salvaged, loadStats.dropped);
+		}
+
+		auto& formPool = StoredGemFormPool::GetSingleton();
+		formPool.ResetReferences();
+		for (const auto& [key, _] : store_.GetEntries()) {
+			formPool.AddRef(key.baseId);
+		}
+
+		// Resolve every stored form once here so activations and the menu never take the form map lock.
+		auto& forms = StoredFormCache::GetSingleton();
+		forms.Clear();
+		forms.WarmAll(store_.GetEntries());
 	}
 
 	// Clears runtime spell data when a save is reverted.
 	void Serialization::Revert()
 	{
-		storedSpells_.clear();
-		nextUniqueId_ = 1;
+		store_.Clear();
+		StoredGemFormPool::GetSingleton().Clear();
+		SpellGemManager::GetSingleton().ClearCastPlans();
+		StoredFormCache::GetSingleton().Clear();
 		logger::info("Serialization revert complete.");
 	}
 
-	bool Serialization::HasStoredSpell(const GemKey& key) const
+	// Submits a snapshot to the background encoder when the store or the configured encoding changed since the last
+	// one. Runs on the main thread every kSnapshotInterval.
+	void Serialization::RefreshSaveImage()
+	{
+		const auto encoding = GetConfiguredEncoding();
+		store_.SetRecordEncoding(encoding);
+		if (store_.GetGeneration() == submittedGeneration_ && encoding == submittedEncoding_) {
+			return;
+		}
+
+		encoder_.Submit(store_.CaptureSnapshot(), encoding);
+		submittedGeneration_ = store_.GetGeneration();
+		submittedEncoding_ = encoding;
+	}
+
+	Serialization::SaveStats Serialization::GetSaveStats() const
 	{
-		return storedSpells_.contains(key);
+		return {
+			saveCount_.load(std::memory_order_relaxed),
+			preEncodedCount_.load(std::memory_order_relaxed),
+			lastSaveUs_.load(std::memory_order_relaxed),
+			maxSaveUs_.load(std::memory_order_relaxed),
+		};
 	}
 
-	const StoredSpellData* Serialization::GetStoredSpell(const GemKey& key) const
+	SnapshotEncoder::Stats Serialization::GetEncoderStats() const
 	{
-		auto it = storedSpells_.find(key);
-		if (it == storedSpells_.end()) {
-			return nullptr;
-		}
+		return encoder_.GetStats();
+	}
 
-		return std::addressof(it->second);
+	SpellRecordCodec::Encoding Serialization::GetConfiguredEncoding()
+	{
+		return Config::GetSingleton().CompressSaveData() ? SpellRecordCodec::Encoding::Compressed : SpellRecordCodec::Encoding::Packed;
+	}
+
+	bool Serialization::HasStoredSpell(const GemKey& key) const
+	{
+		return store_.Has(key);
+	}
+
+	std::optional<StoredSpellData> Serialization::GetStoredSpell(const GemKey& key) const
+	{
+		return store_.Get(key);
 	}
 
 	void Serialization::StoreSpell(const GemKey& key, const StoredSpellData& data)
 	{
-		storedSpells_[key] = data;
+		store_.Store(key, data);
+		StoredFormCache::GetSingleton().Warm(key, data);
 		logger::info("Stored spell {} in gem {:08X} (unique {}).", data.spellId, key.baseId, key.uniqueId);
 	}
 
 	void Serialization::RemoveStoredSpell(const GemKey& key)
 	{
-		if (storedSpells_.erase(key) > 0) {
+		if (store_.Remove(key)) {
 			logger::info("Removed stored spell from gem {:08X} (unique {}).", key.baseId, key.uniqueId);
 		}
 	}
 
 	bool Serialization::TryGetStoredSpellByBaseId(RE::FormID baseId, GemKey& key, StoredSpellData& data) const
 	{
-		for (const auto& [storedKey, storedData] : storedSpells_) {
-			if (storedKey.baseId == baseId) {
-				key = storedKey;
-				data = storedData;
-				return true;
-			}
-		}
-		return false;
+		return store_.TryGetByBaseId(baseId, key, data);
+	}
+
+	std::span<const std::uint16_t> Serialization::GetStoredSpellInstances(RE::FormID baseId) const
+	{
+		return store_.GetInstances(baseId);
+	}
+
+	const GemStore::Table& Serialization::GetStoredSpells() const
+	{
+		return store_.GetEntries();
 	}
 
-	const std::unordered_map<GemKey, StoredSpellData, GemKeyHash>& Serialization::GetStoredSpells() const
+	const GemSlotIndex& Serialization::GetSlotIndex() const
 	{
-		return storedSpells_;
+		return store_.GetSlotIndex();
 	}
 
+	const GemBaseFilter& Serialization::GetBaseFilter() const
+	{
+		return store_.GetBaseFilter();
+	}
+
+	GemStore& Serialization::GetStore()
+	{
+		return store_;
+	}
+
+	// Returns 0 when every unique ID is held by a stored gem.
 	std::uint16_t Serialization::AllocateUniqueId()
 	{
-		return nextUniqueId_++;
+		const auto uniqueId = store_.AllocateUniqueId();
+		if (uniqueId == 0) {
+			logger::info("No free unique IDs left ({} in use).", store_.GetIdAllocator().GetUsedCount() - 1);
+		}
+		return uniqueId;
+	}
+
+	void Serialization::StoreObserver::OnInserted(const GemKey& key)
+	{
+		StoredGemFormPool::GetSingleton().AddRef(key.baseId);
+	}
+
+	void Serialization::StoreObserver::OnErased(const GemKey& key)
+	{
+		StoredGemFormPool::GetSingleton().Release(key.baseId);
+		SpellGemManager::GetSingleton().ForgetCastPlan(key);
 	}
 
 	// SKSE save callback entry point.
@@ -2,69 +2,85 @@
 #pragma once
 
 #include "SpellGems/Config.h"
+#include "SpellGems/Core/GemBaseFilter.h"
+#include "SpellGems/Core/GemSlotIndex.h"
+#include "SpellGems/Core/GemStore.h"
+#include "SpellGems/Core/GemTypes.h"
+#include "SpellGems/Core/SnapshotEncoder.h"
 
+#include <atomic>
 #include <cstdint>
-#include <unordered_map>
+#include <optional>
+#include <span>
 
 #include "RE/F/FormTypes.h"
 #include "SKSE/Interfaces.h"
 
 namespace SpellGems
 {
-	struct GemKey
+	class Serialization
 	{
-		RE::FormID baseId{};
-		std::uint16_t uniqueId{};
-
-		friend bool operator==(const GemKey& lhs, const GemKey& rhs)
+	public:
+		// Wall time spent inside the SKSE save callback.
+		struct SaveStats
 		{
-			return lhs.baseId == rhs.baseId && lhs.uniqueId == rhs.uniqueId;
-		}
-	};
+			std::uint64_t saves;
+			std::uint64_t preEncoded;
+			std::int64_t lastUs;
+			std::int64_t maxUs;
+		};
 
-	struct GemKeyHash
-	{
-		std::size_t operator()(const GemKey& key) const noexcept
-		{
-			return (static_cast<std::size_t>(key.baseId) << 16) ^ key.uniqueId;
-		}
-	};
+		static constexpr float kSnapshotInterval = 0.25f;
 
-	struct StoredSpellData
-	{
-		RE::FormID spellId{};
-		SpellTier tier{};
-		std::int32_t usesRemaining{};
-		float lastUsedGameTime{};
-		bool isReusableStar{};
-		bool isBlackSoulGem{};
-	};
-
-	class Serialization
-	{
-	public:
 		static Serialization& GetSingleton();
 
 		void Initialize(const SKSE::SerializationInterface* serialization);
 		void Save(SKSE::SerializationInterface* serialization);
 		void Load(SKSE::SerializationInterface* serialization);
 		void Revert();
+		void RefreshSaveImage();
 
 		bool HasStoredSpell(const GemKey& key) const;
-		const StoredSpellData* GetStoredSpell(const GemKey& key) const;
+		std::optional<StoredSpellData> GetStoredSpell(const GemKey& key) const;
 		void StoreSpell(const GemKey& key, const StoredSpellData& data);
 		void RemoveStoredSpell(const GemKey& key);
 		bool TryGetStoredSpellByBaseId(RE::FormID baseId, GemKey& key, StoredSpellData& data) const;
-		const std::unordered_map<GemKey, StoredSpellData, GemKeyHash>& GetStoredSpells() const;
+		std::span<const std::uint16_t> GetStoredSpellInstances(RE::FormID baseId) const;
+		const GemStore::Table& GetStoredSpells() const;
+		const GemSlotIndex& GetSlotIndex() const;
+		const GemBaseFilter& GetBaseFilter() const;
+		GemStore& GetStore();
 
 		std::uint16_t AllocateUniqueId();
 
+		SaveStats GetSaveStats() const;
+		SnapshotEncoder::Stats GetEncoderStats() const;
+
 	private:
+		Serialization();
+
+		// Keeps the form pool references and the manager's cast plans in step with the store.
+		class StoreObserver : public GemStore::Observer
+		{
+		public:
+			void OnInserted(const GemKey& key) override;
+			void OnErased(const GemKey& key) override;
+		};
+
 		static void OnSave(SKSE::SerializationInterface* serialization);
 		static void OnLoad(SKSE::SerializationInterface* serialization);
 		static void OnRevert(SKSE::SerializationInterface* serialization);
+		static SpellRecordCodec::Encoding GetConfiguredEncoding();
 
-		std::unordered_map<GemKey, StoredSpellData, GemKeyHash> storedSpells_;
-		std::uint16_t nextUniqueId_{ 1 };
+		GemStore store_;
+		StoreObserver storeObserver_;
+		SnapshotEncoder encoder_;
+		std::uint64_t submittedGeneration_{ ~0ull };
+		SpellRecordCodec::Encoding submittedEncoding_{};
+		// Written by the save callback, read by the menu on the render thread.
+		std::atomic<std::uint64_t> saveCount_{ 0 };
+		std::atomic<std::uint64_t> preEncodedCount_{ 0 };
+		std::atomic<std::int64_t> lastSaveUs_{ 0 };
+		std::atomic<std::int64_t> maxSaveUs_{ 0 };
 	};
 }
@@ -8,11 +8,16 @@
 
 #include "SpellGems/SpellGemManager.h"
 
+#include "SpellGems/CastPlan.h"
+#include "SpellGems/FreeCastSession.h"
+#include "SpellGems/Scheduler.h"
+#include "SpellGems/SpellProfileCache.h"
+#include "SpellGems/StoredFormCache.h"
+#include "SpellGems/StoredGemFormPool.h"
+
 #include <algorithm>
-#include <chrono>
 #include <cstring>
 #include <string>
-#include <thread>
 
 #include "RE/A/Actor.h"
 #include "RE/A/ActorValueOwner.h"
@@ -21,7 +26,6 @@
 #include "RE/E/ExtraUniqueID.h"
 #include "RE/E/Effect.h"
 #include "RE/E/EffectSetting.h"
-#include "RE/C/Calendar.h"
 #include "RE/I/InventoryMenu.h"
 #include "RE/I/ItemList.h"
 #include "RE/I/ItemRemoveReason.h"
@@ -31,7 +35,6 @@
 #include "RE/M/Misc.h"
 #include "RE/P/PlayerCharacter.h"
 #include "RE/S/ScriptEventSourceHolder.h"
-#include "RE/T/TESObjectMISC.h"
 #include "RE/T/TESForm.h"
 #include "RE/T/TESDataHandler.h"
 #include "RE/U/UI.h"
@@ -63,192 +66,275 @@ namespace SpellGems
 		logger::info("Registered stored gem use event handler.");
 	}
 
-	// Registers activation hotkeys for stored gem slots.
-	void SpellGemManager::RegisterActivationKeys()
+	// Executes commands posted by input and UI callbacks, then republishes the menu rows if they went stale. Runs
+	// once per frame on the main thread.
+	void SpellGemManager::ProcessCommands()
 	{
-		auto* keyHandler = KeyHandler::GetSingleton();
-		if (!keyHandler) {
-			logger::info("KeyHandler unavailable; activation keys not registered.");
-			return;
-		}
+		bool refreshRows = false;
+		GemCommandQueue::GetSingleton().Drain([&](const GemCommand& command) {
+			switch (command.type) {
+			case GemCommandType::Store:
+				TryStoreSelectedSpell();
+				break;
+			case GemCommandType::Activate:
+				ActivateStoredGemSlot(command.slot);
+				break;
+			case GemCommandType::Release:
+				StopFocusSpellCast(command.slot);
+				break;
+			case GemCommandType::Refresh:
+				RegisterActivationKeys();
+				break;
+			case GemCommandType::Remove:
+				Serialization::GetSingleton().RemoveStoredSpell(command.key);
+				break;
+			case GemCommandType::ReapplyUses:
+				ReapplyUses();
+				break;
+			case GemCommandType::RefreshRows:
+				refreshRows = true;
+				break;
+			}
+		});
+		RefreshStoredGemRows(refreshRows);
+	}
 
-		for (const auto handle : activationHandles_) {
-			keyHandler->Unregister(handle);
-		}
-		activationHandles_.clear();
-		for (const auto handle : activationReleaseHandles_) {
-			keyHandler->Unregister(handle);
+	// Rebuilds the menu rows when the store or the config moved on since the last build, or when forced.
+	void SpellGemManager::RefreshStoredGemRows(bool force)
+	{
+		auto& store = Serialization::GetSingleton().GetStore();
+		const auto config = Config::GetSingleton().GetSnapshot();
+		if (!force && store.GetGeneration() == rowsStoreGeneration_ && config->generation == rowsConfigGeneration_) {
+			return;
 		}
-		activationReleaseHandles_.clear();
 
-		const auto& config = Config::GetSingleton();
-		const auto maxStored = config.GetMaxStoredGems();
-		for (std::size_t i = 0; i < maxStored; ++i) {
-			const auto activationKey = config.GetActivationKey(i);
-			if (activationKey == 0) {
+		auto rows = std::make_shared<StoredGemRows>();
+		auto& forms = StoredFormCache::GetSingleton();
+		const auto& slotIndex = store.GetSlotIndex();
+		rows->storedCount = store.Size();
+		const auto slots = std::min<std::size_t>(slotIndex.Size(), config->values.maxStoredGems);
+		rows->rows.reserve(slots);
+		for (std::size_t i = 0; i < slots; ++i) {
+			const auto& key = *slotIndex.At(i);
+			const auto stored = store.Get(key);
+			if (!stored) {
 				continue;
 			}
 
-			auto handle = keyHandler->Register(activationKey, KeyEventType::KEY_DOWN, [i]() {
-				SpellGemManager::GetSingleton().ActivateStoredGemSlot(i);
-			});
-			activationHandles_.push_back(handle);
-			auto releaseHandle = keyHandler->Register(activationKey, KeyEventType::KEY_UP, [i]() {
-				SpellGemManager::GetSingleton().StopFocusSpellCast(i);
-			});
-			activationReleaseHandles_.push_back(releaseHandle);
-			logger::info("Activation key {} registered: {}", i + 1, activationKey);
+			const auto& data = *stored;
+			const auto* gemForm = forms.GetSoulGem(key.baseId);
+			const auto* profile = SpellProfileCache::GetSingleton().Find(data.spellId);
+			StoredGemRow row{ key, gemForm ? gemForm->GetName() : "Unknown Gem", {}, data.usesRemaining, 0.0f };
+			if (profile && profile->tier == data.tier) {
+				row.spellName = profile->displayName;
+			} else {
+				const auto* spellForm = forms.GetSpell(data.spellId);
+				row.spellName = spellForm ? spellForm->GetName() : "Unknown Spell";
+				row.spellName.append(" (").append(Config::GetTierName(data.tier)).append(")");
+			}
+			row.cooldownSeconds = config->rules.outcomes.Find(data.spellId, data.tier, profile ? profile->schoolMask : 0,
+				GetGemClass(data.isReusableStar, data.isBlackSoulGem)).cooldownSeconds;
+			rows->rows.push_back(std::move(row));
 		}
+
+		rowsStoreGeneration_ = store.GetGeneration();
+		rowsConfigGeneration_ = config->generation;
+		storedGemRows_.store(std::move(rows), std::memory_order_release);
 	}
 
-	// Activates a stored spell from the specified slot.
-	void SpellGemManager::ActivateStoredGemSlot(std::size_t index)
+	std::shared_ptr<const SpellGemManager::StoredGemRows> SpellGemManager::GetStoredGemRows() const
 	{
-		RefreshStoredGemSlots();
-		if (index >= storedGemSlots_.size()) {
-			logger::info("No stored spell gem in slot {}.", index + 1);
-			return;
-		}
+		return storedGemRows_.load(std::memory_order_acquire);
+	}
 
+	// Resets uses after a FiniteUse change: unlimited when it is off, a fresh count for unlimited gems when it is
+	// back on. Reusable stars stay unlimited either way.
+	void SpellGemManager::ReapplyUses()
+	{
 		auto& serialization = Serialization::GetSingleton();
-		const auto key = storedGemSlots_[index];
-		const auto* stored = serialization.GetStoredSpell(key);
-		if (!stored) {
-			logger::info("Stored spell entry missing for slot {}.", index + 1);
-			RefreshStoredGemSlots();
-			return;
+		const auto config = Config::GetSingleton().GetSnapshot();
+		const bool finiteUse = config->values.finiteUse;
+		const auto& storedSpells = serialization.GetStoredSpells();
+		std::vector<std::pair<GemKey, StoredSpellData>> entries{ storedSpells.begin(), storedSpells.end() };
+		for (auto& [key, data] : entries) {
+			if (data.isReusableStar || !finiteUse) {
+				data.usesRemaining = -1;
+			} else if (data.usesRemaining < 0) {
+				const auto* profile = SpellProfileCache::GetSingleton().Find(data.spellId);
+				data.usesRemaining = config->rules.outcomes.Find(data.spellId, data.tier, profile ? profile->schoolMask : 0,
+					GetGemClass(data.isReusableStar, data.isBlackSoulGem)).uses;
+			}
+			serialization.StoreSpell(key, data);
 		}
+	}
 
-		auto* spell = RE::TESForm::LookupByID<RE::SpellItem>(stored->spellId);
-		if (!spell) {
-			logger::info("Stored spell form {:08X} missing for slot {}.", stored->spellId, index + 1);
+	// Registers the store hotkey, replacing the previous binding when the key changed.
+	void SpellGemManager::RegisterStoreKey()
+	{
+		auto* keyHandler = KeyHandler::GetSingleton();
+		if (!keyHandler) {
+			logger::info("KeyHandler unavailable; store key not registered.");
 			return;
 		}
 
-		auto* calendar = RE::Calendar::GetSingleton();
-		const auto cooldownSeconds = stored->isReusableStar ?
-			Config::GetSingleton().GetStarCooldown() :
-			Config::GetSingleton().GetTierSettings(stored->tier).cooldown;
-		const float timescale = calendar ? calendar->GetTimescale() : 1.0f;
-		const float cooldownDays = (cooldownSeconds / (60.0f * 60.0f * 24.0f)) * timescale;
-		const float now = calendar ? calendar->GetCurrentGameTime() : 0.0f;
-		if (stored->lastUsedGameTime > 0.0f && now - stored->lastUsedGameTime < cooldownDays) {
-			const float remainingDays = cooldownDays - (now - stored->lastUsedGameTime);
-			const float remainingSeconds = remainingDays * (60.0f * 60.0f * 24.0f) / timescale;
-			logger::info("Stored spell gem on cooldown: {:.1f}s remaining.", remainingSeconds);
-			LogMessage("Stored spell gem is on cooldown.");
+		const auto storeKey = Config::GetSingleton().GetStoreKey();
+		if (storeBinding_.key == storeKey) {
 			return;
 		}
 
-		auto* player = RE::PlayerCharacter::GetSingleton();
-		if (!player) {
+		Unbind(*keyHandler, storeBinding_);
+		if (storeKey == 0) {
 			return;
 		}
+		storeBinding_.key = storeKey;
+		storeBinding_.press = keyHandler->Register(storeKey, KeyEventType::KEY_DOWN, []() {
+			GemCommandQueue::GetSingleton().Push(GemCommandType::Store);
+		});
+		logger::info("Store spell key registered: {}", storeKey);
+	}
 
-		const bool isConcentration = spell->GetCastingType() == RE::MagicSystem::CastingType::kConcentration;
-		std::uint64_t focusId = 0;
-		if (isConcentration) {
-			activeFocusSlot_ = index;
-			focusId = ++focusCastId_;
+	// Registers activation hotkeys for stored gem slots. Slots whose key did not change keep their binding.
+	void SpellGemManager::RegisterActivationKeys()
+	{
+		auto* keyHandler = KeyHandler::GetSingleton();
+		if (!keyHandler) {
+			logger::info("KeyHandler unavailable; activation keys not registered.");
+			return;
 		}
 
-		const bool isAzurasStar = IsAzurasStar(key.baseId);
-		CastStoredSpell(*spell, *player, stored->isBlackSoulGem, stored->isReusableStar, isAzurasStar);
-		if (isConcentration) {
-			const auto duration = Config::GetSingleton().GetFocusSpellDuration();
-			if (duration <= 0.0f) {
-				StopFocusSpellCast(index);
-			} else {
-				std::thread([focusId, duration, index]() {
-					std::this_thread::sleep_for(std::chrono::duration<float>(duration));
-					if (auto* task = SKSE::GetTaskInterface()) {
-						task->AddTask([focusId, index]() {
-							auto& manager = SpellGemManager::GetSingleton();
-							if (manager.focusCastId_.load() == focusId && manager.activeFocusSlot_ && *manager.activeFocusSlot_ == index) {
-								manager.StopFocusSpellCast(index);
-							}
-						});
-					}
-				}).detach();
+		const auto config = Config::GetSingleton().GetSnapshot();
+		const auto maxStored = config->values.maxStoredGems;
+		for (std::size_t i = 0; i < activationBindings_.size(); ++i) {
+			const auto activationKey = i < maxStored ? config->values.activationKeys[i] : 0;
+			auto& binding = activationBindings_[i];
+			if (binding.key == activationKey) {
+				continue;
 			}
-		}
-		StoredSpellData updated = *stored;
-		updated.lastUsedGameTime = now;
-		auto* baseGem = RE::TESForm::LookupByID<RE::TESSoulGem>(key.baseId);
-		if (baseGem) {
-			ConsumeStoredGemUse(*baseGem, key, updated);
-			RefreshStoredGemSlots();
+
+			Unbind(*keyHandler, binding);
+			if (activationKey == 0) {
+				continue;
+			}
+
+			binding.key = activationKey;
+			binding.press = keyHandler->Register(activationKey, KeyEventType::KEY_DOWN, [i]() {
+				GemCommandQueue::GetSingleton().Push(GemCommandType::Activate, i);
+			});
+			binding.release = keyHandler->Register(activationKey, KeyEventType::KEY_UP, [i]() {
+				GemCommandQueue::GetSingleton().Push(GemCommandType::Release, i);
+			});
+			logger::info("Activation key {} registered: {}", i + 1, activationKey);
 		}
 	}
 
-	bool SpellGemManager::ResolveStoredGemSpell(RE::TESForm* form, GemKey& key, StoredSpellData& data, RE::SpellItem*& spell) const
+	void SpellGemManager::Unbind(KeyHandler& keyHandler, KeyBinding& binding)
 	{
-		if (!form || form->GetFormType() != RE::FormType::SoulGem) {
-			return false;
+		for (const auto handle : { binding.press, binding.release }) {
+			if (handle != INVALID_REGISTRATION_HANDLE) {
+				keyHandler.Unregister(handle);
+			}
 		}
+		binding = {};
+	}
 
-		auto& serialization = Serialization::GetSingleton();
-		if (!serialization.TryGetStoredSpellByBaseId(form->GetFormID(), key, data)) {
-			return false;
+	// Config change listener; runs on the main thread after a reload or a settings edit.
+	void SpellGemManager::OnConfigChanged(const ConfigSnapshot& previous, const ConfigSnapshot& current)
+	{
+		if (previous.values.storeKey != current.values.storeKey) {
+			RegisterStoreKey();
+		}
+		if (previous.values.activationKeys != current.values.activationKeys ||
+			previous.values.maxStoredGems != current.values.maxStoredGems) {
+			RegisterActivationKeys();
 		}
-
-		spell = RE::TESForm::LookupByID<RE::SpellItem>(data.spellId);
-		return spell != nullptr;
 	}
 
-	void SpellGemManager::ConsumeStoredGemUse(RE::TESSoulGem& baseGem, const GemKey& key, const StoredSpellData& data)
+	// Activates a stored spell from the specified slot.
+	void SpellGemManager::ActivateStoredGemSlot(std::size_t index)
 	{
-		if (data.usesRemaining < 0) {
-			Serialization::GetSingleton().StoreSpell(key, data);
+		lastCastConcentration_ = false;
+		const auto config = Config::GetSingleton().GetSnapshot();
+		const auto result = index < config->values.maxStoredGems ?
+			core_.Activate(index, config->rules) :
+			ActivateResult{};
+		switch (result.status) {
+		case ActivateStatus::NoGem:
+			logger::info("No stored spell gem in slot {}.", index + 1);
 			return;
-		}
-
-		auto* player = RE::PlayerCharacter::GetSingleton();
-		if (!player) {
+		case ActivateStatus::MissingEntry:
+			logger::info("Stored spell entry missing for slot {}.", index + 1);
 			return;
-		}
-
-		auto* spell = RE::TESForm::LookupByID<RE::SpellItem>(data.spellId);
-		if (!spell) {
+		case ActivateStatus::MissingSpell:
+			logger::info("Stored spell form missing for slot {}.", index + 1);
+			return;
+		case ActivateStatus::OnCooldown:
+			logger::info("Stored spell gem on cooldown: {:.1f}s remaining.", result.cooldownRemaining);
+			LogMessage("Stored spell gem is on cooldown.");
 			return;
+		case ActivateStatus::CastFailed:
+			return;
+		case ActivateStatus::Cast:
+			break;
 		}
 
-		auto& serialization = Serialization::GetSingleton();
-		const auto newUses = data.usesRemaining - 1;
-		if (newUses <= 0) {
-			serialization.RemoveStoredSpell(key);
-			player->RemoveItem(&baseGem, 1, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
-			GrantFragmentsToPlayer(GetGemTier(baseGem));
-			logger::info("Stored spell gem depleted and removed.");
-			return;
+		if (lastCastConcentration_) {
+			activeFocusSlot_ = index;
+			const auto duration = config->values.focusSpellDuration;
+			auto& scheduler = Scheduler::GetSingleton();
+			scheduler.Cancel(focusExpiryTimer_);
+			auto stopFocus = [index]() {
+				SpellGemManager::GetSingleton().StopFocusSpellCast(index);
+			};
+			focusExpiryTimer_ = duration <= 0.0f ?
+				scheduler.ScheduleNextFrame(std::move(stopFocus)) :
+				scheduler.Schedule(duration, std::move(stopFocus));
+		}
+		OnStoredGemConsumed(result.key, result.consumed, result.usesRemaining);
+	}
+
+	// Casts a stored gem on behalf of the core.
+	bool SpellGemManager::StoredSpellCaster::Cast(const GemKey& key, const StoredSpellData& data)
+	{
+		auto* spell = StoredFormCache::GetSingleton().GetSpell(data.spellId);
+		auto* player = RE::PlayerCharacter::GetSingleton();
+		if (!spell || !player) {
+			return false;
 		}
 
-		StoredSpellData newData = data;
-		newData.usesRemaining = newUses;
-		serialization.StoreSpell(key, newData);
-		logger::info("Stored spell gem uses remaining: {}", newUses);
+		const auto& plan = manager_.GetCastPlan(key, data, *spell);
+		manager_.lastCastConcentration_ = plan.isConcentration;
+		manager_.CastStoredSpell(*spell, *player, plan);
+		return true;
 	}
 
-	void SpellGemManager::RefreshStoredGemSlots()
+	// Reports the remaining uses; a depleted gem's cast plan goes with its store entry.
+	void SpellGemManager::OnStoredGemConsumed(const GemKey&, ConsumeStatus status, std::int32_t usesRemaining)
 	{
-		const auto& storedSpells = Serialization::GetSingleton().GetStoredSpells();
-		storedGemSlots_.clear();
-		storedGemSlots_.reserve(storedSpells.size());
-		for (const auto& [key, _] : storedSpells) {
-			storedGemSlots_.push_back(key);
+		switch (status) {
+		case ConsumeStatus::Depleted:
+			logger::info("Stored spell gem depleted and consumed.");
+			break;
+		case ConsumeStatus::Remaining:
+			logger::info("Stored spell gem uses remaining: {}", usesRemaining);
+			break;
+		case ConsumeStatus::Unlimited:
+			break;
 		}
+	}
 
-		std::sort(storedGemSlots_.begin(), storedGemSlots_.end(), [](const GemKey& a, const GemKey& b) {
-			if (a.baseId != b.baseId) {
-				return a.baseId < b.baseId;
-			}
-			return a.uniqueId < b.uniqueId;
-		});
+	bool SpellGemManager::ResolveStoredGemSpell(RE::TESForm* form, GemKey& key, StoredSpellData& data, RE::SpellItem*& spell) const
+	{
+		if (!form || form->GetFormType() != RE::FormType::SoulGem) {
+			return false;
+		}
 
-		const auto maxStored = Config::GetSingleton().GetMaxStoredGems();
-		if (storedGemSlots_.size() > maxStored) {
-			storedGemSlots_.resize(maxStored);
+		auto& serialization = Serialization::GetSingleton();
+		if (!serialization.TryGetStoredSpellByBaseId(form->GetFormID(), key, data)) {
+			return false;
 		}
+
+		spell = StoredFormCache::GetSingleton().GetSpell(data.spellId);
+		return spell != nullptr;
 	}
 
 	// Attempts to store the selected spell into the selected soul gem.
@@ -277,8 +363,9 @@ namespace SpellGems
 		const bool isReusableStar = isStarBase || (hasExisting && existingData.isReusableStar);
 		const bool isBlackSoulGem = isBlackGemBase || (hasExisting && existingData.isBlackSoulGem);
 		const auto soulLevel = selected.entry ? selected.entry->GetSoulLevel() : RE::SOUL_LEVEL::kNone;
-		const bool requireFilled = Config::GetSingleton().RequireFilledSoulGem();
-		const bool allowAnyGemTier = requireFilled && Config::GetSingleton().AllowAnyGemTier();
+		const auto config = Config::GetSingleton().GetSnapshot();
+		const bool requireFilled = config->values.requireFilledSoulGem;
+		const bool allowAnyGemTier = requireFilled && config->values.allowAnyGemTier;
 		const bool requireSoul = !isReusableStar && (requireFilled || allowAnyGemTier);
 		if (requireSoul && soulLevel == RE::SOUL_LEVEL::kNone) {
 			LogMessage("Soul gem must be filled to store a spell.");
@@ -336,7 +423,7 @@ namespace SpellGems
 				return;
 			}
 		}
-		const auto gemTier = GetGemTier(*soulGem);
+		const auto gemTier = GameFormLookup::GetGemTier(*soulGem);
 		logger::info("Spell tier {} vs gem tier {}.", static_cast<int>(spellTier), static_cast<int>(gemTier));
 		if (!isReusableStar && !allowAnyGemTier && gemTier != spellTier) {
 			LogMessage("Soul gem tier must match the spell tier.");
@@ -344,12 +431,13 @@ namespace SpellGems
 		}
 
 		auto& serialization = Serialization::GetSingleton();
-		const auto& config = Config::GetSingleton();
-		const auto& tierSettings = config.GetTierSettings(spellTier);
+		const auto schoolMask = SpellProfileCache::GetSingleton().Get(*spell).schoolMask;
+		const auto& outcome = config->rules.outcomes.Find(spell->GetFormID(), spellTier, schoolMask,
+			GetGemClass(isReusableStar, isBlackSoulGem));
 		StoredSpellData data{};
 		data.spellId = spell->GetFormID();
 		data.tier = spellTier;
-		data.usesRemaining = isReusableStar ? -1 : (config.IsFiniteUse() ? tierSettings.uses : -1);
+		data.usesRemaining = outcome.uses;
 		data.lastUsedGameTime = 0.0f;
 		data.isReusableStar = isReusableStar;
 		data.isBlackSoulGem = isBlackSoulGem;
@@ -358,45 +446,53 @@ namespace SpellGems
 		if (isReusableStar && hasExisting && existingData.isReusableStar) {
 			storedGemForm = soulGem;
 		} else {
-			storedGemForm = GetOrCreateStoredGemForm(*soulGem, *spell, spellTier, data.usesRemaining);
+			storedGemForm = GetOrCreateStoredGemForm(*soulGem, *spell, spellTier);
 			if (!storedGemForm) {
 				LogMessage("Failed to create stored spell gem form.");
 				return;
 			}
 		}
 
+		auto* player = RE::PlayerCharacter::GetSingleton();
+		if (!player) {
+			LogMessage("Player reference unavailable.");
+			return;
+		}
+
+		const bool overwriteStar = isReusableStar && hasExisting && existingData.isReusableStar;
 		auto* newExtraList = selected.extraList;
 		GemKey key{};
-		if (isReusableStar && hasExisting && existingData.isReusableStar) {
+		if (overwriteStar) {
 			key = existingKey;
 		} else {
 			const auto uniqueId = newExtraList ?
 				GetOrCreateUniqueId(*storedGemForm, *newExtraList) :
 				serialization.AllocateUniqueId();
-			key = { storedGemForm->GetFormID(), uniqueId };
-			if (serialization.HasStoredSpell(key)) {
-				LogMessage("Soul gem already contains a spell.");
+			if (uniqueId == 0) {
+				LogMessage("Too many stored spell gems.");
 				return;
 			}
+			key = { storedGemForm->GetFormID(), uniqueId };
 		}
 
-		auto* player = RE::PlayerCharacter::GetSingleton();
-		if (!player) {
-			LogMessage("Player reference unavailable.");
+		if (!core_.Store(key, data, overwriteStar)) {
+			LogMessage("Soul gem already contains a spell.");
 			return;
 		}
 
-		logger::info("Removing selected soul gem from inventory.");
-		if (!(isReusableStar && hasExisting && existingData.isReusableStar)) {
+		logger::info("Stored spell {:08X} in gem {:08X} (unique {}).", data.spellId, key.baseId, key.uniqueId);
+		// The swap carries the selected stack's extra list, which the game may free or merge before the next frame,
+		// so it is applied now rather than through the InventoryQueue.
+		if (!overwriteStar) {
+			logger::info("Removing selected soul gem from inventory.");
 			player->RemoveItem(soulGem, 1, RE::ITEM_REMOVE_REASON::kRemove, selected.extraList, nullptr);
 			logger::info("Adding stored spell gem to inventory.");
 			player->AddObjectToContainer(storedGemForm, newExtraList, 1, player);
 			logger::info("Inventory swap complete.");
 		}
 
-		serialization.StoreSpell(key, data);
+		castPlans_.insert_or_assign(key, CastPlan::Build(*spell, data));
 		logger::info("Stored spell gem form {:08X} added to player.", storedGemForm->GetFormID());
-		RefreshStoredGemSlots();
 
 		LogMessage("Stored spell in soul gem.");
 	}
@@ -448,60 +544,21 @@ namespace SpellGems
 
 	SpellTier SpellGemManager::GetSpellTier(const RE::SpellItem& spell) const
 	{
-		const auto* effect = spell.GetCostliestEffectItem();
-		const auto* baseEffect = effect ? effect->baseEffect : nullptr;
-		const auto minSkill = baseEffect ? baseEffect->GetMinimumSkillLevel() : 0;
-
-		if (minSkill >= 100) {
-			return SpellTier::Master;
-		}
-		if (minSkill >= 75) {
-			return SpellTier::Expert;
-		}
-		if (minSkill >= 50) {
-			return SpellTier::Adept;
-		}
-		if (minSkill >= 25) {
-			return SpellTier::Apprentice;
-		}
-		return SpellTier::Novice;
+		return SpellProfileCache::GetSingleton().Get(spell).tier;
 	}
 
 	bool SpellGemManager::TryGetSpellTier(const RE::SpellItem& spell, SpellTier& tier) const
 	{
-		const auto* effect = spell.GetCostliestEffectItem();
-		const auto* baseEffect = effect ? effect->baseEffect : nullptr;
-		if (!baseEffect) {
+		const auto& profile = SpellProfileCache::GetSingleton().Get(spell);
+		if (!profile.hasTier) {
 			logger::info("Spell {:08X} has no base effect; cannot determine tier.", spell.GetFormID());
 			return false;
 		}
 
-		tier = GetSpellTier(spell);
+		tier = profile.tier;
 		return true;
 	}
 
-	SpellTier SpellGemManager::GetGemTier(const RE::TESSoulGem& gem) const
-	{
-		if (gem.CanHoldNPCSoul()) {
-			return SpellTier::Master;
-		}
-
-		switch (gem.GetMaximumCapacity()) {
-		case RE::SOUL_LEVEL::kGrand:
-			return SpellTier::Master;
-		case RE::SOUL_LEVEL::kGreater:
-			return SpellTier::Expert;
-		case RE::SOUL_LEVEL::kCommon:
-			return SpellTier::Adept;
-		case RE::SOUL_LEVEL::kLesser:
-			return SpellTier::Apprentice;
-		case RE::SOUL_LEVEL::kPetty:
-			return SpellTier::Novice;
-		default:
-			return SpellTier::Novice;
-		}
-	}
-
 	std::uint16_t SpellGemManager::GetOrCreateUniqueId(const RE::TESSoulGem& gem, RE::ExtraDataList& extraList) const
 	{
 		auto* uniqueData = extraList.GetByType<RE::ExtraUniqueID>();
@@ -511,6 +568,9 @@ namespace SpellGems
 		}
 
 		auto uniqueId = Serialization::GetSingleton().AllocateUniqueId();
+		if (uniqueId == 0) {
+			return 0;
+		}
 		auto* newUnique = new RE::ExtraUniqueID(gem.GetFormID(), uniqueId);
 		extraList.Add(newUnique);
 		return uniqueId;
@@ -537,221 +597,152 @@ namespace SpellGems
 		return list;
 	}
 
-	RE::TESSoulGem* SpellGemManager::GetOrCreateStoredGemForm(RE::TESSoulGem& baseGem, const RE::SpellItem& spell, SpellTier tier, std::int32_t usesRemaining)
+	RE::TESSoulGem* SpellGemManager::GetOrCreateStoredGemForm(RE::TESSoulGem& baseGem, const RE::SpellItem& spell, SpellTier tier)
 	{
-		StoredGemFormKey key{ baseGem.GetFormID(), spell.GetFormID(), tier, usesRemaining };
-		if (auto it = storedGemForms_.find(key); it != storedGemForms_.end()) {
-			return it->second;
-		}
+		const auto& profile = SpellProfileCache::GetSingleton().Get(spell);
+		return StoredGemFormPool::GetSingleton().Acquire(baseGem, spell.GetFormID(), tier, profile.displayName);
+	}
 
-		auto* duplicated = baseGem.CreateDuplicateForm(false, nullptr);
-		auto* storedGem = duplicated ? duplicated->As<RE::TESSoulGem>() : nullptr;
-		if (!storedGem) {
-			logger::info("Failed to duplicate soul gem form {:08X}.", baseGem.GetFormID());
-			return nullptr;
+	RE::BSEventNotifyControl SpellGemManager::StoredGemUseEventSink::ProcessEvent(
+		const RE::TESContainerChangedEvent* event,
+		RE::BSTEventSource<RE::TESContainerChangedEvent>*)
+	{
+		seen_.fetch_add(1, std::memory_order_relaxed);
+		// Stored gem uses are removals to nowhere of a form in the stored-spell table; reject everything else
+		// before touching the player singleton.
+		if (!event || event->itemCount >= 0 || event->newContainer != 0 ||
+			!Serialization::GetSingleton().GetBaseFilter().MayContain(event->baseObj)) {
+			prefiltered_.fetch_add(1, std::memory_order_relaxed);
+			return RE::BSEventNotifyControl::kContinue;
 		}
 
-		const auto displayName = BuildDisplayName(spell, tier);
-		storedGem->SetFullName(displayName.c_str());
-
-		auto* dataHandler = RE::TESDataHandler::GetSingleton();
-		if (dataHandler && !dataHandler->AddFormToDataHandler(storedGem)) {
-			logger::info("Failed to register stored gem form with data handler.");
+		if (manager_.HandleContainerChanged(*event)) {
+			handled_.fetch_add(1, std::memory_order_relaxed);
 		}
-
-		storedGemForms_.emplace(key, storedGem);
-		logger::info("Created stored spell gem form {:08X} for spell {:08X}.", storedGem->GetFormID(), spell.GetFormID());
-		return storedGem;
+		return RE::BSEventNotifyControl::kContinue;
 	}
 
-	std::string SpellGemManager::BuildDisplayName(const RE::SpellItem& spell, SpellTier tier) const
+	SpellGemManager::UseEventStats SpellGemManager::StoredGemUseEventSink::GetStats() const
 	{
-		const auto* spellName = spell.GetName();
-		const std::string name = (spellName && spellName[0] != '\0') ? spellName : "Unknown Spell";
-		const auto tierName = Config::GetTierName(tier);
-		return name + " (" + std::string(tierName) + ")";
+		return {
+			seen_.load(std::memory_order_relaxed),
+			prefiltered_.load(std::memory_order_relaxed),
+			handled_.load(std::memory_order_relaxed)
+		};
 	}
 
-	RE::BSEventNotifyControl SpellGemManager::StoredGemUseEventSink::ProcessEvent(
-		const RE::TESContainerChangedEvent* event,
-		RE::BSTEventSource<RE::TESContainerChangedEvent>*)
+	SpellGemManager::UseEventStats SpellGemManager::GetUseEventStats() const
 	{
-		if (!event) {
-			return RE::BSEventNotifyControl::kContinue;
-		}
-
-		return manager_.HandleContainerChanged(*event);
+		return useEventSink_.GetStats();
 	}
 
-	// Handles stored gem consumption events from the player's inventory.
-	RE::BSEventNotifyControl SpellGemManager::HandleContainerChanged(const RE::TESContainerChangedEvent& event)
+	// Handles stored gem consumption events from the player's inventory. Returns whether a stored gem use was consumed.
+	bool SpellGemManager::HandleContainerChanged(const RE::TESContainerChangedEvent& event)
 	{
 		auto* player = RE::PlayerCharacter::GetSingleton();
 		if (!player) {
-			return RE::BSEventNotifyControl::kContinue;
+			return false;
 		}
 
 		if (event.oldContainer != player->GetFormID() || event.newContainer != 0 || event.itemCount >= 0) {
-			return RE::BSEventNotifyControl::kContinue;
+			return false;
 		}
 
 		if (event.reference) {
-			return RE::BSEventNotifyControl::kContinue;
+			return false;
 		}
 
 		const GemKey key{ event.baseObj, event.uniqueID };
 		auto& serialization = Serialization::GetSingleton();
-		const auto* stored = serialization.GetStoredSpell(key);
+		auto stored = serialization.GetStoredSpell(key);
 		if (!stored) {
-			return RE::BSEventNotifyControl::kContinue;
+			return false;
 		}
 
-		auto* spell = RE::TESForm::LookupByID<RE::SpellItem>(stored->spellId);
+		auto* spell = StoredFormCache::GetSingleton().GetSpell(stored->spellId);
 		if (!spell) {
 			logger::info("Stored spell form {:08X} not found for used gem.", stored->spellId);
 			serialization.RemoveStoredSpell(key);
-			return RE::BSEventNotifyControl::kContinue;
+			return false;
 		}
 
-	SpellTier effectiveTier = stored->tier;
-	if (TryGetSpellTier(*spell, effectiveTier) && effectiveTier != stored->tier) {
-		StoredSpellData updated = *stored;
-		updated.tier = effectiveTier;
-		serialization.StoreSpell(key, updated);
-	}
+		SpellTier effectiveTier = stored->tier;
+		if (TryGetSpellTier(*spell, effectiveTier) && effectiveTier != stored->tier) {
+			stored->tier = effectiveTier;
+			serialization.StoreSpell(key, *stored);
+		}
 
 		logger::info("Stored spell gem used: {:08X} (unique {}).", key.baseId, key.uniqueId);
-		const bool isAzurasStar = IsAzurasStar(event.baseObj);
-		CastStoredSpell(*spell, *player, stored->isBlackSoulGem, stored->isReusableStar, isAzurasStar);
+		CastStoredSpell(*spell, *player, GetCastPlan(key, *stored, *spell));
 
-		std::int32_t newUses = stored->usesRemaining;
-		if (newUses > 0) {
-			newUses -= 1;
-		}
-
-		if (newUses == 0) {
-			serialization.RemoveStoredSpell(key);
-			auto* baseGem = RE::TESForm::LookupByID<RE::TESSoulGem>(event.baseObj);
-			player->RemoveItem(baseGem, 1, RE::ITEM_REMOVE_REASON::kRemove, nullptr, nullptr);
-			if (baseGem) {
-				GrantFragmentsToPlayer(GetGemTier(*baseGem));
-			}
-			logger::info("Stored spell gem depleted and consumed.");
-			return RE::BSEventNotifyControl::kContinue;
-		}
+		const auto consumed = core_.Consume(key, *stored, Config::GetSingleton().GetSnapshot()->rules);
+		OnStoredGemConsumed(key, consumed, stored->usesRemaining - 1);
+		return true;
+	}
 
-		StoredSpellData newData = *stored;
-		newData.usesRemaining = newUses;
-		serialization.StoreSpell(key, newData);
-		logger::info("Stored spell gem uses remaining: {}", newUses);
+	// Drops every cast plan; the store is about to be replaced by a load or cleared by a revert.
+	void SpellGemManager::ClearCastPlans()
+	{
+		castPlans_.clear();
+	}
 
-		return RE::BSEventNotifyControl::kContinue;
+	// Drops the cast plan of a gem that left the store.
+	void SpellGemManager::ForgetCastPlan(const GemKey& key)
+	{
+		castPlans_.erase(key);
 	}
 
-	// Casts the stored spell with any gem-specific modifiers.
-	void SpellGemManager::CastStoredSpell(RE::SpellItem& spell, RE::PlayerCharacter& player, bool isBlackSoulGem, bool isReusableStar, bool isAzurasStar)
+	// Returns the cast plan for a stored gem, rebuilding it after a load or a config change.
+	const CastPlan& SpellGemManager::GetCastPlan(const GemKey& key, const StoredSpellData& data, const RE::SpellItem& spell)
 	{
-		auto* caster = player.GetMagicCaster(RE::MagicSystem::CastingSource::kRightHand);
-		if (!caster) {
-			caster = player.GetMagicCaster(RE::MagicSystem::CastingSource::kLeftHand);
+		auto& plan = castPlans_[key];
+		if (!plan.IsCurrent(data)) {
+			plan = CastPlan::Build(spell, data);
 		}
-		if (!caster) {
-			caster = player.GetMagicCaster(RE::MagicSystem::CastingSource::kInstant);
+		return plan;
+	}
+
+	// Casts the stored spell using its precomputed plan.
+	void SpellGemManager::CastStoredSpell(RE::SpellItem& spell, RE::PlayerCharacter& player, const CastPlan& plan)
+	{
+		RE::MagicCaster* caster = nullptr;
+		for (const auto source : { RE::MagicSystem::CastingSource::kRightHand, RE::MagicSystem::CastingSource::kLeftHand, RE::MagicSystem::CastingSource::kInstant }) {
+			caster = player.GetMagicCaster(source);
+			if (caster) {
+				break;
+			}
 		}
 		if (!caster) {
 			logger::info("Magic caster unavailable for stored spell cast.");
 			return;
 		}
 
-		RE::TESObjectREFR* target = nullptr;
-		if (spell.GetDelivery() == RE::MagicSystem::Delivery::kSelf) {
-			target = &player;
-		}
-
-		float effectiveness = 1.0f;
-		float magnitudeOverride = 0.0f;
-		if (isAzurasStar && Config::GetSingleton().AzurasStarBoost()) {
-			effectiveness = 1.05f;
-			magnitudeOverride = 1.05f;
-		} else if (!isBlackSoulGem && !isReusableStar && Config::GetSingleton().NormalGemPenalty()) {
-			effectiveness = 0.9f;
-			magnitudeOverride = 0.9f;
-		} else if (isBlackSoulGem && Config::GetSingleton().BlackSoulGemBoosts()) {
-			bool hasDestruction = false;
-			bool hasDurationBoost = false;
-			for (const auto* effect : spell.effects) {
-				if (!effect || !effect->baseEffect) {
-					continue;
-				}
-				switch (effect->baseEffect->GetMagickSkill()) {
-				case RE::ActorValue::kDestruction:
-					hasDestruction = true;
-					break;
-				case RE::ActorValue::kConjuration:
-				case RE::ActorValue::kAlteration:
-					hasDurationBoost = true;
-					break;
-				default:
-					break;
-				}
-			}
-			if (hasDestruction) {
-				magnitudeOverride = 1.1f;
-			}
-			if (hasDurationBoost) {
-				effectiveness = 1.1f;
-			}
+		if (plan.healthCostFraction > 0.0f) {
 			if (auto* avOwner = player.AsActorValueOwner()) {
 				const auto maxHealth = avOwner->GetPermanentActorValue(RE::ActorValue::kHealth) +
 					player.GetActorValueModifier(RE::ACTOR_VALUE_MODIFIER::kPermanent, RE::ActorValue::kHealth) +
 					player.GetActorValueModifier(RE::ACTOR_VALUE_MODIFIER::kTemporary, RE::ActorValue::kHealth);
-				avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kHealth, -(maxHealth * 0.05f));
+				avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kHealth, -(maxHealth * plan.healthCostFraction));
 			}
 		}
 
-		if (spell.GetCastingType() == RE::MagicSystem::CastingType::kConcentration) {
-			player.NotifyAnimationGraph(RE::BSFixedString("MT_BreathExhaleShort"));
+		player.NotifyAnimationGraph(*plan.animationEvent);
+		const auto previousCost = caster->currentSpellCost;
+		if (plan.isConcentration) {
+			auto& sessions = FreeCastSessions::GetSingleton();
+			const auto source = caster->GetCastingSource();
+			if (focusCasterSource_ && *focusCasterSource_ != source) {
+				sessions.End(player, *focusCasterSource_);
+			}
+			sessions.Begin(player, *caster);
+			focusCasterSource_ = source;
 		} else {
-			player.NotifyAnimationGraph(RE::BSFixedString("ShoutStart"));
+			caster->currentSpellCost = 0.0f;
 		}
-		const auto previousCost = caster->currentSpellCost;
-		caster->currentSpellCost = 0.0f;
 		caster->PrepareSound(RE::MagicSystem::SoundID::kRelease, &spell);
-		caster->CastSpellImmediate(&spell, false, target, effectiveness, false, magnitudeOverride, &player);
+		caster->CastSpellImmediate(&spell, false, plan.targetSelf ? &player : nullptr, plan.effectiveness, false, plan.magnitudeOverride, &player);
 		caster->PlayReleaseSound(&spell);
-		if (spell.GetCastingType() == RE::MagicSystem::CastingType::kConcentration) {
-			focusCasterSource_ = caster->GetCastingSource();
-			focusPreviousCost_ = previousCost;
-			focusCostActive_ = true;
-			if (auto* avOwner = player.AsActorValueOwner()) {
-				focusStartMagicka_ = avOwner->GetActorValue(RE::ActorValue::kMagicka);
-				const auto focusId = focusCastId_.load();
-				std::thread([focusId]() {
-					while (true) {
-						std::this_thread::sleep_for(std::chrono::milliseconds(100));
-						if (auto* task = SKSE::GetTaskInterface()) {
-							task->AddTask([focusId]() {
-								auto& manager = SpellGemManager::GetSingleton();
-								if (!manager.focusCostActive_ || manager.focusCastId_.load() != focusId) {
-									return;
-								}
-								if (auto* pc = RE::PlayerCharacter::GetSingleton()) {
-										if (auto* avOwner = pc->AsActorValueOwner()) {
-											const auto current = avOwner->GetActorValue(RE::ActorValue::kMagicka);
-											if (current < manager.focusStartMagicka_) {
-												avOwner->ModActorValue(RE::ActorValue::kMagicka, manager.focusStartMagicka_ - current);
-											}
-										}
-									}
-								});
-						}
-						if (!SpellGemManager::GetSingleton().focusCostActive_ || SpellGemManager::GetSingleton().focusCastId_.load() != focusId) {
-							break;
-						}
-					}
-				}).detach();
-			}
-		} else {
+		if (!plan.isConcentration) {
 			caster->currentSpellCost = previousCost;
 		}
 		logger::info("Cast stored spell {:08X} via gem activation.", spell.GetFormID());
@@ -765,7 +756,7 @@ namespace SpellGems
 		}
 
 		activeFocusSlot_.reset();
-		++focusCastId_;
+		Scheduler::GetSingleton().Cancel(focusExpiryTimer_);
 		if (auto* pc = RE::PlayerCharacter::GetSingleton()) {
 			if (auto* caster = pc->GetMagicCaster(RE::MagicSystem::CastingSource::kRightHand)) {
 				caster->InterruptCast(true);
@@ -774,16 +765,12 @@ namespace SpellGems
 				caster->InterruptCast(true);
 			}
 		}
-		if (focusCostActive_ && focusCasterSource_) {
+		if (focusCasterSource_) {
 			if (auto* pc = RE::PlayerCharacter::GetSingleton()) {
-				if (auto* caster = pc->GetMagicCaster(*focusCasterSource_)) {
-					caster->currentSpellCost = focusPreviousCost_;
-				}
+				FreeCastSessions::GetSingleton().End(*pc, *focusCasterSource_);
 			}
 		}
-		focusCostActive_ = false;
 		focusCasterSource_.reset();
-		focusStartMagicka_ = 0.0f;
 	}
 
 	bool SpellGemManager::IsReusableStar(RE::FormID formId) const
@@ -791,32 +778,9 @@ namespace SpellGems
 		return formId == 0x00063B27 || formId == 0x00063B29;
 	}
 
-	bool SpellGemManager::IsAzurasStar(RE::FormID formId) const
-	{
-		return formId == 0x00063B27;
-	}
-
 	bool SpellGemManager::IsBlackSoulGem(const RE::TESSoulGem& gem) const
 	{
 		const auto formId = gem.GetFormID();
 		return formId == 0x00063B29 || gem.CanHoldNPCSoul();
 	}
-	void SpellGemManager::GrantFragmentsToPlayer(SpellTier tier) const
-	{
-		const auto count = Config::GetSingleton().GetFragmentCount(tier);
-		if (count == 0) {
-			return;
-		}
-
-		auto* fragmentForm = RE::TESForm::LookupByID<RE::TESObjectMISC>(Config::GetSingleton().GetFragmentFormId());
-		if (!fragmentForm) {
-			logger::info("Fragment form {:08X} not found; skipping fragments.", Config::GetSingleton().GetFragmentFormId());
-			return;
-		}
-
-		if (auto* player = RE::PlayerCharacter::GetSingleton()) {
-			player->AddObjectToContainer(fragmentForm, nullptr, static_cast<std::int32_t>(count), player);
-			logger::info("Granted {} soul gem fragments.", count);
-		}
-	}
 }
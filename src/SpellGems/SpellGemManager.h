@@ -1,9 +1,16 @@
 #pragma once
 
+#include "SpellGems/CastPlan.h"
 #include "SpellGems/Config.h"
+#include "SpellGems/Core/GemCommandQueue.h"
+#include "SpellGems/Core/GemCore.h"
+#include "SpellGems/Core/TimerWheel.h"
+#include "SpellGems/GameBindings.h"
 #include "SpellGems/Serialization.h"
 
+#include <array>
 #include <atomic>
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -25,18 +32,59 @@ namespace SpellGems
 	class SpellGemManager
 	{
 	public:
+		struct UseEventStats
+		{
+			std::uint64_t seen;
+			// Rejected before the store lookup.
+			std::uint64_t prefiltered;
+			// Consumed a stored gem use.
+			std::uint64_t handled;
+		};
+
+		// One stored gem as the menu lists it, names already resolved.
+		struct StoredGemRow
+		{
+			GemKey key;
+			std::string gemName;
+			std::string spellName;
+			std::int32_t usesRemaining;
+			float cooldownSeconds;
+		};
+
+		// Built on the main thread and never modified once published, so the render thread can list stored gems
+		// without touching the store or the form caches.
+		struct StoredGemRows
+		{
+			// Every stored gem; rows only holds those in activation slots.
+			std::size_t storedCount{};
+			std::vector<StoredGemRow> rows;
+		};
+
 		static SpellGemManager& GetSingleton();
 
+		void ProcessCommands();
 		void TryStoreSelectedSpell();
 		void RegisterUseEventSink();
+		void RegisterStoreKey();
 		void RegisterActivationKeys();
+		void OnConfigChanged(const ConfigSnapshot& previous, const ConfigSnapshot& current);
 		void ActivateStoredGemSlot(std::size_t index);
+		void ClearCastPlans();
+		void ForgetCastPlan(const GemKey& key);
 		bool ResolveStoredGemSpell(RE::TESForm* form, GemKey& key, StoredSpellData& data, RE::SpellItem*& spell) const;
-		void ConsumeStoredGemUse(RE::TESSoulGem& baseGem, const GemKey& key, const StoredSpellData& data);
+		UseEventStats GetUseEventStats() const;
+		std::shared_ptr<const StoredGemRows> GetStoredGemRows() const;
 
 	private:
 		SpellGemManager() = default;
 
+		struct KeyBinding
+		{
+			std::uint32_t key{};
+			KeyHandlerEvent press{ INVALID_REGISTRATION_HANDLE };
+			KeyHandlerEvent release{ INVALID_REGISTRATION_HANDLE };
+		};
+
 		struct SelectedGem
 		{
 			RE::InventoryEntryData* entry;
@@ -49,66 +97,62 @@ namespace SpellGems
 			explicit StoredGemUseEventSink(SpellGemManager& manager) : manager_(manager) {}
 			RE::BSEventNotifyControl ProcessEvent(const RE::TESContainerChangedEvent* event,
 				RE::BSTEventSource<RE::TESContainerChangedEvent>*) override;
+			UseEventStats GetStats() const;
 
 		private:
 			SpellGemManager& manager_;
+			std::atomic<std::uint64_t> seen_{ 0 };
+			std::atomic<std::uint64_t> prefiltered_{ 0 };
+			std::atomic<std::uint64_t> handled_{ 0 };
 		};
 
-		struct StoredGemFormKey
+		// Lets the core cast through the manager's plan cache and free-cast sessions.
+		class StoredSpellCaster : public ICaster
 		{
-			RE::FormID baseId;
-			RE::FormID spellId;
-			SpellTier tier;
-			std::int32_t usesRemaining;
+		public:
+			explicit StoredSpellCaster(SpellGemManager& manager) : manager_(manager) {}
+			bool Cast(const GemKey& key, const StoredSpellData& data) override;
 
-			bool operator==(const StoredGemFormKey& other) const
-			{
-				return baseId == other.baseId && spellId == other.spellId && tier == other.tier && usesRemaining == other.usesRemaining;
-			}
+		private:
+			SpellGemManager& manager_;
 		};
 
-		struct StoredGemFormKeyHash
-		{
-			std::size_t operator()(const StoredGemFormKey& key) const
-			{
-				std::size_t seed = std::hash<RE::FormID>{}(key.baseId);
-				seed ^= std::hash<RE::FormID>{}(key.spellId) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-				seed ^= std::hash<std::uint8_t>{}(static_cast<std::uint8_t>(key.tier)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-				seed ^= std::hash<std::int32_t>{}(key.usesRemaining) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-				return seed;
-			}
-		};
+		static void Unbind(KeyHandler& keyHandler, KeyBinding& binding);
 
 		SelectedGem GetSelectedSoulGem() const;
 		RE::SpellItem* GetRightHandSpell() const;
 		bool TryGetSpellTier(const RE::SpellItem& spell, SpellTier& tier) const;
 		SpellTier GetSpellTier(const RE::SpellItem& spell) const;
-		SpellTier GetGemTier(const RE::TESSoulGem& gem) const;
-		RE::TESSoulGem* GetOrCreateStoredGemForm(RE::TESSoulGem& baseGem, const RE::SpellItem& spell, SpellTier tier, std::int32_t usesRemaining);
+		RE::TESSoulGem* GetOrCreateStoredGemForm(RE::TESSoulGem& baseGem, const RE::SpellItem& spell, SpellTier tier);
 		std::uint16_t GetOrCreateUniqueId(const RE::TESSoulGem& gem, RE::ExtraDataList& extraList) const;
 		RE::ExtraDataList* CreateExtraDataList() const;
-		std::string BuildDisplayName(const RE::SpellItem& spell, SpellTier tier) const;
-		RE::BSEventNotifyControl HandleContainerChanged(const RE::TESContainerChangedEvent& event);
-		void CastStoredSpell(RE::SpellItem& spell, RE::PlayerCharacter& player, bool isBlackSoulGem, bool isReusableStar, bool isAzurasStar);
+		bool HandleContainerChanged(const RE::TESContainerChangedEvent& event);
+		const CastPlan& GetCastPlan(const GemKey& key, const StoredSpellData& data, const RE::SpellItem& spell);
+		void CastStoredSpell(RE::SpellItem& spell, RE::PlayerCharacter& player, const CastPlan& plan);
 		void StopFocusSpellCast(std::size_t index);
-		void GrantFragmentsToPlayer(SpellTier tier) const;
+		void ReapplyUses();
+		void RefreshStoredGemRows(bool force);
+		void OnStoredGemConsumed(const GemKey& key, ConsumeStatus status, std::int32_t usesRemaining);
 		bool IsReusableStar(RE::FormID formId) const;
-		bool IsAzurasStar(RE::FormID formId) const;
 		bool IsBlackSoulGem(const RE::TESSoulGem& gem) const;
-		void RefreshStoredGemSlots();
 
 		void LogMessage(const std::string& message) const;
 
 		StoredGemUseEventSink useEventSink_{ *this };
-		std::unordered_map<StoredGemFormKey, RE::TESSoulGem*, StoredGemFormKeyHash> storedGemForms_;
-		std::vector<GemKey> storedGemSlots_;
-		std::vector<KeyHandlerEvent> activationHandles_;
-		std::vector<KeyHandlerEvent> activationReleaseHandles_;
+		GameFormLookup forms_;
+		PlayerInventory inventory_;
+		GameCalendar calendar_;
+		StoredSpellCaster caster_{ *this };
+		GemCore core_{ Serialization::GetSingleton().GetStore(), forms_, inventory_, caster_, calendar_ };
+		std::unordered_map<GemKey, CastPlan, GemKeyHash> castPlans_;
+		KeyBinding storeBinding_{};
+		std::array<KeyBinding, kActivationSlotCount> activationBindings_{};
 		std::optional<std::size_t> activeFocusSlot_{};
-		std::atomic<std::uint64_t> focusCastId_{ 0 };
+		bool lastCastConcentration_{};
+		TimerHandle focusExpiryTimer_{};
 		std::optional<RE::MagicSystem::CastingSource> focusCasterSource_{};
-		float focusPreviousCost_{ 0.0f };
-		bool focusCostActive_{ false };
-		float focusStartMagicka_{ 0.0f };
+		std::atomic<std::shared_ptr<const StoredGemRows>> storedGemRows_{ std::make_shared<const StoredGemRows>() };
+		std::uint64_t rowsStoreGeneration_{ static_cast<std::uint64_t>(-1) };
+		std::uint32_t rowsConfigGeneration_{};
 	};
 }
@@ -0,0 +1,178 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Spell Profile Cache                                            //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/SpellProfileCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "RE/E/Effect.h"
+#include "RE/E/EffectSetting.h"
+#include "RE/S/SpellItem.h"
+#include "RE/T/TESDataHandler.h"
+
+namespace SpellGems
+{
+	namespace
+	{
+		// Spells below this count are profiled on the calling thread.
+		constexpr std::size_t kMinSpellsPerWorker = 512;
+
+		SpellTier TierFromSkill(std::uint32_t minSkill)
+		{
+			if (minSkill >= 100) {
+				return SpellTier::Master;
+			}
+			if (minSkill >= 75) {
+				return SpellTier::Expert;
+			}
+			if (minSkill >= 50) {
+				return SpellTier::Adept;
+			}
+			if (minSkill >= 25) {
+				return SpellTier::Apprentice;
+			}
+			return SpellTier::Novice;
+		}
+
+		SchoolFlags SchoolFromSkill(RE::ActorValue skill)
+		{
+			switch (skill) {
+			case RE::ActorValue::kAlteration:
+				return SchoolFlags::Alteration;
+			case RE::ActorValue::kConjuration:
+				return SchoolFlags::Conjuration;
+			case RE::ActorValue::kDestruction:
+				return SchoolFlags::Destruction;
+			case RE::ActorValue::kIllusion:
+				return SchoolFlags::Illusion;
+			case RE::ActorValue::kRestoration:
+				return SchoolFlags::Restoration;
+			default:
+				return SchoolFlags::None;
+			}
+		}
+	}
+
+	// Returns the singleton spell profile cache.
+	SpellProfileCache& SpellProfileCache::GetSingleton()
+	{
+		static SpellProfileCache instance;
+		return instance;
+	}
+
+	// Profiles every loaded SpellItem, splitting the form array across worker threads.
+	void SpellProfileCache::Build()
+	{
+		auto* dataHandler = RE::TESDataHandler::GetSingleton();
+		if (!dataHandler) {
+			logger::info("TESDataHandler unavailable; spell profiles will be computed on demand.");
+			return;
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+		const auto& spells = dataHandler->GetFormArray<RE::SpellItem>();
+		const std::size_t count = spells.size();
+		std::vector<SpellProfile> profiles(count);
+
+		const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+		const std::size_t workers = std::clamp<std::size_t>(count / kMinSpellsPerWorker, 1, hardware);
+		const std::size_t chunk = (count + workers - 1) / workers;
+		auto profileRange = [&spells, &profiles](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i) {
+				if (const auto* spell = spells[static_cast<std::uint32_t>(i)]) {
+					profiles[i] = Compute(*spell);
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(workers - 1);
+		for (std::size_t worker = 1; worker < workers; ++worker) {
+			const auto begin = worker * chunk;
+			threads.emplace_back(profileRange, begin, std::min(count, begin + chunk));
+		}
+		profileRange(0, std::min(count, chunk));
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		std::erase_if(profiles, [](const SpellProfile& profile) { return profile.formId == 0; });
+		std::sort(profiles.begin(), profiles.end(), [](const SpellProfile& a, const SpellProfile& b) {
+			return a.formId < b.formId;
+		});
+		profiles_ = std::move(profiles);
+		{
+			std::unique_lock lock(lateMutex_);
+			lateProfiles_.clear();
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		logger::info("Built {} spell profiles on {} threads in {} us.", profiles_.size(), workers, elapsed.count());
+	}
+
+	const SpellProfile* SpellProfileCache::Find(RE::FormID formId) const
+	{
+		auto it = std::lower_bound(profiles_.begin(), profiles_.end(), formId, [](const SpellProfile& profile, RE::FormID id) {
+			return profile.formId < id;
+		});
+		if (it != profiles_.end() && it->formId == formId) {
+			return std::addressof(*it);
+		}
+
+		std::shared_lock lock(lateMutex_);
+		if (auto late = lateProfiles_.find(formId); late != lateProfiles_.end()) {
+			return std::addressof(late->second);
+		}
+		return nullptr;
+	}
+
+	// Returns the profile for a spell, computing it once for forms created after data load.
+	const SpellProfile& SpellProfileCache::Get(const RE::SpellItem& spell)
+	{
+		if (const auto* profile = Find(spell.GetFormID())) {
+			return *profile;
+		}
+
+		auto profile = Compute(spell);
+		std::unique_lock lock(lateMutex_);
+		return lateProfiles_.try_emplace(spell.GetFormID(), std::move(profile)).first->second;
+	}
+
+	std::size_t SpellProfileCache::Size() const
+	{
+		std::shared_lock lock(lateMutex_);
+		return profiles_.size() + lateProfiles_.size();
+	}
+
+	SpellProfile SpellProfileCache::Compute(const RE::SpellItem& spell)
+	{
+		SpellProfile profile{};
+		profile.formId = spell.GetFormID();
+		profile.delivery = spell.GetDelivery();
+		profile.castingType = spell.GetCastingType();
+
+		const auto* effect = spell.GetCostliestEffectItem();
+		const auto* baseEffect = effect ? effect->baseEffect : nullptr;
+		profile.hasTier = baseEffect != nullptr;
+		profile.tier = TierFromSkill(baseEffect ? baseEffect->GetMinimumSkillLevel() : 0);
+
+		for (const auto* item : spell.effects) {
+			if (item && item->baseEffect) {
+				profile.schoolMask |= static_cast<std::uint8_t>(SchoolFromSkill(item->baseEffect->GetMagickSkill()));
+			}
+		}
+
+		const auto* spellName = spell.GetName();
+		profile.displayName = (spellName && spellName[0] != '\0') ? spellName : "Unknown Spell";
+		profile.displayName.append(" (").append(Config::GetTierName(profile.tier)).append(")");
+		return profile;
+	}
+}
@@ -0,0 +1,55 @@
+// Precomputed per-spell data used by the store, cast and UI paths.
+#pragma once
+
+#include "SpellGems/Config.h"
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "RE/F/FormTypes.h"
+#include "RE/M/MagicSystem.h"
+
+namespace SpellGems
+{
+	struct SpellProfile
+	{
+		RE::FormID formId{};
+		SpellTier tier{ SpellTier::Novice };
+		bool hasTier{};
+		std::uint8_t schoolMask{};
+		RE::MagicSystem::Delivery delivery{ RE::MagicSystem::Delivery::kSelf };
+		RE::MagicSystem::CastingType castingType{ RE::MagicSystem::CastingType::kFireAndForget };
+		std::string displayName;
+
+		bool HasSchool(SchoolFlags school) const
+		{
+			return (schoolMask & static_cast<std::uint8_t>(school)) != 0;
+		}
+	};
+
+	class SpellProfileCache
+	{
+	public:
+		static SpellProfileCache& GetSingleton();
+
+		void Build();
+		const SpellProfile* Find(RE::FormID formId) const;
+		const SpellProfile& Get(const RE::SpellItem& spell);
+		std::size_t Size() const;
+
+		static SpellProfile Compute(const RE::SpellItem& spell);
+
+	private:
+		SpellProfileCache() = default;
+
+		// Built once at data load, before any reader, and read-only afterwards.
+		std::vector<SpellProfile> profiles_;
+		// Filled on demand by Get on the main thread while Find may run elsewhere. Map nodes never move, so a
+		// returned profile stays valid after the lock is released.
+		std::unordered_map<RE::FormID, SpellProfile> lateProfiles_;
+		mutable std::shared_mutex lateMutex_;
+	};
+}
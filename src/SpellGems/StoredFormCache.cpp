@@ -0,0 +1,145 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                              Stored Form Cache                                              //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/StoredFormCache.h"
+
+#include "RE/S/ScriptEventSourceHolder.h"
+#include "RE/S/SpellItem.h"
+#include "RE/T/TESBoundObject.h"
+#include "RE/T/TESForm.h"
+#include "RE/T/TESSoulGem.h"
+
+namespace SpellGems
+{
+	// Returns the singleton form cache.
+	StoredFormCache& StoredFormCache::GetSingleton()
+	{
+		static StoredFormCache instance;
+		return instance;
+	}
+
+	void StoredFormCache::RegisterDeleteSink()
+	{
+		auto* sources = RE::ScriptEventSourceHolder::GetSingleton();
+		if (!sources) {
+			logger::info("ScriptEventSourceHolder unavailable; stored form cache will not see form deletions.");
+			return;
+		}
+
+		sources->AddEventSink<RE::TESFormDeleteEvent>(&deleteSink_);
+		logger::info("Registered stored form cache delete handler.");
+	}
+
+	RE::SpellItem* StoredFormCache::GetSpell(RE::FormID spellId)
+	{
+		return Resolve(spells_, spellId);
+	}
+
+	RE::TESSoulGem* StoredFormCache::GetSoulGem(RE::FormID gemId)
+	{
+		return Resolve(gems_, gemId);
+	}
+
+	// Stored gems come from the gem map, so the common depletion path shares its entries.
+	RE::TESBoundObject* StoredFormCache::GetBoundObject(RE::FormID formId)
+	{
+		if (const auto it = gems_.find(formId); it != gems_.end()) {
+			hits_.fetch_add(1, std::memory_order_relaxed);
+			return it->second;
+		}
+		return Resolve(objects_, formId);
+	}
+
+	// Resolves both forms of a newly stored gem so its first activation already hits.
+	void StoredFormCache::Warm(const GemKey& key, const StoredSpellData& data)
+	{
+		Resolve(spells_, data.spellId);
+		Resolve(gems_, key.baseId);
+	}
+
+	void StoredFormCache::WarmAll(const GemStore::Table& entries)
+	{
+		for (std::size_t i = 0; i < entries.Size(); ++i) {
+			Resolve(spells_, entries.GetSpellId(i));
+			Resolve(gems_, entries.GetKey(i).baseId);
+		}
+	}
+
+	void StoredFormCache::Evict(RE::FormID formId)
+	{
+		const auto erased = spells_.erase(formId) + gems_.erase(formId) + objects_.erase(formId);
+		if (erased == 0) {
+			return;
+		}
+
+		evicted_.fetch_add(erased, std::memory_order_relaxed);
+		spellCount_.store(spells_.size(), std::memory_order_relaxed);
+		gemCount_.store(gems_.size(), std::memory_order_relaxed);
+		objectCount_.store(objects_.size(), std::memory_order_relaxed);
+	}
+
+	void StoredFormCache::Clear()
+	{
+		spells_.clear();
+		gems_.clear();
+		objects_.clear();
+		spellCount_.store(0, std::memory_order_relaxed);
+		gemCount_.store(0, std::memory_order_relaxed);
+		objectCount_.store(0, std::memory_order_relaxed);
+	}
+
+	StoredFormCache::Stats StoredFormCache::GetStats() const
+	{
+		return {
+			hits_.load(std::memory_order_relaxed),
+			misses_.load(std::memory_order_relaxed),
+			unresolved_.load(std::memory_order_relaxed),
+			evicted_.load(std::memory_order_relaxed),
+			spellCount_.load(std::memory_order_relaxed),
+			gemCount_.load(std::memory_order_relaxed),
+			objectCount_.load(std::memory_order_relaxed)
+		};
+	}
+
+	// Failed lookups are not remembered: pooled gem forms can be created after the first query.
+	template <class T>
+	T* StoredFormCache::Resolve(std::unordered_map<RE::FormID, T*>& map, RE::FormID formId)
+	{
+		if (formId == 0) {
+			return nullptr;
+		}
+
+		if (const auto it = map.find(formId); it != map.end()) {
+			hits_.fetch_add(1, std::memory_order_relaxed);
+			return it->second;
+		}
+
+		misses_.fetch_add(1, std::memory_order_relaxed);
+		auto* form = RE::TESForm::LookupByID<T>(formId);
+		if (!form) {
+			unresolved_.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		map.emplace(formId, form);
+		spellCount_.store(spells_.size(), std::memory_order_relaxed);
+		gemCount_.store(gems_.size(), std::memory_order_relaxed);
+		objectCount_.store(objects_.size(), std::memory_order_relaxed);
+		return form;
+	}
+
+	RE::BSEventNotifyControl StoredFormCache::FormDeleteEventSink::ProcessEvent(
+		const RE::TESFormDeleteEvent* event,
+		RE::BSTEventSource<RE::TESFormDeleteEvent>*)
+	{
+		if (event) {
+			cache_.Evict(event->formID);
+		}
+		return RE::BSEventNotifyControl::kContinue;
+	}
+}
@@ -0,0 +1,77 @@
+// Resolved spell, soul gem and inventory item form pointers for stored gems, so hot paths skip the global form map lock.
+#pragma once
+
+#include "SpellGems/Core/GemStore.h"
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+
+#include "RE/F/FormTypes.h"
+#include "RE/T/TESFormDeleteEvent.h"
+
+namespace SpellGems
+{
+	// Read-through by form ID: a miss falls back to LookupByID and remembers the result. Warmed after a load and
+	// on every store, emptied on revert, and pruned by the form delete event. Main thread only; stats are atomic
+	// so the menu can read them.
+	class StoredFormCache
+	{
+	public:
+		struct Stats
+		{
+			std::uint64_t hits;
+			std::uint64_t misses;
+			std::uint64_t unresolved;
+			std::uint64_t evicted;
+			std::size_t spells;
+			std::size_t gems;
+			std::size_t objects;
+		};
+
+		static StoredFormCache& GetSingleton();
+
+		void RegisterDeleteSink();
+
+		RE::SpellItem* GetSpell(RE::FormID spellId);
+		RE::TESSoulGem* GetSoulGem(RE::FormID gemId);
+		// Anything the core adds to or removes from the inventory: stored gems and fragments.
+		RE::TESBoundObject* GetBoundObject(RE::FormID formId);
+
+		void Warm(const GemKey& key, const StoredSpellData& data);
+		void WarmAll(const GemStore::Table& entries);
+		void Evict(RE::FormID formId);
+		void Clear();
+
+		Stats GetStats() const;
+
+	private:
+		StoredFormCache() = default;
+
+		class FormDeleteEventSink : public RE::BSTEventSink<RE::TESFormDeleteEvent>
+		{
+		public:
+			explicit FormDeleteEventSink(StoredFormCache& cache) : cache_(cache) {}
+			RE::BSEventNotifyControl ProcessEvent(const RE::TESFormDeleteEvent* event,
+				RE::BSTEventSource<RE::TESFormDeleteEvent>*) override;
+
+		private:
+			StoredFormCache& cache_;
+		};
+
+		template <class T>
+		T* Resolve(std::unordered_map<RE::FormID, T*>& map, RE::FormID formId);
+
+		std::unordered_map<RE::FormID, RE::SpellItem*> spells_;
+		std::unordered_map<RE::FormID, RE::TESSoulGem*> gems_;
+		std::unordered_map<RE::FormID, RE::TESBoundObject*> objects_;
+		FormDeleteEventSink deleteSink_{ *this };
+		std::atomic<std::uint64_t> hits_{ 0 };
+		std::atomic<std::uint64_t> misses_{ 0 };
+		std::atomic<std::uint64_t> unresolved_{ 0 };
+		std::atomic<std::uint64_t> evicted_{ 0 };
+		std::atomic<std::size_t> spellCount_{ 0 };
+		std::atomic<std::size_t> gemCount_{ 0 };
+		std::atomic<std::size_t> objectCount_{ 0 };
+	};
+}
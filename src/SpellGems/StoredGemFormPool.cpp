@@ -0,0 +1,197 @@
+/*=============================================================================================================*/
+//																											   //
+//                                                  Spell Gems                                                 //
+//                                             Stored Gem Form Pool                                            //
+//                                                                                                             //
+/*=============================================================================================================*/
+
+
+#include "SpellGems/StoredGemFormPool.h"
+
+#include <string>
+
+#include "RE/T/TESDataHandler.h"
+#include "RE/T/TESForm.h"
+#include "RE/T/TESSoulGem.h"
+
+namespace SpellGems
+{
+	// Returns the singleton stored gem form pool.
+	StoredGemFormPool& StoredGemFormPool::GetSingleton()
+	{
+		static StoredGemFormPool instance;
+		return instance;
+	}
+
+	// Returns a form for the gem/spell/tier combination, sharing or duplicating as needed. Unreferenced forms are
+	// never handed to another spell: a gem in a container or on the ground would silently change what it casts.
+	RE::TESSoulGem* StoredGemFormPool::Acquire(RE::TESSoulGem& baseGem, RE::FormID spellId, SpellTier tier, std::string_view displayName)
+	{
+		auto* sourceGem = &baseGem;
+		if (auto it = entries_.find(baseGem.GetFormID()); it != entries_.end()) {
+			if (auto* source = RE::TESForm::LookupByID<RE::TESSoulGem>(it->second.key.sourceId)) {
+				sourceGem = source;
+			}
+		}
+
+		const FormKey key{ sourceGem->GetFormID(), spellId, tier };
+		if (auto it = byKey_.find(key); it != byKey_.end()) {
+			if (auto entry = entries_.find(it->second); entry != entries_.end() && entry->second.form) {
+				if (entry->second.refCount == 0) {
+					reusedCount_.fetch_add(1, std::memory_order_relaxed);
+				}
+				return entry->second.form;
+			}
+		}
+
+		if (entries_.size() >= kMaxForms) {
+			logger::info("Stored gem form pool is full ({} forms); no form available.", kMaxForms);
+			return nullptr;
+		}
+
+		auto* duplicated = sourceGem->CreateDuplicateForm(false, nullptr);
+		auto* storedGem = duplicated ? duplicated->As<RE::TESSoulGem>() : nullptr;
+		if (!storedGem) {
+			logger::info("Failed to duplicate soul gem form {:08X}.", sourceGem->GetFormID());
+			return nullptr;
+		}
+
+		const std::string name{ displayName };
+		storedGem->SetFullName(name.c_str());
+
+		auto* dataHandler = RE::TESDataHandler::GetSingleton();
+		if (dataHandler && !dataHandler->AddFormToDataHandler(storedGem)) {
+			logger::info("Failed to register stored gem form with data handler.");
+		}
+
+		Track(*storedGem, key);
+		createdCount_.fetch_add(1, std::memory_order_relaxed);
+		logger::info("Created stored spell gem form {:08X} for spell {:08X} ({} pooled).", storedGem->GetFormID(), spellId, entries_.size());
+		return storedGem;
+	}
+
+	// Counts a stored spell entry that refers to the form.
+	void StoredGemFormPool::AddRef(RE::FormID formId)
+	{
+		auto it = entries_.find(formId);
+		if (it == entries_.end()) {
+			return;
+		}
+
+		if (it->second.refCount++ == 0) {
+			liveCount_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	// Drops a stored spell reference. Forms with no references stay pooled for the same spell and tier.
+	void StoredGemFormPool::Release(RE::FormID formId)
+	{
+		auto it = entries_.find(formId);
+		if (it == entries_.end() || it->second.refCount == 0) {
+			return;
+		}
+
+		if (--it->second.refCount == 0) {
+			liveCount_.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	bool StoredGemFormPool::IsPooled(RE::FormID formId) const
+	{
+		return entries_.contains(formId);
+	}
+
+	// Writes the pooled form table; the caller opens the record.
+	void StoredGemFormPool::Save(SKSE::SerializationInterface* serialization) const
+	{
+		const std::uint32_t count = static_cast<std::uint32_t>(entries_.size());
+		serialization->WriteRecordData(count);
+		for (const auto& [formId, entry] : entries_) {
+			serialization->WriteRecordData(formId);
+			serialization->WriteRecordData(entry.key.sourceId);
+			serialization->WriteRecordData(entry.key.spellId);
+			serialization->WriteRecordData(entry.key.tier);
+		}
+
+		logger::info("Saved {} pooled stored gem forms ({} live, {} reused this session).", count,
+			liveCount_.load(std::memory_order_relaxed), reusedCount_.load(std::memory_order_relaxed));
+	}
+
+	// Replaces the pool with the forms recorded in the save that still exist. References are rebuilt from the stored
+	// spell table afterwards.
+	void StoredGemFormPool::Load(SKSE::SerializationInterface* serialization, std::uint32_t version)
+	{
+		Clear();
+		if (version > kRecordVersion) {
+			logger::info("Unknown stored gem form pool version {}; skipping.", version);
+			return;
+		}
+
+		std::uint32_t count = 0;
+		serialization->ReadRecordData(count);
+		for (std::uint32_t i = 0; i < count; ++i) {
+			RE::FormID formId = 0;
+			FormKey key{};
+			serialization->ReadRecordData(formId);
+			serialization->ReadRecordData(key.sourceId);
+			serialization->ReadRecordData(key.spellId);
+			serialization->ReadRecordData(key.tier);
+
+			if (!serialization->ResolveFormID(formId, formId) ||
+				!serialization->ResolveFormID(key.sourceId, key.sourceId) ||
+				!serialization->ResolveFormID(key.spellId, key.spellId)) {
+				continue;
+			}
+
+			auto* form = RE::TESForm::LookupByID<RE::TESSoulGem>(formId);
+			if (!form || entries_.contains(formId) || entries_.size() >= kMaxForms) {
+				continue;
+			}
+
+			Track(*form, key);
+		}
+
+		logger::info("Loaded stored gem form pool: {} forms.", entries_.size());
+	}
+
+	// Marks every pooled form unreferenced; used before references are rebuilt from a new save.
+	void StoredGemFormPool::ResetReferences()
+	{
+		for (auto& [_, entry] : entries_) {
+			entry.refCount = 0;
+		}
+		liveCount_.store(0, std::memory_order_relaxed);
+	}
+
+	// Forgets every pooled form; forms duplicated for a previous save must not leak into the next one.
+	void StoredGemFormPool::Clear()
+	{
+		entries_.clear();
+		byKey_.clear();
+		pooledCount_.store(0, std::memory_order_relaxed);
+		liveCount_.store(0, std::memory_order_relaxed);
+	}
+
+	StoredGemFormPool::Stats StoredGemFormPool::GetStats() const
+	{
+		const auto pooled = pooledCount_.load(std::memory_order_relaxed);
+		const auto live = liveCount_.load(std::memory_order_relaxed);
+		return {
+			live,
+			pooled > live ? pooled - live : 0,
+			createdCount_.load(std::memory_order_relaxed),
+			reusedCount_.load(std::memory_order_relaxed),
+		};
+	}
+
+	void StoredGemFormPool::Track(RE::TESSoulGem& form, const FormKey& key)
+	{
+		const auto formId = form.GetFormID();
+		auto& entry = entries_[formId];
+		entry.form = &form;
+		entry.key = key;
+		entry.refCount = 0;
+		byKey_.emplace(key, formId);
+		pooledCount_.store(entries_.size(), std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,88 @@
+// Pool of duplicated soul gem forms used to represent stored spell gems.
+#pragma once
+
+#include "SpellGems/Config.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include "RE/F/FormTypes.h"
+#include "SKSE/Interfaces.h"
+
+namespace SpellGems
+{
+	class StoredGemFormPool
+	{
+	public:
+		struct Stats
+		{
+			std::size_t live{};
+			std::size_t free{};
+			std::uint64_t created{};
+			// Acquires served by an unreferenced form of the same source gem, spell and tier.
+			std::uint64_t reused{};
+		};
+
+		static constexpr std::size_t kMaxForms = 1024;
+		static constexpr std::uint32_t kRecordVersion = 1;
+
+		static StoredGemFormPool& GetSingleton();
+
+		RE::TESSoulGem* Acquire(RE::TESSoulGem& baseGem, RE::FormID spellId, SpellTier tier, std::string_view displayName);
+		void AddRef(RE::FormID formId);
+		void Release(RE::FormID formId);
+		bool IsPooled(RE::FormID formId) const;
+
+		void Save(SKSE::SerializationInterface* serialization) const;
+		void Load(SKSE::SerializationInterface* serialization, std::uint32_t version);
+		void ResetReferences();
+		void Clear();
+
+		// Safe to call from any thread.
+		Stats GetStats() const;
+
+	private:
+		StoredGemFormPool() = default;
+
+		struct FormKey
+		{
+			RE::FormID sourceId;
+			RE::FormID spellId;
+			SpellTier tier;
+
+			bool operator==(const FormKey& other) const
+			{
+				return sourceId == other.sourceId && spellId == other.spellId && tier == other.tier;
+			}
+		};
+
+		struct FormKeyHash
+		{
+			std::size_t operator()(const FormKey& key) const
+			{
+				std::size_t seed = std::hash<RE::FormID>{}(key.sourceId);
+				seed ^= std::hash<RE::FormID>{}(key.spellId) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+				seed ^= std::hash<std::uint8_t>{}(static_cast<std::uint8_t>(key.tier)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+				return seed;
+			}
+		};
+
+		struct Entry
+		{
+			RE::TESSoulGem* form{};
+			FormKey key{};
+			std::uint32_t refCount{};
+		};
+
+		void Track(RE::TESSoulGem& form, const FormKey& key);
+
+		std::unordered_map<RE::FormID, Entry> entries_;
+		std::unordered_map<FormKey, RE::FormID, FormKeyHash> byKey_;
+		std::atomic<std::size_t> pooledCount_{ 0 };
+		std::atomic<std::size_t> liveCount_{ 0 };
+		std::atomic<std::uint64_t> createdCount_{ 0 };
+		std::atomic<std::uint64_t> reusedCount_{ 0 };
+	};
+}
@@ -7,9 +7,13 @@
 
 
 #include "SpellGems/Config.h"
+#include "SpellGems/FreeCastSession.h"
 #include "SpellGems/MenuUI.h"
+#include "SpellGems/Scheduler.h"
 #include "SpellGems/Serialization.h"
 #include "SpellGems/SpellGemManager.h"
+#include "SpellGems/SpellProfileCache.h"
+#include "SpellGems/StoredFormCache.h"
 #include <keyhandler/keyhandler.h>
 
 // Handles SKSE lifecycle messages to initialize plugin systems.
@@ -21,20 +25,28 @@ static void SKSEMessageHandler(SKSE::MessagingInterface::Message* message)
         auto& config = SpellGems::Config::GetSingleton();
         config.Load();
 
+        SpellGems::SpellProfileCache::GetSingleton().Build();
+
         SpellGems::MenuUI::Initialize();
         SpellGems::SpellGemManager::GetSingleton().RegisterUseEventSink();
+        SpellGems::StoredFormCache::GetSingleton().RegisterDeleteSink();
 
         KeyHandler::RegisterSink();
-        auto* keyHandler = KeyHandler::GetSingleton();
-        const auto storeKey = config.GetStoreKey();
+        SpellGems::SpellGemManager::GetSingleton().RegisterStoreKey();
 
-        [[maybe_unused]] auto storeHandler = keyHandler->Register(storeKey, KeyEventType::KEY_DOWN, []() {
-            SpellGems::SpellGemManager::GetSingleton().TryStoreSelectedSpell();
+        SpellGems::Scheduler::GetSingleton().AddFrameCallback([]() {
+            SpellGems::SpellGemManager::GetSingleton().ProcessCommands();
+        });
+        SpellGems::Scheduler::GetSingleton().ScheduleRepeating(SpellGems::Serialization::kSnapshotInterval, []() {
+            SpellGems::Serialization::GetSingleton().RefreshSaveImage();
         });
 
         SpellGems::SpellGemManager::GetSingleton().RegisterActivationKeys();
 
-        logger::info("Store spell key registered: {}", storeKey);
+        config.AddChangeListener([](const SpellGems::ConfigSnapshot& previous, const SpellGems::ConfigSnapshot& current) {
+            SpellGems::SpellGemManager::GetSingleton().OnConfigChanged(previous, current);
+        });
+        config.StartWatching();
 
         break;
     }
@@ -59,6 +71,9 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
     SKSE::Init(a_skse);
     SKSE::AllocTrampoline(1 << 10);
 
+    SpellGems::Scheduler::GetSingleton().InstallHook();
+    SpellGems::FreeCastSessions::GetSingleton().InstallHook();
+
     g_messaging->RegisterListener("SKSE", SKSEMessageHandler);
     logger::info("Registered SKSE message listener.");
 
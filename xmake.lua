@@ -1,79 +1,119 @@
-set_xmakever('3.0.1')
-includes('lib/commonlibsse-ng')
-
-set_project('SpellGems')
-set_version('1.0.7')
-set_license('MIT')
-
-set_languages('c++23')
-set_warnings('allextra')
-set_policy('package.requires_lock', true)
-set_toolset('msvc', 'ninja')
-
-add_rules('mode.debug', 'mode.releasedbg', 'mode.release')
-
-option('skyrim_se')
-    set_default(false)
-    set_showmenu(true)
-    set_description('Build for Skyrim Special Edition')
-option_end()
-
-option('skyrim_ae')
-    set_default(false)
-    set_showmenu(true)
-    set_description('Build for Skyrim Anniversary Edition')
-option_end()
-
-option('skyrim_vr')
-    set_default(false)
-    set_showmenu(true)
-    set_description('Build for Skyrim VR only')
-option_end()
-
-if has_config('skyrim_vr') and (has_config('skyrim_se') or has_config('skyrim_ae')) then
-    raise('Cannot combine Skyrim VR with SE/AE builds. Enable only one configuration.')
-end
-
-target('SpellGems')
-    add_deps('commonlibsse-ng')
-
-    local runtime = 'se_ae'
-    if has_config('skyrim_vr') then
-        runtime = 'vr'
-    elseif has_config('skyrim_ae') and not has_config('skyrim_se') then
-        runtime = 'ae'
-    elseif has_config('skyrim_se') and not has_config('skyrim_ae') then
-        runtime = 'se'
-    end
-
-    add_rules('commonlibsse-ng.plugin', {
-        name        = 'SpellGems',
-        author      = 'Vennovia',
-        description = 'No description provided.',
-        runtime     = runtime
-    })
-
-    add_files('src/**.cpp')
-    add_headerfiles('src/**.h')
-
-    add_includedirs(
-        'src',
-        '$(projectdir)',
-        '$(projectdir)/ClibUtil',
-        '$(projectdir)/ClibUtil/detail',
-        '$(projectdir)/xbyak',
-        '$(projectdir)/simpleini'
-    )
-
-    set_pcxxheader('src/pch.h')
-
-    if has_config('skyrim_vr') then
-        add_defines('ENABLE_SKYRIM_VR')
-    elseif has_config('skyrim_se') and not has_config('skyrim_ae') then
-        add_defines('ENABLE_SKYRIM_SE')
-    elseif has_config('skyrim_ae') and not has_config('skyrim_se') then
-        add_defines('ENABLE_SKYRIM_AE')
-    else
-        add_defines('ENABLE_SKYRIM_SE')
-        add_defines('ENABLE_SKYRIM_AE')
-    end
+set_xmakever('3.0.1')
+if is_plat('windows') then
+    includes('lib/commonlibsse-ng')
+end
+
+set_project('SpellGems')
+set_version('1.0.7')
+set_license('MIT')
+
+set_languages('c++23')
+set_warnings('allextra')
+set_policy('package.requires_lock', true)
+if is_plat('windows') then
+    set_toolset('msvc', 'ninja')
+end
+
+add_rules('mode.debug', 'mode.releasedbg', 'mode.release')
+
+option('skyrim_se')
+    set_default(false)
+    set_showmenu(true)
+    set_description('Build for Skyrim Special Edition')
+option_end()
+
+option('skyrim_ae')
+    set_default(false)
+    set_showmenu(true)
+    set_description('Build for Skyrim Anniversary Edition')
+option_end()
+
+option('skyrim_vr')
+    set_default(false)
+    set_showmenu(true)
+    set_description('Build for Skyrim VR only')
+option_end()
+
+if has_config('skyrim_vr') and (has_config('skyrim_se') or has_config('skyrim_ae')) then
+    raise('Cannot combine Skyrim VR with SE/AE builds. Enable only one configuration.')
+end
+
+if is_plat('windows') then
+    target('SpellGems')
+        add_deps('commonlibsse-ng')
+
+        local runtime = 'se_ae'
+        if has_config('skyrim_vr') then
+            runtime = 'vr'
+        elseif has_config('skyrim_ae') and not has_config('skyrim_se') then
+            runtime = 'ae'
+        elseif has_config('skyrim_se') and not has_config('skyrim_ae') then
+            runtime = 'se'
+        end
+
+        add_rules('commonlibsse-ng.plugin', {
+            name        = 'SpellGems',
+            author      = 'Vennovia',
+            description = 'No description provided.',
+            runtime     = runtime
+        })
+
+        add_files('src/**.cpp')
+        add_headerfiles('src/**.h')
+
+        add_includedirs(
+            'src',
+            '$(projectdir)',
+            '$(projectdir)/ClibUtil',
+            '$(projectdir)/ClibUtil/detail',
+            '$(projectdir)/xbyak',
+            '$(projectdir)/simpleini'
+        )
+
+        set_pcxxheader('src/pch.h')
+
+        if has_config('skyrim_vr') then
+            add_defines('ENABLE_SKYRIM_VR')
+        elseif has_config('skyrim_se') and not has_config('skyrim_ae') then
+            add_defines('ENABLE_SKYRIM_SE')
+        elseif has_config('skyrim_ae') and not has_config('skyrim_se') then
+            add_defines('ENABLE_SKYRIM_AE')
+        else
+            add_defines('ENABLE_SKYRIM_SE')
+            add_defines('ENABLE_SKYRIM_AE')
+        end
+    target_end()
+end
+
+-- Game-independent core plus stand-in game services; builds anywhere.
+-- xmake f -m release && xmake build SpellGemsBench && xmake run SpellGemsBench
+target('SpellGemsBench')
+    set_kind('binary')
+    set_default(not is_plat('windows'))
+
+    add_files('src/SpellGems/Core/**.cpp', 'bench/**.cpp')
+    add_headerfiles('src/SpellGems/Core/**.h', 'bench/**.h')
+    add_includedirs('src', 'bench')
+
+    if is_plat('linux') then
+        add_syslinks('pthread')
+    end
+    if not is_plat('windows') then
+        add_cxflags('-Wno-multichar')
+    end
+target_end()
+
+-- Offline co-save inspector built on the same record code; POSIX only (mmap).
+-- xmake f -m release && xmake build SpellGemsInspect && xmake run SpellGemsInspect <save>.skse
+target('SpellGemsInspect')
+    set_kind('binary')
+    set_default(not is_plat('windows'))
+
+    add_files('src/SpellGems/Core/**.cpp', 'inspect/**.cpp')
+    add_headerfiles('src/SpellGems/Core/**.h', 'inspect/**.h')
+    add_includedirs('src', 'inspect')
+
+    if not is_plat('windows') then
+        add_cxflags('-Wno-multichar')
+    end
+target_end()